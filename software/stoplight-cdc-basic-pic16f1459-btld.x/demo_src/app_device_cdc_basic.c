@@ -36,9 +36,18 @@ static bool buttonPressed;
 static char buttonMessage1[] = "1\r\n";
 static char buttonMessage2[] = "2\r\n";
 static char buttonMessage3[] = "3\r\n";
-static uint8_t readBuffer[CDC_DATA_OUT_EP_SIZE];
 static uint8_t writeBuffer[CDC_DATA_IN_EP_SIZE];
 
+/* Throughput test: while streaming, the transmit FIFO is kept topped up
+ * with this line over and over.  Something like "pv /dev/ttyACM0 >
+ * /dev/null" on the host then shows the sustained rate.  While sinking,
+ * received data is not echoed, so "pv /dev/zero > /dev/ttyACM0" shows
+ * the rate in the other direction. */
+static const char streamLine[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz\r\n";
+static bool streaming;
+static bool sinking;
+static uint8_t streamPosition;
+
 /*********************************************************************
 * Function: void APP_DeviceCDCBasicDemoInitialize(void);
 *
@@ -59,6 +68,9 @@ void APP_DeviceCDCBasicDemoInitialize()
     line_coding.dwDTERate = 9600;
 
     buttonPressed = false;
+    streaming = false;
+    sinking = false;
+    streamPosition = 0;
 }
 
 /*********************************************************************
@@ -104,11 +116,12 @@ void APP_DeviceCDCBasicDemoTasks()
          */
         if(buttonPressed == false)
         {
-            /* Make sure that the CDC driver is ready for a transmission.
+            /* Make sure that the transmit FIFO has room for the whole
+             * message.
              */
-            if(mUSBUSARTIsTxTrfReady() == true)
+            if(CDCTxAvailable() >= sizeof(buttonMessage1) - 1)
             {
-                putrsUSBUSART(buttonMessage1);
+                CDCTxWrite((uint8_t*)buttonMessage1, sizeof(buttonMessage1) - 1);
                 buttonPressed = true;
             }
         }
@@ -120,11 +133,12 @@ void APP_DeviceCDCBasicDemoTasks()
          */
         if(buttonPressed == false)
         {
-            /* Make sure that the CDC driver is ready for a transmission.
+            /* Make sure that the transmit FIFO has room for the whole
+             * message.
              */
-            if(mUSBUSARTIsTxTrfReady() == true)
+            if(CDCTxAvailable() >= sizeof(buttonMessage2) - 1)
             {
-                putrsUSBUSART(buttonMessage2);
+                CDCTxWrite((uint8_t*)buttonMessage2, sizeof(buttonMessage2) - 1);
                 buttonPressed = true;
             }
         }
@@ -136,11 +150,12 @@ void APP_DeviceCDCBasicDemoTasks()
          */
         if(buttonPressed == false)
         {
-            /* Make sure that the CDC driver is ready for a transmission.
+            /* Make sure that the transmit FIFO has room for the whole
+             * message.
              */
-            if(mUSBUSARTIsTxTrfReady() == true)
+            if(CDCTxAvailable() >= sizeof(buttonMessage3) - 1)
             {
-                putrsUSBUSART(buttonMessage3);
+                CDCTxWrite((uint8_t*)buttonMessage3, sizeof(buttonMessage3) - 1);
                 buttonPressed = true;
             }
         }
@@ -151,15 +166,23 @@ void APP_DeviceCDCBasicDemoTasks()
         buttonPressed = false;
     }
 
-    /* Check to see if there is a transmission in progress, if there isn't, then
-     * we can see about performing an echo response to data received.
+    /* Perform an echo response to data received once the transmit FIFO
+     * has room for all of it.  Until then the packet stays with us and
+     * the same one is borrowed again next time.
      */
-    if( USBUSARTIsTxTrfReady() == true)
     {
         uint8_t i;
         uint8_t numBytesRead;
+        uint8_t *readBuffer;
 
-        numBytesRead = getsUSBUSART(readBuffer, sizeof(readBuffer));
+        /* Work on the received packet where the endpoint left it.  The
+         * other OUT buffer stays armed while we do.
+         */
+        numBytesRead = CDCRxBorrow(&readBuffer);
+        if((sinking == false) && (numBytesRead > CDCTxAvailable()))
+        {
+            numBytesRead = 0;
+        }
 
         /* For every byte that was read... */
         for(i=0; i<numBytesRead; i++)
@@ -183,10 +206,7 @@ void APP_DeviceCDCBasicDemoTasks()
                     writeBuffer[i] = readBuffer[i] + 1;
                     break;
             }
-        }
 
-        for(i=0; i<numBytesRead; i++)
-        {
             switch(readBuffer[i])
             {
                 case '1': 
@@ -207,15 +227,44 @@ void APP_DeviceCDCBasicDemoTasks()
                 case '6': 
                     LED_Off (LED_STOPLIGHT_GRN);
                     break;
+                case '7':
+                    streaming = true;
+                    break;
+                case '8':
+                    streaming = false;
+                    sinking = false;
+                    break;
+                case '9':
+                    sinking = true;
+                    break;
             }
         }
         
         if(numBytesRead > 0)
         {
+            /* Every byte has been turned into its echo, so the endpoint
+             * can have its buffer back.
+             */
+            CDCRxRelease();
+
             /* After processing all of the received data, we need to send out
              * the "echo" data now.
              */
-            putUSBUSART(writeBuffer,numBytesRead);
+            if(sinking == false)
+            {
+                CDCTxWrite(writeBuffer,numBytesRead);
+            }
+        }
+    }
+
+    /* Fill whatever room the echo left with the test stream. */
+    if(streaming == true)
+    {
+        streamPosition += CDCTxWrite((const uint8_t*)&streamLine[streamPosition],
+                sizeof(streamLine) - 1 - streamPosition);
+        if(streamPosition == sizeof(streamLine) - 1)
+        {
+            streamPosition = 0;
         }
     }
 
@@ -60,6 +60,10 @@ bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size
              * the LED update function here. */
             APP_LEDUpdateUSBStatus();
             BUTTON_UpdateStates ();
+
+            /* The CDC driver sends what is left in its transmit FIFO once
+             * per frame. */
+            USBCDCEventHandler(event, pdata, size);
             break;
 
         case EVENT_SUSPEND:
@@ -106,6 +110,9 @@ bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size
             break;
 
         case EVENT_TRANSFER_TERMINATED:
+            /* Let the CDC driver re-arm or flush its data endpoint after
+             * a halt. */
+            USBCDCEventHandler(event, pdata, size);
             break;
 
         default:
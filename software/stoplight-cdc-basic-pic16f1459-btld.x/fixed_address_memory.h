@@ -24,6 +24,8 @@ please contact mla_licensing@microchip.com
 
 #define IN_DATA_BUFFER_ADDRESS_TAG      @0x0A0
 #define OUT_DATA_BUFFER_ADDRESS_TAG     @0x120
-#define CONTROL_BUFFER_ADDRESS_TAG      @0x1A0
+#define OUT_DATA_ODD_BUFFER_ADDRESS_TAG @0x1A0
+#define IN_DATA_ODD_BUFFER_ADDRESS_TAG  @0x220
+#define CONTROL_BUFFER_ADDRESS_TAG      @0x2A0
 
 #endif //FIXED_MEMORY_ADDRESS
\ No newline at end of file
@@ -51,9 +51,23 @@ please contact mla_licensing@microchip.com
 
 #ifdef USB_USE_CDC
 
+/* With ping-pong buffering on the data endpoint both OUT buffer descriptors
+ * are kept armed, each with its own buffer, so the host can send the next
+ * packet while the application is still working on the last one.  The same
+ * goes for IN: one packet can be filled while the other is being sent. */
+#if (USB_PING_PONG_MODE == USB_PING_PONG__FULL_PING_PONG) || (USB_PING_PONG_MODE == USB_PING_PONG__ALL_BUT_EP0)
+    #define CDC_DATA_OUT_BUFFERS 2
+    #define CDC_DATA_IN_BUFFERS 2
+#else
+    #define CDC_DATA_OUT_BUFFERS 1
+    #define CDC_DATA_IN_BUFFERS 1
+#endif
+
 #ifndef FIXED_ADDRESS_MEMORY
     #define IN_DATA_BUFFER_ADDRESS_TAG
+    #define IN_DATA_ODD_BUFFER_ADDRESS_TAG
     #define OUT_DATA_BUFFER_ADDRESS_TAG
+    #define OUT_DATA_ODD_BUFFER_ADDRESS_TAG
     #define CONTROL_BUFFER_ADDRESS_TAG
 #endif
 
@@ -61,9 +75,53 @@ please contact mla_licensing@microchip.com
     #error "One of the fixed memory address definitions is not defined.  Please define the required address tags for the required buffers."
 #endif
 
+#if defined(CDC_TX_FIFO_SIZE) && (CDC_TX_FIFO_SIZE > 128)
+    #error "CDC_TX_FIFO_SIZE must not be larger than 128."
+#endif
+
+#if (CDC_DATA_OUT_BUFFERS == 2) && !defined(OUT_DATA_ODD_BUFFER_ADDRESS_TAG)
+    #error "Ping-pong buffering needs a second OUT buffer.  Please define OUT_DATA_ODD_BUFFER_ADDRESS_TAG."
+#endif
+
+#if (CDC_DATA_IN_BUFFERS == 2) && !defined(IN_DATA_ODD_BUFFER_ADDRESS_TAG)
+    #error "Ping-pong buffering needs a second IN buffer.  Please define IN_DATA_ODD_BUFFER_ADDRESS_TAG."
+#endif
+
+/* OUT buffers are re-armed on their own buffer descriptor, the same way
+ * USBTransferOnePacket() arms one. */
+#if defined(USB_DEVICE_DISABLE_DTS_CHECKING)
+    #define CDC_DTS_CHECKING_ENABLED 0
+#else
+    #define CDC_DTS_CHECKING_ENABLED _DTSEN
+#endif
+
 /** V A R I A B L E S ********************************************************/
 volatile unsigned char cdc_data_tx[CDC_DATA_IN_EP_SIZE] IN_DATA_BUFFER_ADDRESS_TAG;
+#if (CDC_DATA_IN_BUFFERS == 2)
+volatile unsigned char cdc_data_tx_odd[CDC_DATA_IN_EP_SIZE] IN_DATA_ODD_BUFFER_ADDRESS_TAG;
+#endif
 volatile unsigned char cdc_data_rx[CDC_DATA_OUT_EP_SIZE] OUT_DATA_BUFFER_ADDRESS_TAG;
+#if (CDC_DATA_OUT_BUFFERS == 2)
+volatile unsigned char cdc_data_rx_odd[CDC_DATA_OUT_EP_SIZE] OUT_DATA_ODD_BUFFER_ADDRESS_TAG;
+#endif
+
+// IN buffers in the order they are filled and sent
+static volatile unsigned char * const cdc_tx_buffer[CDC_DATA_IN_BUFFERS] =
+{
+    cdc_data_tx,
+#if (CDC_DATA_IN_BUFFERS == 2)
+    cdc_data_tx_odd,
+#endif
+};
+
+// OUT buffers in the order they are armed and handed out
+static volatile unsigned char * const cdc_rx_buffer[CDC_DATA_OUT_BUFFERS] =
+{
+    cdc_data_rx,
+#if (CDC_DATA_OUT_BUFFERS == 2)
+    cdc_data_rx_odd,
+#endif
+};
 
 typedef union
 {
@@ -81,19 +139,62 @@ CDC_NOTICE cdc_notice;
 #endif
 
 uint8_t cdc_rx_len;            // total rx length
+uint8_t cdc_rx_next;           // OUT buffer handed out next
+uint8_t cdc_rx_rearm;          // OUT buffers whose transfer was terminated
+bool cdc_rx_borrowed;          // OUT buffer cdc_rx_next is out on loan
 uint8_t cdc_trf_state;         // States are defined cdc.h
 POINTER pCDCSrc;            // Dedicated source pointer
 POINTER pCDCDst;            // Dedicated destination pointer
 uint8_t cdc_tx_len;            // total tx length
+uint8_t cdc_tx_next;           // IN buffer filled next
 uint8_t cdc_mem_type;          // _ROM, _RAM
 
-USB_HANDLE CDCDataOutHandle;
-USB_HANDLE CDCDataInHandle;
+USB_HANDLE CDCDataOutHandle[CDC_DATA_OUT_BUFFERS];
+static volatile BDT_ENTRY *cdc_rx_bd[CDC_DATA_OUT_BUFFERS]; // BD each OUT buffer is bound to
+USB_HANDLE CDCDataInHandle[CDC_DATA_IN_BUFFERS];
+
+#if defined(CDC_TX_FIFO_SIZE)
+    static uint8_t cdc_tx_fifo[CDC_TX_FIFO_SIZE];
+    uint8_t cdc_tx_fifo_tail;      // oldest byte in the FIFO
+    uint8_t cdc_tx_fifo_count;     // bytes in the FIFO
+    bool cdc_tx_fifo_flush;        // send a short packet on the next pass
+    bool cdc_tx_fifo_zlp;          // last packet was full, close with a ZLP
+#endif
 
 
 CONTROL_SIGNAL_BITMAP control_signal_bitmap;
 uint32_t BaudRateGen;			// BRG value calculated from baud rate
 
+/*
+ * The driver masks the USB interrupt only around handing buffers to and
+ * from the SIE and the state that goes with them.  With
+ * CDC_MEASURE_MASKED_CYCLES each of those windows is timed with Timer1,
+ * which then belongs to the driver.  The timer is stopped before the
+ * interrupt is unmasked, so its 16-bit count reads consistently.  Other
+ * interrupts stay enabled and are timed along with the window.
+ */
+#if defined(CDC_MEASURE_MASKED_CYCLES)
+    uint16_t cdc_masked_cycles;    // longest masked window so far
+
+    #define CDCMaskInterrupts()             \
+    {                                       \
+        USBMaskInterrupts();                \
+        TMR1H = 0;                          \
+        TMR1L = 0;                          \
+        T1CONbits.TMR1ON = 1;               \
+    }
+    #define CDCUnmaskInterrupts()           \
+    {                                       \
+        T1CONbits.TMR1ON = 0;               \
+        if(TMR1 > cdc_masked_cycles)        \
+            cdc_masked_cycles = TMR1;       \
+        USBUnmaskInterrupts();              \
+    }
+#else
+    #define CDCMaskInterrupts()     USBMaskInterrupts()
+    #define CDCUnmaskInterrupts()   USBUnmaskInterrupts()
+#endif
+
 #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
     BM_SERIAL_STATE SerialStateBitmap;
     BM_SERIAL_STATE OldSerialStateBitmap;
@@ -300,6 +401,16 @@ void CDCInitEP(void)
     line_coding.bDataBits = 0x08;               // 5,6,7,8, or 16
 
     cdc_rx_len = 0;
+    cdc_rx_next = 0;
+    cdc_rx_rearm = 0;
+    cdc_rx_borrowed = false;
+
+    #if defined(CDC_TX_FIFO_SIZE)
+        cdc_tx_fifo_tail = 0;
+        cdc_tx_fifo_count = 0;
+        cdc_tx_fifo_flush = false;
+        cdc_tx_fifo_zlp = false;
+    #endif
     
     /*
      * Do not have to init Cnt of IN pipes here.
@@ -315,8 +426,17 @@ void CDCInitEP(void)
     USBEnableEndpoint(CDC_COMM_EP,USB_IN_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
     USBEnableEndpoint(CDC_DATA_EP,USB_IN_ENABLED|USB_OUT_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
 
-    CDCDataOutHandle = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
-    CDCDataInHandle = NULL;
+    CDCDataOutHandle[0] = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
+    cdc_rx_bd[0] = (volatile BDT_ENTRY*)CDCDataOutHandle[0];
+    #if (CDC_DATA_OUT_BUFFERS == 2)
+        CDCDataOutHandle[1] = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx_odd,sizeof(cdc_data_rx_odd));
+        cdc_rx_bd[1] = (volatile BDT_ENTRY*)CDCDataOutHandle[1];
+    #endif
+    CDCDataInHandle[0] = NULL;
+    #if (CDC_DATA_IN_BUFFERS == 2)
+        CDCDataInHandle[1] = NULL;
+    #endif
+    cdc_tx_next = 0;
 
     #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
       	CDCNotificationInHandle = NULL;
@@ -423,20 +543,42 @@ void CDCNotificationHandler(void)
   **********************************************************************************/
 bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size)
 {
+    uint8_t i;
+
     switch( (uint16_t)event )
     {  
         case EVENT_TRANSFER_TERMINATED:
-            if(pdata == CDCDataOutHandle)
+            /*
+             * A halt on the OUT endpoint terminates both ping-pong buffers,
+             * one after the other.  Re-arming here would put the first one
+             * back on a descriptor that is about to be terminated too, so
+             * just note them and let CDCRxBorrow() re-arm them in order.
+             */
+            for(i = 0; i < CDC_DATA_OUT_BUFFERS; i++)
             {
-                CDCDataOutHandle = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
+                if(pdata == CDCDataOutHandle[i])
+                {
+                    CDCDataOutHandle[i] = NULL;
+                    cdc_rx_rearm |= 1 << i;
+                    break;
+                }
             }
-            if(pdata == CDCDataInHandle)
+            for(i = 0; i < CDC_DATA_IN_BUFFERS; i++)
             {
-                //flush all of the data in the CDC buffer
-                cdc_trf_state = CDC_TX_READY;
-                cdc_tx_len = 0;
+                if(pdata == CDCDataInHandle[i])
+                {
+                    //flush all of the data in the CDC buffer
+                    cdc_trf_state = CDC_TX_READY;
+                    cdc_tx_len = 0;
+                }
             }
             break;
+        #if defined(CDC_TX_FIFO_SIZE)
+        case EVENT_SOF:
+            //send what the transmit FIFO holds once per frame
+            cdc_tx_fifo_flush = true;
+            break;
+        #endif
         default:
             return false;
     }      
@@ -484,28 +626,31 @@ bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size)
   **********************************************************************************/
 uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len)
 {
+    uint8_t *data;
+    uint8_t count;
+
     cdc_rx_len = 0;
     
-    if(!USBHandleBusy(CDCDataOutHandle))
+    count = CDCRxBorrow(&data);
+    if(count != 0)
     {
         /*
          * Adjust the expected number of BYTEs to equal
          * the actual number of BYTEs received.
          */
-        if(len > USBHandleGetLength(CDCDataOutHandle))
-            len = USBHandleGetLength(CDCDataOutHandle);
+        if(len > count)
+            len = count;
         
         /*
          * Copy data from dual-ram buffer to user's buffer
          */
         for(cdc_rx_len = 0; cdc_rx_len < len; cdc_rx_len++)
-            buffer[cdc_rx_len] = cdc_data_rx[cdc_rx_len];
+            buffer[cdc_rx_len] = data[cdc_rx_len];
 
         /*
          * Prepare dual-ram buffer for next OUT transaction
          */
-
-        CDCDataOutHandle = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
+        CDCRxRelease();
 
     }//end if
     
@@ -513,6 +658,162 @@ uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len)
     
 }//end getsUSBUSART
 
+/************************************************************************
+  Function:
+        static void CDCRxArm(uint8_t i)
+    
+  Summary:
+    Hands OUT buffer 'i' back to the SIE on the buffer descriptor it was
+    bound to by CDCInitEP().
+
+  Description:
+    USBRxOnePacket() arms whichever buffer descriptor the stack's ping-pong
+    pointer is on, which is not always the one this buffer belongs to once
+    a transfer has been terminated.
+
+  Conditions:
+    Called with the USB interrupt masked.
+  ************************************************************************/
+static void CDCRxArm(uint8_t i)
+{
+    volatile BDT_ENTRY *bd;
+
+    bd = cdc_rx_bd[i];
+    bd->ADR = ConvertToPhysicalAddress(cdc_rx_buffer[i]);
+    bd->CNT = CDC_DATA_OUT_EP_SIZE;
+    #if (CDC_DATA_OUT_BUFFERS == 1)
+        bd->STAT.Val ^= _DTSMASK;
+    #endif
+    bd->STAT.Val &= _DTSMASK;
+    bd->STAT.Val |= (_DTSEN & CDC_DTS_CHECKING_ENABLED);
+    bd->STAT.Val |= _USIE;
+    CDCDataOutHandle[i] = (USB_HANDLE)bd;
+}//end CDCRxArm
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCRxBorrow(uint8_t **data)
+    
+  Summary:
+    CDCRxBorrow hands out the oldest packet received through the USB CDC Bulk
+    OUT endpoint in place, without copying it.  It is a non-blocking function.
+
+  Description:
+    CDCRxBorrow points 'data' at the dual-ram buffer holding the oldest
+    received packet and returns its length.  The buffer belongs to the
+    caller until CDCRxRelease() gives it back to the endpoint; calling
+    CDCRxBorrow() again before that returns the same packet.  With
+    ping-pong buffering the other buffer stays armed meanwhile, so the
+    host can keep sending while the caller parses.  Zero length packets
+    are released here and never handed out.
+    
+    Typical Usage:
+    <code>
+        uint8_t *data;
+        uint8_t numBytes;
+    
+        numBytes = CDCRxBorrow(&data);
+        if(numBytes \> 0)
+        {
+            //data[0] to data[numBytes - 1] hold the packet.  Use them,
+            //  then hand the buffer back.
+            CDCRxRelease();
+        }
+    </code>
+  Conditions:
+    The buffer must not be written to, and must not be used after
+    CDCRxRelease().
+  Input:
+    data -  Pointer to where the address of the received BYTEs is stored
+  Output:
+    uint8_t -    The number of BYTEs in the packet, 0 if no new CDC bulk OUT
+              endpoint data was available.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCRxBorrow(uint8_t **data)
+{
+    USB_HANDLE handle;
+    uint8_t rearm;
+    uint8_t i;
+    uint8_t len;
+
+    /*
+     * Buffers cut short by an endpoint halt go back on the endpoint, each
+     * on its own buffer descriptor.  A buffer out on loan keeps its flag
+     * until CDCRxRelease() has given it back.
+     */
+    CDCMaskInterrupts();
+    rearm = cdc_rx_rearm;
+    for(i = 0; i < CDC_DATA_OUT_BUFFERS; i++)
+    {
+        if((rearm & (1 << i)) && ((i != cdc_rx_next) || (cdc_rx_borrowed == false)))
+        {
+            CDCRxArm(i);
+            rearm &= ~(1 << i);
+        }
+    }
+    cdc_rx_rearm = rearm;
+    CDCUnmaskInterrupts();
+
+    handle = CDCDataOutHandle[cdc_rx_next];
+    if((handle == NULL) || USBHandleBusy(handle))
+    {
+        return 0;
+    }
+
+    cdc_rx_borrowed = true;
+    len = USBHandleGetLength(handle);
+    if(len == 0)
+    {
+        CDCRxRelease();
+        return 0;
+    }
+
+    *data = (uint8_t*)cdc_rx_buffer[cdc_rx_next];
+    return len;
+
+}//end CDCRxBorrow
+
+/**********************************************************************************
+  Function:
+        void CDCRxRelease(void)
+    
+  Summary:
+    CDCRxRelease gives the packet handed out by CDCRxBorrow() back to the
+    USB CDC Bulk OUT endpoint.
+
+  Description:
+    CDCRxRelease re-arms the dual-ram buffer last handed out by
+    CDCRxBorrow() for a later OUT transaction and moves on to the next
+    buffer.  It does nothing if no packet is waiting.
+    
+  Conditions:
+    None
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCRxRelease(void)
+{
+    USB_HANDLE handle;
+
+    handle = CDCDataOutHandle[cdc_rx_next];
+    if((handle == NULL) || USBHandleBusy(handle))
+    {
+        return;
+    }
+
+    CDCMaskInterrupts();
+    CDCRxArm(cdc_rx_next);
+    cdc_rx_borrowed = false;
+    if(++cdc_rx_next == CDC_DATA_OUT_BUFFERS)
+    {
+        cdc_rx_next = 0;
+    }
+    CDCUnmaskInterrupts();
+
+}//end CDCRxRelease
+
 /******************************************************************************
   Function:
 	void putUSBUSART(char *data, uint8_t length)
@@ -578,12 +879,12 @@ void putUSBUSART(uint8_t *data, uint8_t  length)
      * multi-tasking and a blocking code is not acceptable.
      * Use a state machine instead.
      */
-    USBMaskInterrupts();
+    CDCMaskInterrupts();
     if(cdc_trf_state == CDC_TX_READY)
     {
         mUSBUSARTTxRam((uint8_t*)data, length);     // See cdc.h
     }
-    USBUnmaskInterrupts();
+    CDCUnmaskInterrupts();
 }//end putUSBUSART
 
 /******************************************************************************
@@ -654,16 +955,11 @@ void putsUSBUSART(char *data)
      * multi-tasking and a blocking code is not acceptable.
      * Use a state machine instead.
      */
-    USBMaskInterrupts();
-    if(cdc_trf_state != CDC_TX_READY)
-    {
-        USBUnmaskInterrupts();
-        return;
-    }
     
     /*
      * While loop counts the number of BYTEs to send including the
-     * null character.
+     * null character.  Only the state check and the transfer setup
+     * below need the USB interrupt masked.
      */
     len = 0;
     pData = data;
@@ -673,6 +969,13 @@ void putsUSBUSART(char *data)
         if(len == 255) break;       // Break loop once max len is reached.
     }while(*pData++);
     
+    CDCMaskInterrupts();
+    if(cdc_trf_state != CDC_TX_READY)
+    {
+        CDCUnmaskInterrupts();
+        return;
+    }
+
     /*
      * Second piece of information (length of data to send) is ready.
      * Call mUSBUSARTTxRam to setup the transfer.
@@ -680,7 +983,7 @@ void putsUSBUSART(char *data)
      * which should be called once per Main Program loop.
      */
     mUSBUSARTTxRam((uint8_t*)data, len);     // See cdc.h
-    USBUnmaskInterrupts();
+    CDCUnmaskInterrupts();
 }//end putsUSBUSART
 
 /**************************************************************************
@@ -751,16 +1054,11 @@ void putrsUSBUSART(const const char *data)
      * multi-tasking and a blocking code is not acceptable.
      * Use a state machine instead.
      */
-    USBMaskInterrupts();
-    if(cdc_trf_state != CDC_TX_READY)
-    {
-        USBUnmaskInterrupts();
-        return;
-    }
     
     /*
      * While loop counts the number of BYTEs to send including the
-     * null character.
+     * null character.  Only the state check and the transfer setup
+     * below need the USB interrupt masked.
      */
     len = 0;
     pData = data;
@@ -770,6 +1068,13 @@ void putrsUSBUSART(const const char *data)
         if(len == 255) break;       // Break loop once max len is reached.
     }while(*pData++);
     
+    CDCMaskInterrupts();
+    if(cdc_trf_state != CDC_TX_READY)
+    {
+        CDCUnmaskInterrupts();
+        return;
+    }
+
     /*
      * Second piece of information (length of data to send) is ready.
      * Call mUSBUSARTTxRom to setup the transfer.
@@ -778,74 +1083,236 @@ void putrsUSBUSART(const const char *data)
      */
 
     mUSBUSARTTxRom((const uint8_t*)data,len); // See cdc.h
-    USBUnmaskInterrupts();
+    CDCUnmaskInterrupts();
 
 }//end putrsUSBUSART
 
 /************************************************************************
   Function:
-        void CDCTxService(void)
+        static void CDCTxSend(uint8_t len)
     
   Summary:
-    CDCTxService handles device-to-host transaction(s). This function
-    should be called once per Main Program loop after the device reaches
-    the configured state.
+    Hands the next IN buffer, holding 'len' BYTEs, to the SIE and moves
+    on to the other buffer.
+
+  Conditions:
+    Called with the USB interrupt masked.
+  ************************************************************************/
+static void CDCTxSend(uint8_t len)
+{
+    CDCDataInHandle[cdc_tx_next] = USBTxOnePacket(CDC_DATA_EP,(uint8_t*)cdc_tx_buffer[cdc_tx_next],len);
+    if(++cdc_tx_next == CDC_DATA_IN_BUFFERS)
+    {
+        cdc_tx_next = 0;
+    }
+}//end CDCTxSend
+
+#if defined(CDC_TX_FIFO_SIZE)
+/************************************************************************
+  Function:
+        static bool CDCTxFifoService(void)
+    
+  Summary:
+    Sends the next packet from the transmit FIFO, if one is due.
+
+  Conditions:
+    Called from CDCTxService() with the next IN buffer idle.  The FIFO
+    only changes in the main loop, so it is copied with the USB interrupt
+    enabled.
+  Output:
+    bool - true if a packet was queued.
+  ************************************************************************/
+static bool CDCTxFifoService(void)
+{
+    uint8_t *dst;
+    uint8_t byte_to_send;
+    uint8_t i;
+
+    /*
+     * Full packets go out as soon as they are there.  The rest waits for
+     * the next frame or CDCTxFlush(), so that small writes share packets.
+     */
+    if(cdc_tx_fifo_count >= CDC_DATA_IN_EP_SIZE)
+    {
+        byte_to_send = CDC_DATA_IN_EP_SIZE;
+    }
+    else if(cdc_tx_fifo_flush == true)
+    {
+        cdc_tx_fifo_flush = false;
+
+        /*
+         * A transfer that ended on a full packet is closed with a zero
+         * length packet. See USB Specification 2.0: Section 5.8.3
+         */
+        if((cdc_tx_fifo_count == 0) && (cdc_tx_fifo_zlp == false))
+        {
+            return false;
+        }
+        byte_to_send = cdc_tx_fifo_count;
+    }
+    else
+    {
+        return false;
+    }
+
+    dst = (uint8_t*)cdc_tx_buffer[cdc_tx_next];
+    for(i = 0; i < byte_to_send; i++)
+    {
+        dst[i] = cdc_tx_fifo[cdc_tx_fifo_tail];
+        if(++cdc_tx_fifo_tail == CDC_TX_FIFO_SIZE)
+        {
+            cdc_tx_fifo_tail = 0;
+        }
+    }
+    cdc_tx_fifo_count -= byte_to_send;
+    cdc_tx_fifo_zlp = (byte_to_send == CDC_DATA_IN_EP_SIZE);
+
+    CDCMaskInterrupts();
+    CDCTxSend(byte_to_send);
+    CDCUnmaskInterrupts();
+    return true;
+}//end CDCTxFifoService
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCTxWrite(const uint8_t *data, uint8_t length)
+    
+  Summary:
+    CDCTxWrite queues BYTEs for the USB CDC Bulk IN endpoint.  It is a
+    non-blocking function.
+
   Description:
-    CDCTxService handles device-to-host transaction(s). This function
-    should be called once per Main Program loop after the device reaches
-    the configured state (after the CDCIniEP() function has already executed).
-    This function is needed, in order to advance the internal software state 
-    machine that takes care of sending multiple transactions worth of IN USB
-    data to the host, associated with CDC serial data.  Failure to call 
-    CDCTxService() periodically will prevent data from being sent to the
-    USB host, over the CDC serial data interface.
+    CDCTxWrite copies as much of 'data' as fits into the transmit FIFO and
+    returns how much that was.  CDCTxService() sends the FIFO in packets of
+    CDC_DATA_IN_EP_SIZE BYTEs as soon as there are that many, and whatever
+    is left over on the next start of frame or after CDCTxFlush().  Writes
+    made during the same frame therefore share packets.  A transfer that
+    ends on a full packet is closed with a zero length packet.
     
+    Unlike putUSBUSART(), CDCTxWrite() can be called at any time, also
+    while a previous transfer is still in flight.
+
     Typical Usage:
     <code>
-    void main(void)
+        if(CDCTxAvailable() \>= sizeof(message))
+        {
+            CDCTxWrite(message, sizeof(message));
+        }
+    </code>
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h, and the application
+    forwards EVENT_SOF to USBCDCEventHandler().
+  Input:
+    data -    Pointer to the BYTEs to send, in RAM or program memory
+    length -  The number of BYTEs to send
+  Output:
+    uint8_t -    The number of BYTEs queued, from 0 up to length.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCTxWrite(const uint8_t *data, uint8_t length)
+{
+    uint8_t head;
+    uint8_t i;
+
+    if(length > (uint8_t)(CDC_TX_FIFO_SIZE - cdc_tx_fifo_count))
     {
-        USBDeviceInit();
-        while(1)
+        length = CDC_TX_FIFO_SIZE - cdc_tx_fifo_count;
+    }
+
+    head = cdc_tx_fifo_tail + cdc_tx_fifo_count;
+    if(head >= CDC_TX_FIFO_SIZE)
+    {
+        head -= CDC_TX_FIFO_SIZE;
+    }
+
+    for(i = 0; i < length; i++)
+    {
+        cdc_tx_fifo[head] = data[i];
+        if(++head == CDC_TX_FIFO_SIZE)
         {
-            USBDeviceTasks();
-            if((USBGetDeviceState() \< CONFIGURED_STATE) ||
-               (USBIsDeviceSuspended() == true))
-            {
-                //Either the device is not configured or we are suspended
-                //  so we don't want to do execute any application code
-                continue;   //go back to the top of the while loop
-            }
-            else
-            {
-                //Keep trying to send data to the PC as required
-                CDCTxService();
-    
-                //Run application code.
-                UserApplication();
-            }
+            head = 0;
         }
     }
-    </code>
+    cdc_tx_fifo_count += length;
+
+    return length;
+}//end CDCTxWrite
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCTxAvailable(void)
+    
+  Summary:
+    CDCTxAvailable returns how many BYTEs CDCTxWrite() would take right now.
+
+  Description:
+    CDCTxAvailable returns the free space in the transmit FIFO.  It only
+    grows between calls as CDCTxService() sends the FIFO out.
+    
   Conditions:
-    CDCIniEP() function should have already executed/the device should be
-    in the CONFIGURED_STATE.
-  Remarks:
-    None                                                                 
+    CDC_TX_FIFO_SIZE is defined in usb_config.h.
+  Input:
+    None
+  Output:
+    uint8_t -    The number of BYTEs free in the transmit FIFO.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCTxAvailable(void)
+{
+    return CDC_TX_FIFO_SIZE - cdc_tx_fifo_count;
+}//end CDCTxAvailable
+
+/**********************************************************************************
+  Function:
+        void CDCTxFlush(void)
+    
+  Summary:
+    CDCTxFlush sends what is in the transmit FIFO without waiting for the
+    next start of frame.
+
+  Description:
+    CDCTxFlush lets the next CDCTxService() send the BYTEs in the transmit
+    FIFO even if they do not fill a packet, or the zero length packet that
+    closes a transfer.  It does not wait for the packet to go out.
+    
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h.
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCTxFlush(void)
+{
+    cdc_tx_fifo_flush = true;
+}//end CDCTxFlush
+#endif
+
+/************************************************************************
+  Function:
+        static bool CDCTxPacket(void)
+    
+  Summary:
+    Queues the next IN packet of the put*USBUSART() transfer, or of the
+    transmit FIFO once that transfer is done, in the next IN buffer.
+
+  Conditions:
+    Called from CDCTxService().  The next IN buffer belongs to the CPU while
+    its UOWN bit is clear, so it is filled with the USB interrupt enabled.
+    Only handing it to the SIE, together with the transfer state that goes
+    with it, happens masked.
+  Output:
+    bool - true if a packet was queued and the next buffer may take
+           another one.
   ************************************************************************/
- 
-void CDCTxService(void)
+static bool CDCTxPacket(void)
 {
     uint8_t byte_to_send;
+    uint8_t state;
     uint8_t i;
     
-    USBMaskInterrupts();
-    
-    CDCNotificationHandler();
-    
-    if(USBHandleBusy(CDCDataInHandle)) 
+    if(USBHandleBusy(CDCDataInHandle[cdc_tx_next])) 
     {
-        USBUnmaskInterrupts();
-        return;
+        return false;
     }
 
     /*
@@ -857,12 +1324,15 @@ void CDCTxService(void)
         cdc_trf_state = CDC_TX_READY;
     
     /*
-     * If CDC_TX_READY state, nothing to do, just return.
+     * If CDC_TX_READY state, nothing to do but the transmit FIFO.
      */
     if(cdc_trf_state == CDC_TX_READY)
     {
-        USBUnmaskInterrupts();
-        return;
+        #if defined(CDC_TX_FIFO_SIZE)
+            return CDCTxFifoService();
+        #else
+            return false;
+        #endif
     }
     
     /*
@@ -870,17 +1340,17 @@ void CDCTxService(void)
      */
     if(cdc_trf_state == CDC_TX_BUSY_ZLP)
     {
-        CDCDataInHandle = USBTxOnePacket(CDC_DATA_EP,NULL,0);
+        byte_to_send = 0;
         //CDC_DATA_BD_IN.CNT = 0;
-        cdc_trf_state = CDC_TX_COMPLETING;
+        state = CDC_TX_COMPLETING;
     }
-    else if(cdc_trf_state == CDC_TX_BUSY)
+    else
     {
         /*
          * First, have to figure out how many byte of data to send.
          */
-    	if(cdc_tx_len > sizeof(cdc_data_tx))
-    	    byte_to_send = sizeof(cdc_data_tx);
+    	if(cdc_tx_len > CDC_DATA_IN_EP_SIZE)
+    	    byte_to_send = CDC_DATA_IN_EP_SIZE;
     	else
     	    byte_to_send = cdc_tx_len;
 
@@ -889,7 +1359,7 @@ void CDCTxService(void)
          */
     	cdc_tx_len = cdc_tx_len - byte_to_send;
     	  
-        pCDCDst.bRam = (uint8_t*)&cdc_data_tx; // Set destination pointer
+        pCDCDst.bRam = (uint8_t*)cdc_tx_buffer[cdc_tx_next]; // Set destination pointer
         
         i = byte_to_send;
         if(cdc_mem_type == USB_EP0_ROM)            // Determine type of memory source
@@ -917,20 +1387,159 @@ void CDCTxService(void)
          * Lastly, determine if a zero length packet state is necessary.
          * See explanation in USB Specification 2.0: Section 5.8.3
          */
+        state = CDC_TX_BUSY;
         if(cdc_tx_len == 0)
         {
             if(byte_to_send == CDC_DATA_IN_EP_SIZE)
-                cdc_trf_state = CDC_TX_BUSY_ZLP;
+                state = CDC_TX_BUSY_ZLP;
             else
-                cdc_trf_state = CDC_TX_COMPLETING;
+                state = CDC_TX_COMPLETING;
         }//end if(cdc_tx_len...)
-        CDCDataInHandle = USBTxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_tx,byte_to_send);
 
     }//end if(cdc_tx_sate == CDC_TX_BUSY)
+
+    CDCMaskInterrupts();
+
+    /*
+     * An endpoint halt flushes the transfer from the interrupt.  If that
+     * happened while the packet was being copied, drop the packet.
+     */
+    if(cdc_trf_state == CDC_TX_READY)
+    {
+        CDCUnmaskInterrupts();
+        return false;
+    }
+
+    cdc_trf_state = state;
+    CDCTxSend(byte_to_send);
+    CDCUnmaskInterrupts();
     
-    USBUnmaskInterrupts();
+    return true;
+}//end CDCTxPacket
+
+
+/************************************************************************
+  Function:
+        void CDCTxService(void)
+    
+  Summary:
+    CDCTxService handles device-to-host transaction(s). This function
+    should be called once per Main Program loop after the device reaches
+    the configured state.
+  Description:
+    CDCTxService handles device-to-host transaction(s). This function
+    should be called once per Main Program loop after the device reaches
+    the configured state (after the CDCIniEP() function has already executed).
+    This function is needed, in order to advance the internal software state 
+    machine that takes care of sending multiple transactions worth of IN USB
+    data to the host, associated with CDC serial data.  Failure to call 
+    CDCTxService() periodically will prevent data from being sent to the
+    USB host, over the CDC serial data interface.
+    
+    Typical Usage:
+    <code>
+    void main(void)
+    {
+        USBDeviceInit();
+        while(1)
+        {
+            USBDeviceTasks();
+            if((USBGetDeviceState() \< CONFIGURED_STATE) ||
+               (USBIsDeviceSuspended() == true))
+            {
+                //Either the device is not configured or we are suspended
+                //  so we don't want to do execute any application code
+                continue;   //go back to the top of the while loop
+            }
+            else
+            {
+                //Keep trying to send data to the PC as required
+                CDCTxService();
+    
+                //Run application code.
+                UserApplication();
+            }
+        }
+    }
+    </code>
+  Conditions:
+    CDCIniEP() function should have already executed/the device should be
+    in the CONFIGURED_STATE.
+  Remarks:
+    None                                                                 
+  ************************************************************************/
+ 
+void CDCTxService(void)
+{
+    uint8_t i;
+
+    #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
+        CDCMaskInterrupts();
+        CDCNotificationHandler();
+        CDCUnmaskInterrupts();
+    #endif
+
+    /*
+     * With ping-pong buffering two IN packets can be in flight at once,
+     * so fill every buffer that is idle.
+     */
+    for(i = 0; i < CDC_DATA_IN_BUFFERS; i++)
+    {
+        if(CDCTxPacket() == false)
+            break;
+    }
 }//end CDCTxService
 
+#if defined(CDC_MEASURE_MASKED_CYCLES)
+/**********************************************************************************
+  Function:
+        uint16_t CDCGetMaskedCycles(void)
+    
+  Summary:
+    CDCGetMaskedCycles returns the longest time the CDC driver has kept the
+    USB interrupt masked, in instruction cycles.
+
+  Description:
+    Each window the driver masks the USB interrupt for is timed with
+    Timer1 running from the instruction clock.  SOF and EP0 control
+    traffic wait for the longest of them.  The figure includes the few
+    cycles spent starting and stopping the timer, and the time spent in
+    any other interrupt serviced inside the window, since the timer keeps
+    counting through it.  USB events wait for that time as well.
+    
+  Conditions:
+    CDC_MEASURE_MASKED_CYCLES is defined in usb_config.h and Timer1 is not
+    used for anything else.
+  Input:
+    None
+  Output:
+    uint16_t -    The longest masked window since CDCClearMaskedCycles().
+                                                                                   
+  **********************************************************************************/
+uint16_t CDCGetMaskedCycles(void)
+{
+    return cdc_masked_cycles;
+}//end CDCGetMaskedCycles
+
+/**********************************************************************************
+  Function:
+        void CDCClearMaskedCycles(void)
+    
+  Summary:
+    CDCClearMaskedCycles starts timing the longest masked window afresh.
+
+  Conditions:
+    CDC_MEASURE_MASKED_CYCLES is defined in usb_config.h.
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCClearMaskedCycles(void)
+{
+    cdc_masked_cycles = 0;
+}//end CDCClearMaskedCycles
+#endif
+
 #endif //USB_USE_CDC
 
 /** EOF cdc.c ****************************************************************/
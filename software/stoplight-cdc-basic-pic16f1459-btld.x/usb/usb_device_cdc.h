@@ -652,6 +652,69 @@ bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size);
   **********************************************************************************/
 uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len);
 
+/**********************************************************************************
+  Function:
+        uint8_t CDCRxBorrow(uint8_t **data)
+    
+  Summary:
+    CDCRxBorrow hands out the oldest packet received through the USB CDC Bulk
+    OUT endpoint in place, without copying it.  It is a non-blocking function.
+
+  Description:
+    CDCRxBorrow points 'data' at the dual-ram buffer holding the oldest
+    received packet and returns its length.  The buffer belongs to the
+    caller until CDCRxRelease() gives it back to the endpoint; calling
+    CDCRxBorrow() again before that returns the same packet.  With
+    ping-pong buffering the other buffer stays armed meanwhile, so the
+    host can keep sending while the caller parses.  Zero length packets
+    are released here and never handed out.
+    
+    Typical Usage:
+    <code>
+        uint8_t *data;
+        uint8_t numBytes;
+    
+        numBytes = CDCRxBorrow(&data);
+        if(numBytes \> 0)
+        {
+            //data[0] to data[numBytes - 1] hold the packet.  Use them,
+            //  then hand the buffer back.
+            CDCRxRelease();
+        }
+    </code>
+  Conditions:
+    The buffer must not be written to, and must not be used after
+    CDCRxRelease().
+  Input:
+    data -  Pointer to where the address of the received BYTEs is stored
+  Output:
+    uint8_t -    The number of BYTEs in the packet, 0 if no new CDC bulk OUT
+              endpoint data was available.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCRxBorrow(uint8_t **data);
+
+/**********************************************************************************
+  Function:
+        void CDCRxRelease(void)
+    
+  Summary:
+    CDCRxRelease gives the packet handed out by CDCRxBorrow() back to the
+    USB CDC Bulk OUT endpoint.
+
+  Description:
+    CDCRxRelease re-arms the dual-ram buffer last handed out by
+    CDCRxBorrow() for a later OUT transaction and moves on to the next
+    buffer.  It does nothing if no packet is waiting.
+    
+  Conditions:
+    None
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCRxRelease(void);
+
 /******************************************************************************
   Function:
 	void putUSBUSART(char *data, uint8_t length)
@@ -968,6 +1031,132 @@ extern const uint8_t configDescriptor1[];
 //void putsUSBUSART(char *data);
 //void putrsUSBUSART(const const char *data);
 //void CDCTxService(void);
+
+#if defined(CDC_TX_FIFO_SIZE)
+/**********************************************************************************
+  Function:
+        uint8_t CDCTxWrite(const uint8_t *data, uint8_t length)
+    
+  Summary:
+    CDCTxWrite queues BYTEs for the USB CDC Bulk IN endpoint.  It is a
+    non-blocking function.
+
+  Description:
+    CDCTxWrite copies as much of 'data' as fits into the transmit FIFO and
+    returns how much that was.  CDCTxService() sends the FIFO in packets of
+    CDC_DATA_IN_EP_SIZE BYTEs as soon as there are that many, and whatever
+    is left over on the next start of frame or after CDCTxFlush().  Writes
+    made during the same frame therefore share packets.  A transfer that
+    ends on a full packet is closed with a zero length packet.
+    
+    Unlike putUSBUSART(), CDCTxWrite() can be called at any time, also
+    while a previous transfer is still in flight.
+
+    Typical Usage:
+    <code>
+        if(CDCTxAvailable() \>= sizeof(message))
+        {
+            CDCTxWrite(message, sizeof(message));
+        }
+    </code>
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h, and the application
+    forwards EVENT_SOF to USBCDCEventHandler().
+  Input:
+    data -    Pointer to the BYTEs to send, in RAM or program memory
+    length -  The number of BYTEs to send
+  Output:
+    uint8_t -    The number of BYTEs queued, from 0 up to length.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCTxWrite(const uint8_t *data, uint8_t length);
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCTxAvailable(void)
+    
+  Summary:
+    CDCTxAvailable returns how many BYTEs CDCTxWrite() would take right now.
+
+  Description:
+    CDCTxAvailable returns the free space in the transmit FIFO.  It only
+    grows between calls as CDCTxService() sends the FIFO out.
+    
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h.
+  Input:
+    None
+  Output:
+    uint8_t -    The number of BYTEs free in the transmit FIFO.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCTxAvailable(void);
+
+/**********************************************************************************
+  Function:
+        void CDCTxFlush(void)
+    
+  Summary:
+    CDCTxFlush sends what is in the transmit FIFO without waiting for the
+    next start of frame.
+
+  Description:
+    CDCTxFlush lets the next CDCTxService() send the BYTEs in the transmit
+    FIFO even if they do not fill a packet, or the zero length packet that
+    closes a transfer.  It does not wait for the packet to go out.
+    
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h.
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCTxFlush(void);
+#endif
+
+#if defined(CDC_MEASURE_MASKED_CYCLES)
+/**********************************************************************************
+  Function:
+        uint16_t CDCGetMaskedCycles(void)
+    
+  Summary:
+    CDCGetMaskedCycles returns the longest time the CDC driver has kept the
+    USB interrupt masked, in instruction cycles.
+
+  Description:
+    Each window the driver masks the USB interrupt for is timed with
+    Timer1 running from the instruction clock.  SOF and EP0 control
+    traffic wait for the longest of them.  The figure includes the few
+    cycles spent starting and stopping the timer, and the time spent in
+    any other interrupt serviced inside the window, since the timer keeps
+    counting through it.  USB events wait for that time as well.
+    
+  Conditions:
+    CDC_MEASURE_MASKED_CYCLES is defined in usb_config.h and Timer1 is not
+    used for anything else.
+  Input:
+    None
+  Output:
+    uint16_t -    The longest masked window since CDCClearMaskedCycles().
+                                                                                   
+  **********************************************************************************/
+uint16_t CDCGetMaskedCycles(void);
+
+/**********************************************************************************
+  Function:
+        void CDCClearMaskedCycles(void)
+    
+  Summary:
+    CDCClearMaskedCycles starts timing the longest masked window afresh.
+
+  Conditions:
+    CDC_MEASURE_MASKED_CYCLES is defined in usb_config.h.
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCClearMaskedCycles(void);
+#endif
 //void CDCNotificationHandler(void);
 //------------------------------------------------------------------------------
 //DOM-IGNORE-END
@@ -22,12 +22,36 @@
 
 #include <xc.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include <buttons.h>
+#include <tick.h>
+#include <matrix.h>
 
 /*** Button Definitions *********************************************/
-#define S1_PORT  PORTBbits.RB6
-#define S2_PORT  PORTBbits.RB5
-#define S3_PORT  PORTBbits.RB4
+/* Direct-wired buttons all sit on PORTB and are sampled with a single
+ * port read.  The debounce engine keeps one bit per PORTB pin in every
+ * state byte (a "lane"), so all of the buttons are debounced at the same
+ * time.  The pins are configured through whole-port registers with the
+ * button masks, so this file only names the port registers below. */
+#define BUTTON_PORT         PORTB
+#define BUTTON_TRIS         TRISB
+#define BUTTON_ANSEL        ANSELB
+#define BUTTON_WPU          WPUB
+#define BUTTON_PORT_MASK    0x70
+
+#define S1_MASK  0x40   // RB6
+#define S2_MASK  0x20   // RB5
+#define S3_MASK  0x10   // RB4
+
+#define S1_BIT   6
+#define S2_BIT   5
+#define S3_BIT   4
+
+/* Interrupt-on-change registers of the button port. */
+#define BUTTON_IOC_RISING   IOCBP
+#define BUTTON_IOC_FALLING  IOCBN
+#define BUTTON_IOC_FLAGS    IOCBF
 
 #define BUTTON_PRESSED      0
 #define BUTTON_NOT_PRESSED  1
@@ -38,7 +62,567 @@
 #define PIN_DIGITAL         1
 #define PIN_ANALOG          0
 
-static int state1, state2, state3, timer;
+/* Number of 8-bit lanes sampled per tick, and key slots per lane. */
+#define BUTTON_LANE_BITS    8
+
+/* Lane and bit mask of each button, in BUTTON enumeration order. */
+#if defined(MATRIX_SCAN_ENABLE)
+/* Matrix key r * MATRIX_COLS + c lives in lane key / 8, bit key % 8. */
+#define BUTTON_LANES        (MATRIX_KEYS / BUTTON_LANE_BITS)
+
+static const uint8_t buttonLane[] = { 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1 };
+static const uint8_t buttonMask[] = { 0, 0x01, 0x02, 0x04,
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+static const uint8_t buttonBit[]  = { 0, 0, 1, 2,
+    0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+/* Button reported in the key events of each key slot. */
+#define BUTTON_SLOT_BUTTON(slot)    ((BUTTON)(BUTTON_R0C0 + (slot)))
+#else
+/* Matrix keys map to an empty slot and never read as pressed. */
+#define BUTTON_LANES        1
+
+static const uint8_t buttonLane[] = { 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+static const uint8_t buttonMask[] = { 0, S1_MASK, S2_MASK, S3_MASK,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+static const uint8_t buttonBit[]  = { 0, S1_BIT, S2_BIT, S3_BIT,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/* Button reported in the key events of each key slot. */
+static const uint8_t slotButton[] = { BUTTON_NONE, BUTTON_NONE,
+    BUTTON_NONE, BUTTON_NONE, BUTTON_S3, BUTTON_S2, BUTTON_S1, BUTTON_NONE };
+#define BUTTON_SLOT_BUTTON(slot)    ((BUTTON)slotButton[slot])
+#endif
+
+static BUTTON_DEBOUNCE_MODE debounceMode;
+static uint8_t timer;
+static uint8_t samplePeriod = BUTTON_SAMPLE_PERIOD_DEFAULT;
+/* TICK_Get() at the previous update; timed work runs once per ms. */
+static uint16_t lastUpdate;
+
+/* Debounced state, 1 = pressed. */
+static volatile uint8_t debounced[BUTTON_LANES];
+/* Vertical counter bit 0 for BUTTON_DEBOUNCE_STATE_MACHINE: set when the
+ * previous sample already disagreed with the debounced state. */
+static uint8_t count0[BUTTON_LANES];
+/* Pressed keys whose contact reads open and are counting down their
+ * release lockout (BUTTON_DEBOUNCE_EAGER). */
+static uint8_t releasing[BUTTON_LANES];
+static uint8_t lockout[BUTTON_LANES * BUTTON_LANE_BITS];
+static uint8_t releaseLockout[BUTTON_LANES * BUTTON_LANE_BITS];
+/* TICK_Get() time of the last debounced press of each key. */
+static uint16_t pressTime[BUTTON_LANES * BUTTON_LANE_BITS];
+
+/* Wear counters of each key.  Only keys whose raw contact changed are
+ * visited, so a quiet scan costs one compare per lane.  Directly wired
+ * keys count the edges the interrupt-on-change handler captured, in
+ * either debounce mode; a matrix has no edge interrupt and counts the
+ * changes between its scans. */
+typedef struct
+{
+    uint16_t actuations;    // debounced presses
+    uint16_t changes;       // debounced presses and releases
+    uint16_t edges;         // raw sample changes
+    uint8_t longestBounce;  // ms
+    uint8_t bounceLength;   // ms into the current burst of edges
+    uint16_t lastEdge;      // TICK_Get() of the last raw edge
+} BUTTON_KEY_STATS;
+
+#if defined(MATRIX_SCAN_ENABLE)
+static uint8_t lastSample[BUTTON_LANES];
+#endif
+static BUTTON_KEY_STATS stats[BUTTON_LANES * BUTTON_LANE_BITS];
+
+/* Edges captured by the interrupt-on-change handler, oldest first.  The
+ * IOC interrupt is the only producer and BUTTON_UpdateStates() the only
+ * consumer, so the head and tail indices need no locking. */
+#define BUTTON_EDGE_QUEUE_SIZE  8   // must be a power of 2
+
+typedef struct
+{
+    uint16_t time;      // TICK_Get() when the edge was seen
+    uint8_t changed;    // pins that changed, lane 0 bit order
+    uint8_t closed;     // pins closed after the edge
+} BUTTON_EDGE;
+
+static BUTTON_EDGE edgeQueue[BUTTON_EDGE_QUEUE_SIZE];
+static volatile uint8_t edgeHead;
+static volatile uint8_t edgeTail;
+
+/* Lane 0 keys the edge interrupt has seen close since the state machine
+ * last sampled them open, and when.  A press the state machine accepts
+ * is stamped with that edge rather than with its first sample.  Always
+ * empty in the matrix build, which has no edge interrupt. */
+static uint8_t closeSeen;
+static uint16_t closeTime[BUTTON_LANE_BITS];
+
+/* Debounced key events, oldest first.  BUTTON_UpdateStates() runs in
+ * interrupt context and is the only producer; BUTTON_GetEvent() is the
+ * only consumer.  Each index is written by one side only and is a single
+ * byte, so neither side has to mask interrupts. */
+#define BUTTON_EVENT_QUEUE_SIZE 16  // must be a power of 2
+
+static BUTTON_EVENT eventQueue[BUTTON_EVENT_QUEUE_SIZE];
+static volatile uint8_t eventHead;
+static volatile uint8_t eventTail;
+static volatile uint16_t eventOverflow;
+
+/*********************************************************************
+* Function: static void BUTTON_Sample(uint8_t *sample);
+*
+* Overview: Reads every button lane in one port access each and returns
+*           1 for each closed contact.
+*
+********************************************************************/
+static void BUTTON_Sample(uint8_t *sample)
+{
+#if defined(MATRIX_SCAN_ENABLE)
+    MATRIX_Read(sample);
+#else
+    sample[0] = (uint8_t)~BUTTON_PORT & BUTTON_PORT_MASK;
+#endif
+}
+
+/*********************************************************************
+* Function: static void BUTTON_PostEvents(uint8_t lane, uint8_t changed);
+*
+* Overview: Queues a press or release event for every changed key of a
+*           lane, counting the events that do not fit.
+*
+********************************************************************/
+static void BUTTON_PostEvents(uint8_t lane, uint8_t changed)
+{
+    uint8_t mask;
+    uint8_t slot;
+    uint8_t next;
+
+    slot = lane * BUTTON_LANE_BITS;
+    for(mask = 0x01; mask != 0; mask <<= 1, slot++)
+    {
+        if((changed & mask) == 0)
+        {
+            continue;
+        }
+
+        if(stats[slot].changes != 0xFFFF)
+        {
+            stats[slot].changes++;
+        }
+        if(((debounced[lane] & mask) != 0) && (stats[slot].actuations != 0xFFFF))
+        {
+            stats[slot].actuations++;
+        }
+
+        next = (eventHead + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+        if(next == eventTail)
+        {
+            eventOverflow++;
+            continue;
+        }
+
+        eventQueue[eventHead] = BUTTON_SLOT_BUTTON(slot) |
+            (((debounced[lane] & mask) != 0) ? BUTTON_EVENT_PRESSED : 0);
+        eventHead = next;
+    }
+}
+
+/*********************************************************************
+* Function: static void BUTTON_CountEdges(uint8_t lane, uint8_t edges, uint16_t now);
+*
+* Overview: Updates the edge counters of the keys of a lane whose raw
+*           sample changed.  Edges less than BUTTON_BOUNCE_GAP_MS apart
+*           are timed as one burst.
+*
+********************************************************************/
+static void BUTTON_CountEdges(uint8_t lane, uint8_t edges, uint16_t now)
+{
+    uint8_t mask;
+    uint8_t slot;
+    uint16_t gap;
+    BUTTON_KEY_STATS *key;
+
+    slot = lane * BUTTON_LANE_BITS;
+    for(mask = 0x01; mask != 0; mask <<= 1, slot++)
+    {
+        if((edges & mask) == 0)
+        {
+            continue;
+        }
+
+        key = &stats[slot];
+        if(key->edges != 0xFFFF)
+        {
+            key->edges++;
+        }
+
+        gap = now - key->lastEdge;
+        key->lastEdge = now;
+
+        if(gap >= BUTTON_BOUNCE_GAP_MS)
+        {
+            key->bounceLength = 0;
+            continue;
+        }
+
+        gap += key->bounceLength;
+        key->bounceLength = (gap > 0xFF) ? 0xFF : (uint8_t)gap;
+        if(key->bounceLength > key->longestBounce)
+        {
+            key->longestBounce = key->bounceLength;
+        }
+    }
+}
+
+/*********************************************************************
+* Function: static void BUTTON_Press(uint8_t lane, uint8_t closed, uint16_t time);
+*
+* Overview: Marks the closed keys of a lane pressed, cancels any pending
+*           release and stamps keys that were released with the time.
+*
+********************************************************************/
+static void BUTTON_Press(uint8_t lane, uint8_t closed, uint16_t time)
+{
+    uint8_t mask;
+    uint8_t pressed;
+    uint16_t *stamp;
+
+    pressed = closed & ~debounced[lane];
+    if(pressed != 0)
+    {
+        stamp = &pressTime[lane * BUTTON_LANE_BITS];
+        for(mask = 0x01; mask != 0; mask <<= 1, stamp++)
+        {
+            if((pressed & mask) != 0)
+            {
+                *stamp = time;
+            }
+        }
+    }
+
+    debounced[lane] |= closed;
+    releasing[lane] &= ~closed;
+}
+
+/*********************************************************************
+* Function: static void BUTTON_SeeClose(uint8_t closed, uint16_t time);
+*
+* Overview: Notes the time of the first closing edge of lane 0 keys that
+*           are not pressed, for the state machine to stamp their press.
+*
+********************************************************************/
+static void BUTTON_SeeClose(uint8_t closed, uint16_t time)
+{
+    uint8_t mask;
+    uint8_t i;
+
+    closed &= ~debounced[0] & ~closeSeen;
+    closeSeen |= closed;
+    for(i = 0, mask = 0x01; closed != 0; mask <<= 1, i++)
+    {
+        if((closed & mask) != 0)
+        {
+            closeTime[i] = time;
+            closed &= ~mask;
+        }
+    }
+}
+
+/*********************************************************************
+* Function: static void BUTTON_Release(uint8_t lane);
+*
+* Overview: Counts down the release lockout of every key in the lane
+*           that is waiting to be released.  Only runs while a key is
+*           being released, so the idle cost is a single test.
+*
+********************************************************************/
+static void BUTTON_Release(uint8_t lane)
+{
+    uint8_t mask;
+    uint8_t *count;
+
+    count = &lockout[lane * BUTTON_LANE_BITS];
+
+    for(mask = 0x01; mask != 0; mask <<= 1, count++)
+    {
+        if((releasing[lane] & mask) != 0)
+        {
+            if(--(*count) == 0)
+            {
+                releasing[lane] &= ~mask;
+                debounced[lane] &= ~mask;
+            }
+        }
+    }
+}
+
+/*********************************************************************
+* Function: void BUTTON_UpdateStates(void);
+*
+* Overview: Samples the buttons and advances the debounce algorithm
+*           selected with BUTTON_SetDebounceMode().  Called on every scan
+*           tick; the lockout and sample timers count milliseconds of
+*           TICK_Get().
+*
+*           BUTTON_DEBOUNCE_STATE_MACHINE samples once per sample period
+*           (10ms by default) and needs two samples in a row that
+*           disagree with the debounced state before it changes, so a
+*           press is reported one to two periods after the contact
+*           closes.
+*
+*           BUTTON_DEBOUNCE_EAGER samples on every call and reports the
+*           press on the first pressed sample (one tick).  The release is
+*           only reported once the contact has read open for the
+*           button's release lockout time, which masks both the press
+*           and the release bounce.
+*
+*           Both algorithms work on whole lanes with bitwise operations,
+*           so the cost does not grow with the number of keys in a lane.
+*
+* PreCondition: button configured via BUTTON_Enable()
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_UpdateStates (void)
+{
+    uint8_t sample[BUTTON_LANES];
+    uint8_t before[BUTTON_LANES];
+    uint8_t lane;
+    uint8_t delta;
+    uint8_t toggle;
+    uint8_t edgePressed;
+    uint8_t mask;
+    uint8_t i;
+    uint16_t now;
+    bool millisecond;
+
+    now = TICK_Get();
+    millisecond = (now != lastUpdate);
+    lastUpdate = now;
+
+    for(lane = 0; lane < BUTTON_LANES; lane++)
+    {
+        before[lane] = debounced[lane];
+    }
+
+    // count every captured edge, however short; the eager algorithm also
+    // replays them so taps shorter than a tick are not lost and presses
+    // carry the time of the edge rather than of the tick, while the state
+    // machine polls and only counts them
+    edgePressed = 0;
+    while(edgeTail != edgeHead)
+    {
+        BUTTON_EDGE *edge = &edgeQueue[edgeTail];
+
+        BUTTON_CountEdges(0, edge->changed, edge->time);
+        if(debounceMode == BUTTON_DEBOUNCE_EAGER)
+        {
+            BUTTON_Press(0, edge->changed & edge->closed, edge->time);
+            edgePressed |= edge->changed & edge->closed;
+        }
+        else
+        {
+            BUTTON_SeeClose(edge->changed & edge->closed, edge->time);
+        }
+        edgeTail = (edgeTail + 1) & (BUTTON_EDGE_QUEUE_SIZE - 1);
+    }
+
+    if(debounceMode == BUTTON_DEBOUNCE_EAGER)
+    {
+        BUTTON_Sample(sample);
+        sample[0] |= edgePressed;
+
+        for(lane = 0; lane < BUTTON_LANES; lane++)
+        {
+            // closed contacts are pressed at once and cancel a pending release
+            BUTTON_Press(lane, sample[lane], now);
+
+            // newly opened contacts start their release lockout
+            delta = debounced[lane] & ~sample[lane] & ~releasing[lane];
+            if(delta != 0)
+            {
+                i = lane * BUTTON_LANE_BITS;
+                for(mask = 0x01; mask != 0; mask <<= 1, i++)
+                {
+                    if((delta & mask) != 0)
+                    {
+                        lockout[i] = releaseLockout[i];
+                    }
+                }
+                releasing[lane] |= delta;
+            }
+
+            if((releasing[lane] != 0) && millisecond)
+            {
+                BUTTON_Release(lane);
+            }
+
+            if(debounced[lane] != before[lane])
+            {
+                BUTTON_PostEvents(lane, debounced[lane] ^ before[lane]);
+            }
+
+            #if defined(MATRIX_SCAN_ENABLE)
+            if(sample[lane] != lastSample[lane])
+            {
+                BUTTON_CountEdges(lane, sample[lane] ^ lastSample[lane], now);
+                lastSample[lane] = sample[lane];
+            }
+            #endif
+        }
+        return;
+    }
+
+    if(!millisecond)
+    {
+        return;
+    }
+
+    // run this every sample period to debounce and update button states for is pressed functions
+    if (timer < samplePeriod - 1) {
+        timer++;
+        return;
+    }
+    timer = 0;
+
+    BUTTON_Sample(sample);
+
+    for(lane = 0; lane < BUTTON_LANES; lane++)
+    {
+        // one-bit vertical counter: toggle on the second disagreeing sample
+        delta = sample[lane] ^ debounced[lane];
+        toggle = delta & count0[lane];
+        count0[lane] = delta & ~toggle;
+        debounced[lane] ^= toggle & ~sample[lane];
+        // a press is accepted on its second sample; stamp it with the first,
+        // or with the edge that closed the contact if the interrupt saw it
+        BUTTON_Press(lane, toggle & sample[lane], now - samplePeriod);
+        if(lane == 0)
+        {
+            delta = toggle & sample[0] & closeSeen;
+            for(i = 0, mask = 0x01; delta != 0; mask <<= 1, i++)
+            {
+                if((delta & mask) != 0)
+                {
+                    pressTime[i] = closeTime[i];
+                    delta &= ~mask;
+                }
+            }
+            // keep only keys still closed and waiting for their press
+            closeSeen &= sample[0] & ~debounced[0];
+        }
+
+        if(toggle != 0)
+        {
+            BUTTON_PostEvents(lane, toggle);
+        }
+
+        #if defined(MATRIX_SCAN_ENABLE)
+        if(sample[lane] != lastSample[lane])
+        {
+            BUTTON_CountEdges(lane, sample[lane] ^ lastSample[lane], now);
+            lastSample[lane] = sample[lane];
+        }
+        #endif
+    }
+}
+
+/*********************************************************************
+* Function: void BUTTON_InterruptHandler(void);
+*
+* Overview: Interrupt-on-change handler for the button port.  Records
+*           every edge with its TICK_Get() time for the next call of
+*           BUTTON_UpdateStates().  When the queue is full the edge is
+*           merged into the newest entry, so a press is never lost.
+*
+* PreCondition: Called from the interrupt vector when IOCIF is set.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_InterruptHandler(void)
+{
+    uint8_t changed;
+    uint8_t next;
+    BUTTON_EDGE *edge;
+
+    changed = BUTTON_IOC_FLAGS & BUTTON_PORT_MASK;
+    BUTTON_IOC_FLAGS &= ~changed;
+
+    next = (edgeHead + 1) & (BUTTON_EDGE_QUEUE_SIZE - 1);
+    if(next != edgeTail)
+    {
+        edge = &edgeQueue[edgeHead];
+        edge->time = TICK_Get();
+        edge->changed = changed;
+        edge->closed = (uint8_t)~BUTTON_PORT & BUTTON_PORT_MASK;
+        edgeHead = next;
+    }
+    else
+    {
+        edge = &edgeQueue[(edgeHead - 1) & (BUTTON_EDGE_QUEUE_SIZE - 1)];
+        edge->changed |= changed;
+        edge->closed |= (uint8_t)~BUTTON_PORT & BUTTON_PORT_MASK;
+    }
+}
+
+/*********************************************************************
+* Function: bool BUTTON_GetEvent(BUTTON_EVENT *event);
+*
+* Overview: Takes the oldest key event from the event queue.
+*
+* PreCondition: None.  Only one caller may consume events.
+*
+* Input: BUTTON_EVENT *event - receives the event
+*
+* Output: true if an event was returned, false if the queue is empty
+*
+********************************************************************/
+bool BUTTON_GetEvent(BUTTON_EVENT *event)
+{
+    if(eventTail == eventHead)
+    {
+        return false;
+    }
+
+    *event = eventQueue[eventTail];
+    eventTail = (eventTail + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+    return true;
+}
+
+/*********************************************************************
+* Function: uint16_t BUTTON_GetEventOverflowCount(void);
+*
+* Overview: Returns the number of key events dropped because the event
+*           queue was full.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: dropped events since start-up, wrapping at 65536
+*
+********************************************************************/
+uint16_t BUTTON_GetEventOverflowCount(void)
+{
+    uint16_t count;
+
+    //The count is updated in interrupt context and isn't read atomically,
+    //so read it until two reads agree.
+    do
+    {
+        count = eventOverflow;
+    } while(count != eventOverflow);
+
+    return count;
+}
 
 /*********************************************************************
 * Function: bool BUTTON_IsPressed(BUTTON button);
@@ -56,84 +640,162 @@ static int state1, state2, state3, timer;
 * Output: TRUE if pressed; FALSE if not pressed.
 *
 ********************************************************************/
+bool BUTTON_IsPressed(BUTTON button)
+{
+    return ((debounced[buttonLane[button]] & buttonMask[button]) != 0);
+}
 
-void BUTTON_UpdateStates (void)
+/*********************************************************************
+* Function: uint16_t BUTTON_GetPressTime(BUTTON button);
+*
+* Overview: Returns the TICK_Get() time of the last press of the button:
+*           the edge that closed the contact, in either mode.  A matrix
+*           has no edge interrupt; there BUTTON_DEBOUNCE_STATE_MACHINE
+*           stamps a press with the first sample that saw it closed.
+*
+* PreCondition: button configured via BUTTON_Enable()
+*
+* Input: BUTTON button - the button to query
+*
+* Output: time of the last press in milliseconds
+*
+********************************************************************/
+uint16_t BUTTON_GetPressTime(BUTTON button)
 {
-    // run this every 10-20ms to debounce and update button states for is pressed functions
-    if (timer < 9) {
-        timer++;
-    } else {
-        timer = 0;
-        
-        // button 1 debounce state machine
-        switch (state1) {
-            case 0: 
-                state1 = (S1_PORT == BUTTON_PRESSED) ? 1 : 0;
-                break;
-            case 1: 
-                state1 = (S1_PORT == BUTTON_PRESSED) ? 2 : 0;
-                break;
-            case 2: 
-                state1 = (S1_PORT == BUTTON_PRESSED) ? 2 : 3;
-                break;
-            case 3: 
-                state1 = (S1_PORT == BUTTON_PRESSED) ? 2 : 0;
-                break;
-        }
-
-        // button 2 debounce state machine
-        switch (state2) {
-            case 0: 
-                state2 = (S2_PORT == BUTTON_PRESSED) ? 1 : 0;
-                break;
-            case 1: 
-                state2 = (S2_PORT == BUTTON_PRESSED) ? 2 : 0;
-                break;
-            case 2: 
-                state2 = (S2_PORT == BUTTON_PRESSED) ? 2 : 3;
-                break;
-            case 3: 
-                state2 = (S2_PORT == BUTTON_PRESSED) ? 2 : 0;
-                break;
-        }
-
-        // button 3 debounce state machine
-        switch (state3) {
-            case 0: 
-                state3 = (S3_PORT == BUTTON_PRESSED) ? 1 : 0;
-                break;
-            case 1: 
-                state3 = (S3_PORT == BUTTON_PRESSED) ? 2 : 0;
-                break;
-            case 2: 
-                state3 = (S3_PORT == BUTTON_PRESSED) ? 2 : 3;
-                break;
-            case 3: 
-                state3 = (S3_PORT == BUTTON_PRESSED) ? 2 : 0;
-                break;
-        }
-    }
+    return pressTime[(buttonLane[button] * BUTTON_LANE_BITS) + buttonBit[button]];
 }
 
+/*********************************************************************
+* Function: void BUTTON_GetStats(BUTTON button, BUTTON_STATS *counters);
+*
+* Overview: Returns the wear counters of a button.
+*
+* PreCondition: Must not be interrupted by BUTTON_UpdateStates() (call
+*               from interrupt context).
+*
+* Input: BUTTON button - the button to query
+*        BUTTON_STATS *counters - receives the counters
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_GetStats(BUTTON button, BUTTON_STATS *counters)
+{
+    BUTTON_KEY_STATS *key;
 
-bool BUTTON_IsPressed(BUTTON button)
+    key = &stats[(buttonLane[button] * BUTTON_LANE_BITS) + buttonBit[button]];
+
+    counters->actuations = key->actuations;
+    counters->edges = key->edges;
+    counters->longestBounce = key->longestBounce;
+
+    // every edge that did not become a debounced change was a bounce
+    counters->bounces = (key->edges > key->changes) ? (key->edges - key->changes) : 0;
+}
+
+/*********************************************************************
+* Function: void BUTTON_ClearStats(void);
+*
+* Overview: Clears the wear counters of every button.
+*
+* PreCondition: Must not be interrupted by BUTTON_UpdateStates() (call
+*               from interrupt context).
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_ClearStats(void)
+{
+    memset(stats, 0, sizeof(stats));
+}
+
+/*********************************************************************
+* Function: void BUTTON_SetDebounceMode(BUTTON_DEBOUNCE_MODE mode);
+*
+* Overview: Selects the debounce algorithm used by BUTTON_UpdateStates().
+*           All buttons restart from the released state; a release event
+*           is queued for each button that was pressed.  Call it from
+*           interrupt context or before the scan tick is started.
+*
+* PreCondition: None
+*
+* Input: BUTTON_DEBOUNCE_MODE mode - the algorithm to use
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_SetDebounceMode(BUTTON_DEBOUNCE_MODE mode)
 {
-    switch(button)
+    uint8_t lane;
+    uint8_t pressed;
+
+    debounceMode = mode;
+    timer = 0;
+
+    for(lane = 0; lane < BUTTON_LANES; lane++)
     {
-        case BUTTON_S1:
-            return ((state1 >= 2) ? true : false);
+        pressed = debounced[lane];
+        debounced[lane] = 0;
+        count0[lane] = 0;
+        releasing[lane] = 0;
 
-        case BUTTON_S2:
-            return ((state2 >= 2) ? true : false);
+        // keys held across the change are released
+        if(pressed != 0)
+        {
+            BUTTON_PostEvents(lane, pressed);
+        }
+    }
 
-        case BUTTON_S3:
-            return ((state3 >= 2) ? true : false);
+    edgeTail = edgeHead;
+    closeSeen = 0;
+}
 
-        case BUTTON_NONE:
-            return false;
+/*********************************************************************
+* Function: void BUTTON_SetSamplePeriod(uint8_t milliseconds);
+*
+* Overview: Sets how often BUTTON_DEBOUNCE_STATE_MACHINE samples the
+*           buttons.  A change must be seen on two samples in a row, so
+*           presses and releases are reported one to two periods late.
+*
+* PreCondition: None
+*
+* Input: uint8_t milliseconds - sample period, 1-255ms
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_SetSamplePeriod(uint8_t milliseconds)
+{
+    samplePeriod = (milliseconds != 0) ? milliseconds : 1;
+    timer = 0;
+}
+
+/*********************************************************************
+* Function: void BUTTON_SetReleaseLockout(BUTTON button, uint8_t milliseconds);
+*
+* Overview: Sets how long the contact of a button must read open before
+*           BUTTON_DEBOUNCE_EAGER reports it released.  Pick a value just
+*           above the worst bounce time of the switch.
+*
+* PreCondition: None
+*
+* Input: BUTTON button - the button to configure
+*        uint8_t milliseconds - release lockout time, 1-255ms
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_SetReleaseLockout(BUTTON button, uint8_t milliseconds)
+{
+    if(button == BUTTON_NONE)
+    {
+        return;
     }
-    
-    return false;
+
+    releaseLockout[(buttonLane[button] * BUTTON_LANE_BITS) + buttonBit[button]] =
+        (milliseconds != 0) ? milliseconds : 1;
 }
 
 /*********************************************************************
@@ -154,30 +816,28 @@ bool BUTTON_IsPressed(BUTTON button)
 ********************************************************************/
 void BUTTON_Enable(BUTTON button)
 {
-    switch(button)
+    if(button == BUTTON_NONE)
     {
-        case BUTTON_S1:
-            OPTION_REGbits.nWPUEN = 0;
-            TRISBbits.TRISB6 = PIN_INPUT;
-            WPUBbits.WPUB6 = 1;
-            state1 = 0;
-            break;
+        return;
+    }
 
-        case BUTTON_S2:
-            TRISBbits.TRISB5 = PIN_INPUT;
-            ANSELBbits.ANSB5 = 0;
-            WPUBbits.WPUB5 = 1;
-            state2 = 0;
-            break;
+    debounced[buttonLane[button]] &= ~buttonMask[button];
+    BUTTON_SetReleaseLockout(button, BUTTON_RELEASE_LOCKOUT_DEFAULT);
 
-        case BUTTON_S3:
-            TRISBbits.TRISB4 = PIN_INPUT;
-            ANSELBbits.ANSB4 = 0;
-            WPUBbits.WPUB4 = 1;
-            state3 = 0;
-            break;
+#if defined(MATRIX_SCAN_ENABLE)
+    // the scan steps a row on every tick; see SYS_InterruptHigh()
+    MATRIX_Initialize();
+#else
+    // digital input with the weak pull-up on
+    OPTION_REGbits.nWPUEN = 0;
+    BUTTON_ANSEL &= ~buttonMask[button];
+    BUTTON_TRIS |= buttonMask[button];
+    BUTTON_WPU |= buttonMask[button];
 
-        case BUTTON_NONE:
-            break;
-    }
+    // capture both edges of the pin; the handler runs from SYS_InterruptHigh()
+    BUTTON_IOC_RISING |= buttonMask[button];
+    BUTTON_IOC_FALLING |= buttonMask[button];
+    BUTTON_IOC_FLAGS &= ~buttonMask[button];
+    INTCONbits.IOCIE = 1;
+#endif
 }
@@ -0,0 +1,126 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#include <xc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <hef.h>
+
+/*********************************************************************
+* Function: static void HEF_Unlock(void);
+*
+* Overview: Runs the program memory unlock sequence, starting the erase
+*           or write set up in PMCON1.  The sequence must not be
+*           interrupted, so interrupts are held off until the CPU resumes.
+*
+********************************************************************/
+static void HEF_Unlock(void)
+{
+    bool gie;
+
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+
+    PMCON2 = 0x55;
+    PMCON2 = 0xAA;
+    PMCON1bits.WR = 1;
+    NOP();
+    NOP();
+
+    INTCONbits.GIE = gie;
+}
+
+/*********************************************************************
+* Function: void HEF_Read(uint8_t *data, uint8_t size);
+*
+* Overview: Copies the first size bytes of the HEF row into data.
+*
+* PreCondition: None
+*
+* Input: uint8_t *data - destination
+*        uint8_t size - number of bytes, at most HEF_ROW_SIZE
+*
+* Output: None
+*
+********************************************************************/
+void HEF_Read(uint8_t *data, uint8_t size)
+{
+    uint8_t i;
+
+    PMCON1bits.CFGS = 0;
+    PMADRH = (uint8_t)(HEF_ROW_ADDRESS >> 8);
+
+    for(i = 0; i < size; i++)
+    {
+        PMADRL = (uint8_t)HEF_ROW_ADDRESS + i;
+        PMCON1bits.RD = 1;
+        NOP();
+        NOP();
+        data[i] = PMDATL;
+    }
+}
+
+/*********************************************************************
+* Function: void HEF_Write(const uint8_t *data, uint8_t size);
+*
+* Overview: Erases the HEF row and writes size bytes of data to it.
+*
+* PreCondition: None
+*
+* Input: const uint8_t *data - bytes to store
+*        uint8_t size - number of bytes, at most HEF_ROW_SIZE
+*
+* Output: None
+*
+********************************************************************/
+void HEF_Write(const uint8_t *data, uint8_t size)
+{
+    uint8_t i;
+
+    PMCON1bits.CFGS = 0;
+    PMADRH = (uint8_t)(HEF_ROW_ADDRESS >> 8);
+    PMADRL = (uint8_t)HEF_ROW_ADDRESS;
+
+    //erase the row
+    PMCON1bits.FREE = 1;
+    PMCON1bits.WREN = 1;
+    HEF_Unlock();
+
+    //load the write latches, then write the row on the last word
+    PMCON1bits.FREE = 0;
+    PMCON1bits.LWLO = 1;
+    for(i = 0; i < size; i++)
+    {
+        PMADRL = (uint8_t)HEF_ROW_ADDRESS + i;
+        PMDATH = 0x3F;
+        PMDATL = data[i];
+
+        if(i == (size - 1))
+        {
+            PMCON1bits.LWLO = 0;
+        }
+        HEF_Unlock();
+    }
+
+    PMCON1bits.LWLO = 0;
+    PMCON1bits.WREN = 0;
+}
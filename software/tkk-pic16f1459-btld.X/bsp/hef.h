@@ -0,0 +1,70 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#ifndef HEF_H
+#define HEF_H
+
+#include <stdint.h>
+
+/*** High-Endurance Flash *******************************************/
+/* The last program memory row of the PIC16F1459 (0x1FE0-0x1FFF) is
+ * kept for data; the linker --rom option of the projects excludes it.
+ * One byte is stored in the low byte of each 14-bit word, which is the
+ * part of the High-Endurance Flash rated for 100k erase/write cycles. */
+#define HEF_ROW_ADDRESS     0x1FE0
+#define HEF_ROW_SIZE        32
+
+/*********************************************************************
+* Function: void HEF_Read(uint8_t *data, uint8_t size);
+*
+* Overview: Copies the first size bytes of the HEF row into data.  An
+*           erased row reads as 0xFF.
+*
+* PreCondition: None
+*
+* Input: uint8_t *data - destination
+*        uint8_t size - number of bytes, at most HEF_ROW_SIZE
+*
+* Output: None
+*
+********************************************************************/
+void HEF_Read(uint8_t *data, uint8_t size);
+
+/*********************************************************************
+* Function: void HEF_Write(const uint8_t *data, uint8_t size);
+*
+* Overview: Erases the HEF row and writes size bytes of data to it; the
+*           rest of the row is left erased.  The CPU stalls for about
+*           4ms while the row is erased and written, so call this from
+*           the main loop, never from an interrupt handler.
+*
+* PreCondition: None
+*
+* Input: const uint8_t *data - bytes to store
+*        uint8_t size - number of bytes, at most HEF_ROW_SIZE
+*
+* Output: None
+*
+********************************************************************/
+void HEF_Write(const uint8_t *data, uint8_t size);
+
+#endif //HEF_H
@@ -0,0 +1,109 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stdint.h>
+
+/*** Matrix Definitions *********************************************/
+/* Define MATRIX_SCAN_ENABLE (here or with -D in the project options) to
+ * scan a MATRIX_ROWS x MATRIX_COLS key matrix in place of the three
+ * direct-wired buttons.  Rows are driven low one at a time on RC0-RC3,
+ * columns are read on RB4-RB7 using the PORTB weak pull-ups.  Switch
+ * diodes (cathode towards the row) are optional; without them ghost
+ * keys are detected and masked, see MATRIX_GetGhostCount(). */
+//#define MATRIX_SCAN_ENABLE
+
+#define MATRIX_ROWS     4
+#define MATRIX_COLS     4
+#define MATRIX_KEYS     (MATRIX_ROWS * MATRIX_COLS)
+
+/*********************************************************************
+* Function: void MATRIX_Initialize(void);
+*
+* Overview: Configures the row and column pins and drives the first row.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void MATRIX_Initialize(void);
+
+/*********************************************************************
+* Function: void MATRIX_Read(uint8_t *lanes);
+*
+* Overview: Copies the last complete scan into button lanes, key
+*           r * MATRIX_COLS + c in bit (key & 7) of lanes[key >> 3].
+*           A 1 bit is a closed contact.
+*
+* PreCondition: MATRIX_Initialize() called.  Must not be interrupted by
+*               MATRIX_ScanRow() (call from interrupt context).
+*
+* Input: uint8_t *lanes - MATRIX_KEYS / 8 bytes
+*
+* Output: None
+*
+********************************************************************/
+void MATRIX_Read(uint8_t *lanes);
+
+/*********************************************************************
+* Function: uint16_t MATRIX_GetGhostCount(void);
+*
+* Overview: Returns the number of scans in which a ghost key could not
+*           be told apart from a real one.  Rows that show a ghost keep
+*           their previous state until the ambiguity clears.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: number of ambiguous scans, wrapping at 65536
+*
+********************************************************************/
+uint16_t MATRIX_GetGhostCount(void);
+
+/*********************************************************************
+* Function: void MATRIX_ScanRow(void);
+*
+* Overview: Reads the columns of the row driven by the previous call and
+*           drives the next row, so each row has a full tick to settle.
+*           A full scan takes MATRIX_ROWS ticks, 1ms at 4kHz.
+*
+*           Cycle budget: about 40 instruction cycles per row and
+*           another 120 at the end of each scan for the ghost check,
+*           well under 200 cycles (17us) of the 1500 cycle (125us) tick
+*           at the fastest TICK_RATE_HZ.
+*
+* PreCondition: Called from the tick interrupt, once per tick.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void MATRIX_ScanRow(void);
+
+#endif //MATRIX_H
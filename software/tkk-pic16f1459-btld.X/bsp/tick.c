@@ -0,0 +1,227 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#include <xc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <tick.h>
+
+/* Timer2 runs from Fosc/4 = 12MHz with a 1:3 postscaler; the prescaler
+ * and period give each supported rate exactly. */
+#define TICK_T2CON_PRESCALE_16  0x16    // T2OUTPS = 1:3, TMR2ON, T2CKPS = 1:16
+#define TICK_T2CON_PRESCALE_4   0x15    // T2OUTPS = 1:3, TMR2ON, T2CKPS = 1:4
+
+static volatile uint16_t tickCount;
+/* Ticks since the last millisecond tick, and ticks per millisecond. */
+static volatile uint8_t subTick;
+static uint8_t ticksPerMs = TICK_RATE_HZ / 1000;
+static uint8_t tickT2con = (TICK_RATE_HZ <= 2000) ?
+    TICK_T2CON_PRESCALE_16 : TICK_T2CON_PRESCALE_4;
+static uint8_t tickPr2 = (((TICK_RATE_HZ <= 2000) ? 250000UL : 1000000UL) /
+    TICK_RATE_HZ) - 1;
+
+/*********************************************************************
+* Function: void TICK_Initialize(void);
+*
+* Overview: Starts Timer2 at the tick rate and enables its interrupt.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void TICK_Initialize(void)
+{
+    subTick = 0;
+
+    PR2 = tickPr2;
+    TMR2 = 0;
+    T2CON = tickT2con;
+    PIR1bits.TMR2IF = 0;
+    PIE1bits.TMR2IE = 1;
+    INTCONbits.PEIE = 1;
+}
+
+/*********************************************************************
+* Function: bool TICK_InterruptHandler(void);
+*
+* Overview: Timer2 interrupt handler.  Clears the interrupt and advances
+*           the millisecond clock once every millisecond of ticks.
+*
+* PreCondition: Called from the interrupt vector when TMR2IF is set.
+*
+* Input: None
+*
+* Output: true on the tick that starts a new millisecond
+*
+********************************************************************/
+bool TICK_InterruptHandler(void)
+{
+    PIR1bits.TMR2IF = 0;
+
+    if(++subTick < ticksPerMs)
+    {
+        return false;
+    }
+
+    subTick = 0;
+    tickCount++;
+    return true;
+}
+
+/*********************************************************************
+* Function: bool TICK_SetRate(uint16_t rateHz);
+*
+* Overview: Changes the tick rate.  Takes effect at once if the tick is
+*           running; the millisecond clock carries on counting.
+*
+* PreCondition: None
+*
+* Input: uint16_t rateHz - 1000, 2000, 4000 or 8000
+*
+* Output: false if the rate is not supported, the rate is unchanged
+*
+********************************************************************/
+bool TICK_SetRate(uint16_t rateHz)
+{
+    switch(rateHz)
+    {
+        case 1000:
+        case 2000:
+            tickT2con = TICK_T2CON_PRESCALE_16;
+            tickPr2 = (uint8_t)((250000UL / rateHz) - 1);
+            break;
+
+        case 4000:
+        case 8000:
+            tickT2con = TICK_T2CON_PRESCALE_4;
+            tickPr2 = (uint8_t)((1000000UL / rateHz) - 1);
+            break;
+
+        default:
+            return false;
+    }
+
+    ticksPerMs = (uint8_t)(rateHz / 1000);
+    subTick = 0;
+
+    if(T2CONbits.TMR2ON)
+    {
+        //writing T2CON and TMR2 also clears the pre- and postscaler
+        T2CON = tickT2con;
+        PR2 = tickPr2;
+        TMR2 = 0;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+* Function: uint16_t TICK_GetRate(void);
+*
+* Overview: Returns the tick rate set by TICK_SetRate().
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: tick rate in Hz
+*
+********************************************************************/
+uint16_t TICK_GetRate(void)
+{
+    return (uint16_t)ticksPerMs * 1000;
+}
+
+/*********************************************************************
+* Function: void TICK_Synchronize(void);
+*
+* Overview: Keeps the millisecond tick in phase with the USB frames.
+*           In phase, the millisecond tick falls within one tick after
+*           the SOF.  Otherwise the current tick is restarted at the SOF
+*           and the next one is made the millisecond tick; this only
+*           ever shortens a millisecond, so none is lost.  With the
+*           oscillator tuned to the USB clock this happens once after
+*           start-up and after each resume.
+*
+*           At 1kHz the tick is the millisecond and the postscaler that
+*           divides it can't be read, so the phase is not measured: the
+*           tick is restarted at every SOF, part way into its first timer
+*           period, to fall 5/6ms after the SOF.  In phase the restart
+*           finds the timer where it puts it and changes nothing.  The
+*           first restart after start-up or a resume can stretch one
+*           millisecond by up to 5/6ms.
+*
+* PreCondition: TICK_Initialize() called
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void TICK_Synchronize(void)
+{
+    if(ticksPerMs == 1)
+    {
+        //a write to TMR2 also clears the pre- and postscaler; the first
+        //of the three periods is then half a period short
+        TMR2 = tickPr2 / 2;
+        PIR1bits.TMR2IF = 0;
+        return;
+    }
+
+    if((subTick != 0) && (subTick != (ticksPerMs - 1)))
+    {
+        //a write to TMR2 also clears the pre- and postscaler
+        TMR2 = 0;
+        PIR1bits.TMR2IF = 0;
+        subTick = ticksPerMs - 1;
+    }
+}
+
+/*********************************************************************
+* Function: uint16_t TICK_Get(void);
+*
+* Overview: Returns the monotonic millisecond clock.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: milliseconds since start-up, modulo 65536
+*
+********************************************************************/
+uint16_t TICK_Get(void)
+{
+    uint16_t now;
+
+    //The count is updated in interrupt context and isn't read atomically,
+    //so read it until two reads agree.
+    do
+    {
+        now = tickCount;
+    } while(now != tickCount);
+
+    return now;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef APP_DEVICE_CDC_CONTROL_H
+#define APP_DEVICE_CDC_CONTROL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "usb_device_cdc.h"
+
+/* The CDC control port reads and writes the pages of the vendor feature
+ * report, see app_device_keyboard.h, for hosts that would rather talk to
+ * a serial port than send HID feature reports.  Each line sent to it is
+ * up to APP_FEATURE_REPORT_SIZE bytes in hex, separated by spaces, and
+ * ends with CR or LF:
+ *   "02"             reads page 2
+ *   "00 01 02 05 05" writes page 0 as a SET_REPORT would, then reads it
+ * A read answers with the page as a line of hex bytes, page number
+ * first, and anything it cannot parse with "?". */
+
+/*********************************************************************
+* Function: void APP_DeviceCDCControlInitialize(void);
+*
+* Overview: Initializes the control port.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_DeviceCDCControlInitialize(void);
+
+/*********************************************************************
+* Function: void APP_DeviceCDCControlTasks(void);
+*
+* Overview: Answers the lines received, one per call, and keeps the CDC
+*           driver transmitting.
+*
+* PreCondition: APP_DeviceCDCControlInitialize() has been called since
+*               the device was configured.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_DeviceCDCControlTasks(void);
+
+#endif //APP_DEVICE_CDC_CONTROL_H
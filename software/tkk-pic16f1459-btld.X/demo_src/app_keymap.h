@@ -0,0 +1,264 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef APP_KEYMAP_H
+#define APP_KEYMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "buttons.h"
+
+/* Board the keymap is built for.  Define one; a MATRIX_SCAN_ENABLE build
+ * uses the 4x4 matrix keymap instead. */
+//#define KEYMAP_BOARD_ONE_KEY
+#define KEYMAP_BOARD_THREE_KEY
+//#define KEYMAP_BOARD_BIG_RED_BUTTON
+
+/* Layers of the keymap.  The active layer is the highest one held by a
+ * momentary layer key or switched on by a toggle layer key; layer 0 is
+ * always on. */
+#define KEYMAP_LAYERS           2
+
+/* Dual-role keys a keymap can have, see KEYMAP_TAP_HOLD(). */
+#define KEYMAP_TAP_HOLDS        4
+
+/* Keys that make up a chord, bit n for key n, see KEYMAP_KEY(). */
+typedef uint16_t KEYMAP_KEYS;
+
+#define KEYMAP_KEY(key)                 ((KEYMAP_KEYS)1 << (key))
+
+/* What a key does: the kind in the high byte and its argument in the low
+ * byte. */
+typedef uint16_t KEYMAP_ACTION;
+
+#define KEYMAP_ACTION_KIND(action)      ((action) & 0xFF00)
+#define KEYMAP_ACTION_ARG(action)       ((uint8_t)(action))
+
+#define KEYMAP_KIND_USAGE               0x0000
+#define KEYMAP_KIND_MOMENTARY           0x0100
+#define KEYMAP_KIND_TOGGLE              0x0200
+#define KEYMAP_KIND_MACRO               0x0300
+#define KEYMAP_KIND_CONSUMER            0x0400
+#define KEYMAP_KIND_SYSTEM              0x0500
+#define KEYMAP_KIND_TAP_HOLD            0x0600
+#define KEYMAP_KIND_REPEAT              0x0700
+
+/* Keymap entries. */
+#define KEYMAP_NONE                     0x0000
+/* Keyboard page usage, including the modifiers 0xE0-0xE7. */
+#define KEYMAP_USAGE(usage)             (KEYMAP_KIND_USAGE | (usage))
+/* Layer on while the key is held. */
+#define KEYMAP_MOMENTARY(layer)         (KEYMAP_KIND_MOMENTARY | (layer))
+/* Layer switched on or off by each press. */
+#define KEYMAP_TOGGLE(layer)            (KEYMAP_KIND_TOGGLE | (layer))
+/* Macro typed by each press, see app_macro.c. */
+#define KEYMAP_MACRO(macro)             (KEYMAP_KIND_MACRO | (macro))
+/* Consumer page usage 0x01-0xFF, e.g. 0xCD Play/Pause, 0xE2 Mute. */
+#define KEYMAP_CONSUMER(usage)          (KEYMAP_KIND_CONSUMER | (usage))
+/* Generic desktop system control: 0x81 Power Down, 0x82 Sleep, 0x83
+ * Wake Up. */
+#define KEYMAP_SYSTEM(usage)            (KEYMAP_KIND_SYSTEM | (usage))
+/* Dual-role key: one action when tapped, another when held and a third
+ * when tapped twice, see the TAP_HOLD lines of app_keymap.c and
+ * app_tap_hold.h.  The actions cannot be dual-role keys themselves. */
+#define KEYMAP_TAP_HOLD(tapHold)        (KEYMAP_KIND_TAP_HOLD | (tapHold))
+
+/* Keyboard page usage the keyboard repeats itself while the key is held
+ * and the host does not, see app_typematic.h. */
+#define KEYMAP_REPEAT(usage)            (KEYMAP_KIND_REPEAT | (usage))
+
+/* Actions of a dual-role key. */
+#define KEYMAP_ROLE_TAP                 0
+#define KEYMAP_ROLE_HOLD                1
+#define KEYMAP_ROLE_DOUBLE_TAP          2
+#define KEYMAP_ROLES                    3
+
+/* Chord number of a key change that is not a chord. */
+#define KEYMAP_NO_CHORD                 0xFF
+
+/* Key number of a button that is not in the keymap. */
+#define KEYMAP_NO_KEY                   0xFF
+
+/*********************************************************************
+* Function: uint8_t APP_KeymapGetKeyCount(void);
+*
+* Overview: Returns the number of keys in the keymap.  Keys are numbered
+*           from 0.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: number of keys
+*
+********************************************************************/
+uint8_t APP_KeymapGetKeyCount(void);
+
+/*********************************************************************
+* Function: BUTTON APP_KeymapGetButton(uint8_t key);
+*
+* Overview: Returns the button of a key.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number
+*
+* Output: the button read for the key
+*
+********************************************************************/
+BUTTON APP_KeymapGetButton(uint8_t key);
+
+/*********************************************************************
+* Function: uint8_t APP_KeymapFindKey(BUTTON button);
+*
+* Overview: Returns the key number of a button.
+*
+* PreCondition: None
+*
+* Input: BUTTON button - the button to look up
+*
+* Output: key number, or KEYMAP_NO_KEY if the button has no key
+*
+********************************************************************/
+uint8_t APP_KeymapFindKey(BUTTON button);
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapPress(uint8_t key);
+*
+* Overview: Looks up the action of a key that was pressed in the active
+*           layer.  The action is kept until the key is released, so a
+*           layer change while the key is down does not change what its
+*           release does.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number
+*
+* Output: the action of the key
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapPress(uint8_t key);
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapRelease(uint8_t key);
+*
+* Overview: Returns the action taken by the press of a key that was
+*           released.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number
+*
+* Output: the action the key was pressed with
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapRelease(uint8_t key);
+
+/*********************************************************************
+* Function: void APP_KeymapApplyLayer(KEYMAP_ACTION action, bool down);
+*
+* Overview: Acts on the press or release of a layer key.  Other actions
+*           are ignored.
+*
+* PreCondition: None
+*
+* Input: KEYMAP_ACTION action - the action pressed or released
+*        bool down - true for a press
+*
+* Output: None
+*
+********************************************************************/
+void APP_KeymapApplyLayer(KEYMAP_ACTION action, bool down);
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapGetTapHold(uint8_t tapHold,
+*                                             uint8_t role);
+*
+* Overview: Returns one of the actions of a dual-role key.
+*
+* PreCondition: None
+*
+* Input: uint8_t tapHold - argument of the KEYMAP_TAP_HOLD() action
+*        uint8_t role - KEYMAP_ROLE_TAP, _HOLD or _DOUBLE_TAP
+*
+* Output: the action, or KEYMAP_NONE if the key has none for the role
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapGetTapHold(uint8_t tapHold, uint8_t role);
+
+/*********************************************************************
+* Function: uint8_t APP_KeymapGetChordCount(void);
+*
+* Overview: Returns the number of chords in the keymap.  Chords are
+*           numbered from 0.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: number of chords
+*
+********************************************************************/
+uint8_t APP_KeymapGetChordCount(void);
+
+/*********************************************************************
+* Function: KEYMAP_KEYS APP_KeymapGetChordKeys(uint8_t chord);
+*
+* Overview: Returns the keys pressed together for a chord.
+*
+* PreCondition: None
+*
+* Input: uint8_t chord - chord number
+*
+* Output: the keys of the chord
+*
+********************************************************************/
+KEYMAP_KEYS APP_KeymapGetChordKeys(uint8_t chord);
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapGetChord(uint8_t chord);
+*
+* Overview: Returns the action of a chord.  Chords do not change with
+*           the layer.
+*
+* PreCondition: None
+*
+* Input: uint8_t chord - chord number
+*
+* Output: the action of the chord
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapGetChord(uint8_t chord);
+
+/*********************************************************************
+* Function: void APP_KeymapReleaseAll(void);
+*
+* Overview: Forgets every key that is down and every momentary layer.
+*           Toggled layers stay on.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_KeymapReleaseAll(void);
+
+#endif //APP_KEYMAP_H
@@ -0,0 +1,291 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system.h"
+#include "usb.h"
+#include "hef.h"
+#include "tick.h"
+#include "app_settings.h"
+#include "app_tap_hold.h"
+#include "app_typematic.h"
+#include "app_chord.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope or Global Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Marks a row written by this firmware; change it if the layout of
+ * APP_SETTINGS changes so old rows fall back to the defaults. */
+#define APP_SETTINGS_MAGIC  0xA8
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Settings as stored in High-Endurance Flash. */
+typedef struct
+{
+    uint8_t magic;
+    uint8_t debounceMode;
+    uint8_t scanRateKHz;
+    uint8_t pressWindow;
+    uint8_t releaseWindow;
+    uint8_t holdWindow;
+    uint8_t doubleTapWindow;
+    uint8_t typematicOn;
+    uint8_t typematicDelay;
+    uint8_t typematicInterval;
+    uint8_t typematicMinInterval;
+    uint8_t typematicAcceleration;
+    uint8_t chordWindow;
+    uint8_t checksum;
+} APP_SETTINGS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope or Global Variables
+// *****************************************************************************
+// *****************************************************************************
+static APP_SETTINGS settings;
+static volatile bool savePending;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros or Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint8_t APP_SettingsChecksum(const APP_SETTINGS *s)
+{
+    const uint8_t *bytes;
+    uint8_t sum;
+    uint8_t i;
+
+    // every byte but the checksum itself, which is the last
+    bytes = (const uint8_t*)s;
+    sum = 0;
+    for(i = 0; i < sizeof(APP_SETTINGS) - 1; i++)
+    {
+        sum += bytes[i];
+    }
+    return (uint8_t)~sum;
+}
+
+static bool APP_SettingsValid(uint8_t debounceMode, uint8_t scanRateKHz,
+                              uint8_t pressWindow, uint8_t releaseWindow,
+                              uint8_t holdWindow)
+{
+    if(debounceMode > BUTTON_DEBOUNCE_EAGER)
+    {
+        return false;
+    }
+
+    if((scanRateKHz != 1) && (scanRateKHz != 2) &&
+       (scanRateKHz != 4) && (scanRateKHz != 8))
+    {
+        return false;
+    }
+
+    return ((pressWindow != 0) && (releaseWindow != 0) && (holdWindow != 0));
+}
+
+static bool APP_SettingsTypematicValid(uint8_t on, uint8_t delay,
+                                       uint8_t interval, uint8_t minInterval)
+{
+    return ((on <= APP_SETTINGS_TYPEMATIC_ON) && (delay != 0) &&
+            (minInterval != 0) && (minInterval <= interval));
+}
+
+static void APP_SettingsApply(bool modeChanged, bool rateChanged)
+{
+    BUTTON button;
+
+    //Changing the algorithm restarts the debouncer, so only do it when needed.
+    if(modeChanged == true)
+    {
+        BUTTON_SetDebounceMode((BUTTON_DEBOUNCE_MODE)settings.debounceMode);
+    }
+
+    BUTTON_SetSamplePeriod(settings.pressWindow);
+    for(button = BUTTON_S1; button <= BUTTON_R3C3; button++)
+    {
+        BUTTON_SetReleaseLockout(button, settings.releaseWindow);
+    }
+
+    //A new rate restarts the tick out of phase with the frames until the
+    //next SOF, so only set it when it changes.
+    if(rateChanged == true)
+    {
+        TICK_SetRate((uint16_t)settings.scanRateKHz * 1000);
+    }
+
+    APP_TapHoldSetWindows(settings.holdWindow, settings.doubleTapWindow);
+
+    APP_TypematicSetTiming(settings.typematicOn == APP_SETTINGS_TYPEMATIC_ON,
+                           settings.typematicDelay, settings.typematicInterval,
+                           settings.typematicMinInterval,
+                           settings.typematicAcceleration);
+
+    APP_ChordSetWindow(settings.chordWindow);
+}
+
+void APP_SettingsLoad(void)
+{
+    HEF_Read((uint8_t*)&settings, sizeof(settings));
+
+    if((settings.magic != APP_SETTINGS_MAGIC) ||
+       (settings.checksum != APP_SettingsChecksum(&settings)) ||
+       (APP_SettingsValid(settings.debounceMode, settings.scanRateKHz,
+                          settings.pressWindow, settings.releaseWindow,
+                          settings.holdWindow) == false) ||
+       (APP_SettingsTypematicValid(settings.typematicOn, settings.typematicDelay,
+                                   settings.typematicInterval,
+                                   settings.typematicMinInterval) == false))
+    {
+        settings.magic = APP_SETTINGS_MAGIC;
+        settings.debounceMode = BUTTON_USB_DEVICE_HID_KEYBOARD_DEBOUNCE;
+        settings.scanRateKHz = TICK_RATE_HZ / 1000;
+        settings.pressWindow = BUTTON_SAMPLE_PERIOD_DEFAULT;
+        settings.releaseWindow = BUTTON_RELEASE_LOCKOUT_DEFAULT;
+        settings.holdWindow = APP_TAP_HOLD_WINDOW_DEFAULT;
+        settings.doubleTapWindow = APP_TAP_HOLD_DOUBLE_TAP_WINDOW_DEFAULT;
+        settings.typematicOn = APP_SETTINGS_TYPEMATIC_ON;
+        settings.typematicDelay = APP_TYPEMATIC_DELAY_DEFAULT;
+        settings.typematicInterval = APP_TYPEMATIC_INTERVAL_DEFAULT;
+        settings.typematicMinInterval = APP_TYPEMATIC_MIN_INTERVAL_DEFAULT;
+        settings.typematicAcceleration = APP_TYPEMATIC_ACCELERATION_DEFAULT;
+        settings.chordWindow = APP_CHORD_WINDOW_DEFAULT;
+    }
+
+    APP_SettingsApply(true, true);
+}
+
+void APP_SettingsTasks(void)
+{
+    APP_SETTINGS stored;
+
+    if(savePending == false)
+    {
+        return;
+    }
+
+    //Take a consistent copy; SET_REPORT updates the settings from the USB
+    //interrupt.
+    USBMaskInterrupts();
+    savePending = false;
+    stored = settings;
+    USBUnmaskInterrupts();
+
+    stored.checksum = APP_SettingsChecksum(&stored);
+    HEF_Write((const uint8_t*)&stored, sizeof(stored));
+}
+
+void APP_SettingsGetReport(uint8_t *report)
+{
+    report[1] = settings.debounceMode;
+    report[2] = settings.scanRateKHz;
+    report[3] = settings.pressWindow;
+    report[4] = settings.releaseWindow;
+    report[6] = settings.holdWindow;
+    report[7] = settings.doubleTapWindow;
+}
+
+void APP_SettingsSetReport(const uint8_t *report)
+{
+    bool modeChanged;
+    bool rateChanged;
+
+    if(APP_SettingsValid(report[1], report[2], report[3], report[4], report[6]) == false)
+    {
+        return;
+    }
+
+    modeChanged = (report[1] != settings.debounceMode);
+    rateChanged = (report[2] != settings.scanRateKHz);
+
+    settings.debounceMode = report[1];
+    settings.scanRateKHz = report[2];
+    settings.pressWindow = report[3];
+    settings.releaseWindow = report[4];
+    settings.holdWindow = report[6];
+    settings.doubleTapWindow = report[7];
+    APP_SettingsApply(modeChanged, rateChanged);
+
+    if((report[5] & APP_SETTINGS_SAVE) != 0)
+    {
+        savePending = true;
+    }
+}
+
+void APP_SettingsGetTypematicReport(uint8_t *report)
+{
+    report[1] = settings.typematicOn;
+    report[2] = settings.typematicDelay;
+    report[3] = settings.typematicInterval;
+    report[4] = settings.typematicMinInterval;
+    report[5] = settings.typematicAcceleration;
+}
+
+void APP_SettingsSetTypematicReport(const uint8_t *report)
+{
+    if(APP_SettingsTypematicValid(report[1], report[2], report[3], report[4]) == false)
+    {
+        return;
+    }
+
+    settings.typematicOn = report[1];
+    settings.typematicDelay = report[2];
+    settings.typematicInterval = report[3];
+    settings.typematicMinInterval = report[4];
+    settings.typematicAcceleration = report[5];
+    APP_SettingsApply(false, false);
+
+    if((report[6] & APP_SETTINGS_SAVE) != 0)
+    {
+        savePending = true;
+    }
+}
+
+void APP_SettingsGetChordReport(uint8_t *report)
+{
+    report[1] = settings.chordWindow;
+}
+
+void APP_SettingsSetChordReport(const uint8_t *report)
+{
+    settings.chordWindow = report[1];
+    APP_SettingsApply(false, false);
+
+    if((report[2] & APP_SETTINGS_SAVE) != 0)
+    {
+        savePending = true;
+    }
+}
@@ -0,0 +1,179 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef APP_SETTINGS_H
+#define APP_SETTINGS_H
+
+#include <stdint.h>
+
+/* Settings page of the vendor feature report (APP_FEATURE_PAGE_SETTINGS):
+ *   [1] debounce algorithm, a BUTTON_DEBOUNCE_MODE
+ *   [2] scan tick rate in kHz: 1, 2, 4 or 8
+ *   [3] press window in ms: the state machine sample period, 1-255
+ *   [4] release window in ms: the release lockout of every key, 1-255
+ *   [5] SET_REPORT only: APP_SETTINGS_SAVE to also store the settings in
+ *       High-Endurance Flash so they survive a reset
+ *   [6] dual-role key hold window in 10ms units, 1-255
+ *   [7] dual-role key double tap window in 10ms units, 0 (off)-255
+ * A SET_REPORT with any field out of range is ignored. */
+#define APP_SETTINGS_SAVE           0x01
+
+/* Typematic page of the vendor feature report (APP_FEATURE_PAGE_TYPEMATIC),
+ * the repeat of KEYMAP_REPEAT keys while the host has the keyboard idle
+ * rate at 0, see app_typematic.h:
+ *   [1] APP_SETTINGS_TYPEMATIC_ON, or 0 for no repeat
+ *   [2] delay before the first repeat in 10ms units, 1-255
+ *   [3] first interval between repeats in ms, 1-255
+ *   [4] shortest interval in ms, 1 up to the first interval
+ *   [5] ms taken off the interval by each repeat, 0 for a constant rate
+ *   [6] SET_REPORT only: APP_SETTINGS_SAVE, as for the settings page
+ * A SET_REPORT with any field out of range is ignored. */
+#define APP_SETTINGS_TYPEMATIC_ON   0x01
+
+/* Chord page of the vendor feature report (APP_FEATURE_PAGE_CHORD), see
+ * app_chord.h:
+ *   [1] chord window in ms, 0 (chords off)-255
+ *   [2] SET_REPORT only: APP_SETTINGS_SAVE, as for the settings page
+ *   [3] GET_REPORT only: longest time in ms a press has been held back
+ *       to see if it is part of a chord, up to 255; cleared with the
+ *       statistics on the status page */
+
+/*********************************************************************
+* Function: void APP_SettingsLoad(void);
+*
+* Overview: Loads the settings stored in High-Endurance Flash, or the
+*           defaults if none have been stored, and applies them.
+*
+* PreCondition: Buttons enabled, tick not started yet.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsLoad(void);
+
+/*********************************************************************
+* Function: void APP_SettingsTasks(void);
+*
+* Overview: Writes the settings to High-Endurance Flash when a save was
+*           requested.  The write stalls the CPU for a few milliseconds,
+*           so it is done here in the main loop.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsTasks(void);
+
+/*********************************************************************
+* Function: void APP_SettingsGetReport(uint8_t *report);
+*
+* Overview: Fills in the settings page of the feature report.
+*
+* PreCondition: None
+*
+* Input: uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsGetReport(uint8_t *report);
+
+/*********************************************************************
+* Function: void APP_SettingsSetReport(const uint8_t *report);
+*
+* Overview: Applies the settings page of a feature report at once, and
+*           queues a save if requested.  Called in interrupt context from
+*           the SET_REPORT handler.
+*
+* PreCondition: None
+*
+* Input: const uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsSetReport(const uint8_t *report);
+
+/*********************************************************************
+* Function: void APP_SettingsGetTypematicReport(uint8_t *report);
+*
+* Overview: Fills in the typematic page of the feature report.
+*
+* PreCondition: None
+*
+* Input: uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsGetTypematicReport(uint8_t *report);
+
+/*********************************************************************
+* Function: void APP_SettingsSetTypematicReport(const uint8_t *report);
+*
+* Overview: Applies the typematic page of a feature report at once, and
+*           queues a save if requested.  Called in interrupt context from
+*           the SET_REPORT handler.
+*
+* PreCondition: None
+*
+* Input: const uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsSetTypematicReport(const uint8_t *report);
+
+/*********************************************************************
+* Function: void APP_SettingsGetChordReport(uint8_t *report);
+*
+* Overview: Fills in the settings of the chord page of the feature
+*           report.
+*
+* PreCondition: None
+*
+* Input: uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsGetChordReport(uint8_t *report);
+
+/*********************************************************************
+* Function: void APP_SettingsSetChordReport(const uint8_t *report);
+*
+* Overview: Applies the chord page of a feature report at once, and
+*           queues a save if requested.  Called in interrupt context from
+*           the SET_REPORT handler.
+*
+* PreCondition: None
+*
+* Input: const uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_SettingsSetChordReport(const uint8_t *report);
+
+#endif
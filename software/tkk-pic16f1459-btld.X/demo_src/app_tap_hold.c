@@ -0,0 +1,336 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system.h"
+#include "tick.h"
+#include "app_keymap.h"
+#include "app_tap_hold.h"
+
+/* What a dual-role key is doing. */
+typedef enum
+{
+    TAP_HOLD_IDLE,
+    TAP_HOLD_PRESSED,       // down, tap or hold not decided yet
+    TAP_HOLD_HELD,          // hold action down
+    TAP_HOLD_TAPPED,        // released, waiting for a double tap
+    TAP_HOLD_DOUBLE_TAPPED  // double tap action down
+} TAP_HOLD_STATE;
+
+typedef struct
+{
+    TAP_HOLD_STATE state;
+    uint8_t key;
+    uint16_t start;         // time of the press or, once tapped, the release
+} TAP_HOLD;
+
+static TAP_HOLD tapHolds[KEYMAP_TAP_HOLDS];
+
+/* Decision windows, see APP_TapHoldSetWindows(). */
+static volatile uint8_t windowHold = APP_TAP_HOLD_WINDOW_DEFAULT;
+static volatile uint8_t windowDoubleTap = APP_TAP_HOLD_DOUBLE_TAP_WINDOW_DEFAULT;
+
+/* Decided actions not taken yet.  Every dual-role key queues at most two
+ * at once before they are taken. */
+#define TAP_HOLD_QUEUE_SIZE     (2 * KEYMAP_TAP_HOLDS)
+
+static KEYMAP_ACTION queueAction[TAP_HOLD_QUEUE_SIZE];
+static bool queueDown[TAP_HOLD_QUEUE_SIZE];
+static uint8_t queueHead;
+static uint8_t queueCount;
+
+static void APP_TapHoldQueue(KEYMAP_ACTION action, bool down)
+{
+    uint8_t tail;
+
+    // no action does nothing, and dual-role keys cannot nest
+    if((action == KEYMAP_NONE) ||
+       (KEYMAP_ACTION_KIND(action) == KEYMAP_KIND_TAP_HOLD) ||
+       (queueCount == TAP_HOLD_QUEUE_SIZE))
+    {
+        return;
+    }
+
+    tail = (queueHead + queueCount) % TAP_HOLD_QUEUE_SIZE;
+    queueAction[tail] = action;
+    queueDown[tail] = down;
+    queueCount++;
+}
+
+static void APP_TapHoldTap(uint8_t tapHold)
+{
+    KEYMAP_ACTION tap;
+
+    tap = APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_TAP);
+    APP_TapHoldQueue(tap, true);
+    APP_TapHoldQueue(tap, false);
+    tapHolds[tapHold].state = TAP_HOLD_IDLE;
+}
+
+static void APP_TapHoldHold(uint8_t tapHold)
+{
+    APP_TapHoldQueue(APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_HOLD), true);
+    tapHolds[tapHold].state = TAP_HOLD_HELD;
+}
+
+/*********************************************************************
+* Function: void APP_TapHoldSetWindows(uint8_t holdWindow,
+*                                      uint8_t doubleTapWindow);
+*
+* Overview: Sets the decision windows.  May be called in interrupt
+*           context.
+*
+* PreCondition: None
+*
+* Input: uint8_t holdWindow - time a key must be held to be held, 1-255
+*        uint8_t doubleTapWindow - time after a tap a second press is a
+*                                  double tap, 0 to turn double taps off
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldSetWindows(uint8_t holdWindow, uint8_t doubleTapWindow)
+{
+    windowHold = holdWindow;
+    windowDoubleTap = doubleTapWindow;
+}
+
+/*********************************************************************
+* Function: void APP_TapHoldReset(void);
+*
+* Overview: Forgets every dual-role key and every action not yet taken.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldReset(void)
+{
+    uint8_t tapHold;
+
+    for(tapHold = 0; tapHold < KEYMAP_TAP_HOLDS; tapHold++)
+    {
+        tapHolds[tapHold].state = TAP_HOLD_IDLE;
+    }
+    queueHead = 0;
+    queueCount = 0;
+}
+
+/*********************************************************************
+* Function: void APP_TapHoldPress(uint8_t tapHold, uint8_t key);
+*
+* Overview: Starts deciding what the press of a dual-role key is, or
+*           queues its double tap action.
+*
+* PreCondition: None
+*
+* Input: uint8_t tapHold - argument of the KEYMAP_TAP_HOLD() action
+*        uint8_t key - key number of the key pressed
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldPress(uint8_t tapHold, uint8_t key)
+{
+    TAP_HOLD *th;
+
+    if(tapHold >= KEYMAP_TAP_HOLDS)
+    {
+        return;
+    }
+    th = &tapHolds[tapHold];
+
+    if(th->state == TAP_HOLD_TAPPED)
+    {
+        APP_TapHoldQueue(APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_DOUBLE_TAP), true);
+        th->state = TAP_HOLD_DOUBLE_TAPPED;
+        return;
+    }
+
+    th->state = TAP_HOLD_PRESSED;
+    th->key = key;
+    th->start = TICK_Get();
+}
+
+/*********************************************************************
+* Function: void APP_TapHoldRelease(uint8_t tapHold);
+*
+* Overview: Queues the actions decided by the release of a dual-role
+*           key.
+*
+* PreCondition: None
+*
+* Input: uint8_t tapHold - argument of the KEYMAP_TAP_HOLD() action
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldRelease(uint8_t tapHold)
+{
+    TAP_HOLD *th;
+
+    if(tapHold >= KEYMAP_TAP_HOLDS)
+    {
+        return;
+    }
+    th = &tapHolds[tapHold];
+
+    switch(th->state)
+    {
+        case TAP_HOLD_PRESSED:
+            // without a double tap there is nothing to wait for
+            if((windowDoubleTap == 0) ||
+               (APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_DOUBLE_TAP) == KEYMAP_NONE))
+            {
+                APP_TapHoldTap(tapHold);
+            }
+            else
+            {
+                th->state = TAP_HOLD_TAPPED;
+                th->start = TICK_Get();
+            }
+            break;
+
+        case TAP_HOLD_HELD:
+            APP_TapHoldQueue(APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_HOLD), false);
+            th->state = TAP_HOLD_IDLE;
+            break;
+
+        case TAP_HOLD_DOUBLE_TAPPED:
+            APP_TapHoldQueue(APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_DOUBLE_TAP), false);
+            th->state = TAP_HOLD_IDLE;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*********************************************************************
+* Function: bool APP_TapHoldInterrupt(uint8_t key);
+*
+* Overview: Decides every other dual-role key still undecided when a key
+*           is pressed: one that is down is held, one waiting for a
+*           double tap was tapped.  The press must be acted on only after
+*           the actions queued here, so they come first in the reports.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number of the key pressed
+*
+* Output: true if actions were queued
+*
+********************************************************************/
+bool APP_TapHoldInterrupt(uint8_t key)
+{
+    uint8_t tapHold;
+    uint8_t count;
+
+    count = queueCount;
+    for(tapHold = 0; tapHold < KEYMAP_TAP_HOLDS; tapHold++)
+    {
+        if(tapHolds[tapHold].key == key)
+        {
+            continue;
+        }
+
+        // a key without a hold action can only be a tap
+        if((tapHolds[tapHold].state == TAP_HOLD_PRESSED) &&
+           (APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_HOLD) != KEYMAP_NONE))
+        {
+            APP_TapHoldHold(tapHold);
+        }
+        else if(tapHolds[tapHold].state == TAP_HOLD_TAPPED)
+        {
+            APP_TapHoldTap(tapHold);
+        }
+    }
+
+    return (queueCount != count);
+}
+
+/*********************************************************************
+* Function: void APP_TapHoldTasks(void);
+*
+* Overview: Decides the dual-role keys whose windows have passed.  Call
+*           from the main loop.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldTasks(void)
+{
+    uint8_t tapHold;
+    uint16_t elapsed;
+    TAP_HOLD *th;
+
+    for(tapHold = 0; tapHold < KEYMAP_TAP_HOLDS; tapHold++)
+    {
+        th = &tapHolds[tapHold];
+        elapsed = TICK_Get() - th->start;
+
+        if((th->state == TAP_HOLD_PRESSED) &&
+           (elapsed >= (uint16_t)windowHold * APP_TAP_HOLD_WINDOW_UNIT_MS) &&
+           (APP_KeymapGetTapHold(tapHold, KEYMAP_ROLE_HOLD) != KEYMAP_NONE))
+        {
+            APP_TapHoldHold(tapHold);
+        }
+        else if((th->state == TAP_HOLD_TAPPED) &&
+                (elapsed >= (uint16_t)windowDoubleTap * APP_TAP_HOLD_WINDOW_UNIT_MS))
+        {
+            APP_TapHoldTap(tapHold);
+        }
+    }
+}
+
+/*********************************************************************
+* Function: bool APP_TapHoldGetAction(KEYMAP_ACTION *action, bool *down);
+*
+* Overview: Takes the oldest action decided by the dual-role keys.
+*
+* PreCondition: None
+*
+* Input: KEYMAP_ACTION *action - receives the action
+*        bool *down - receives true for a press, false for a release
+*
+* Output: false if there is none
+*
+********************************************************************/
+bool APP_TapHoldGetAction(KEYMAP_ACTION *action, bool *down)
+{
+    if(queueCount == 0)
+    {
+        return false;
+    }
+
+    *action = queueAction[queueHead];
+    *down = queueDown[queueHead];
+    queueHead = (queueHead + 1) % TAP_HOLD_QUEUE_SIZE;
+    queueCount--;
+    return true;
+}
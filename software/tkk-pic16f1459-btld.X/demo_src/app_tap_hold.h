@@ -0,0 +1,149 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef APP_TAP_HOLD_H
+#define APP_TAP_HOLD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_keymap.h"
+
+/* Dual-role keys (KEYMAP_TAP_HOLD) sit between the key events and the
+ * report: a key pressed and released within the hold window is a tap; a
+ * key held past it, or still down when another key is pressed, is held.
+ * A key with a double tap action waits up to the double tap window after
+ * a tap for a second press.  A tap sends its press and release in two
+ * reports, one after the other, once it is decided.
+ *
+ * The windows are in units of APP_TAP_HOLD_WINDOW_UNIT_MS. */
+#define APP_TAP_HOLD_WINDOW_UNIT_MS             10
+#define APP_TAP_HOLD_WINDOW_DEFAULT             20
+#define APP_TAP_HOLD_DOUBLE_TAP_WINDOW_DEFAULT  20
+
+/*********************************************************************
+* Function: void APP_TapHoldSetWindows(uint8_t holdWindow,
+*                                      uint8_t doubleTapWindow);
+*
+* Overview: Sets the decision windows.  May be called in interrupt
+*           context.
+*
+* PreCondition: None
+*
+* Input: uint8_t holdWindow - time a key must be held to be held, 1-255
+*        uint8_t doubleTapWindow - time after a tap a second press is a
+*                                  double tap, 0 to turn double taps off
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldSetWindows(uint8_t holdWindow, uint8_t doubleTapWindow);
+
+/*********************************************************************
+* Function: void APP_TapHoldReset(void);
+*
+* Overview: Forgets every dual-role key and every action not yet taken.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldReset(void);
+
+/*********************************************************************
+* Function: void APP_TapHoldPress(uint8_t tapHold, uint8_t key);
+*
+* Overview: Starts deciding what the press of a dual-role key is, or
+*           queues its double tap action.
+*
+* PreCondition: None
+*
+* Input: uint8_t tapHold - argument of the KEYMAP_TAP_HOLD() action
+*        uint8_t key - key number of the key pressed
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldPress(uint8_t tapHold, uint8_t key);
+
+/*********************************************************************
+* Function: void APP_TapHoldRelease(uint8_t tapHold);
+*
+* Overview: Queues the actions decided by the release of a dual-role
+*           key.
+*
+* PreCondition: None
+*
+* Input: uint8_t tapHold - argument of the KEYMAP_TAP_HOLD() action
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldRelease(uint8_t tapHold);
+
+/*********************************************************************
+* Function: bool APP_TapHoldInterrupt(uint8_t key);
+*
+* Overview: Decides every other dual-role key still undecided when a key
+*           is pressed: one that is down is held, one waiting for a
+*           double tap was tapped.  The press must be acted on only after
+*           the actions queued here, so they come first in the reports.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number of the key pressed
+*
+* Output: true if actions were queued
+*
+********************************************************************/
+bool APP_TapHoldInterrupt(uint8_t key);
+
+/*********************************************************************
+* Function: void APP_TapHoldTasks(void);
+*
+* Overview: Decides the dual-role keys whose windows have passed.  Call
+*           from the main loop.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_TapHoldTasks(void);
+
+/*********************************************************************
+* Function: bool APP_TapHoldGetAction(KEYMAP_ACTION *action, bool *down);
+*
+* Overview: Takes the oldest action decided by the dual-role keys.
+*
+* PreCondition: None
+*
+* Input: KEYMAP_ACTION *action - receives the action
+*        bool *down - receives true for a press, false for a release
+*
+* Output: false if there is none
+*
+********************************************************************/
+bool APP_TapHoldGetAction(KEYMAP_ACTION *action, bool *down);
+
+#endif //APP_TAP_HOLD_H
@@ -0,0 +1,125 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef APP_TYPEMATIC_H
+#define APP_TYPEMATIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Typematic repeat of KEYMAP_REPEAT keys on the device, for hosts that
+ * set the keyboard idle rate to 0 and repeat keys slowly or not at all.
+ * The last such key pressed repeats, as a release and a press in two
+ * reports, until it is released or another key is pressed.  The interval
+ * between repeats starts at the first interval and shrinks by the
+ * acceleration with each repeat down to the shortest interval. */
+#define APP_TYPEMATIC_DELAY_UNIT_MS         10
+#define APP_TYPEMATIC_DELAY_DEFAULT         50
+#define APP_TYPEMATIC_INTERVAL_DEFAULT      100
+#define APP_TYPEMATIC_MIN_INTERVAL_DEFAULT  33
+#define APP_TYPEMATIC_ACCELERATION_DEFAULT  4
+
+/*********************************************************************
+* Function: void APP_TypematicSetTiming(bool on, uint8_t delay,
+*                                       uint8_t interval,
+*                                       uint8_t minInterval,
+*                                       uint8_t acceleration);
+*
+* Overview: Turns the repeat on or off and sets its timing.  May be
+*           called in interrupt context.
+*
+* PreCondition: None
+*
+* Input: bool on - false to never repeat
+*        uint8_t delay - time from the press to the first repeat, in
+*                        units of APP_TYPEMATIC_DELAY_UNIT_MS, 1-255
+*        uint8_t interval - ms between the first repeats, 1-255
+*        uint8_t minInterval - shortest ms between repeats, 1-interval
+*        uint8_t acceleration - ms taken off the interval by each repeat
+*
+* Output: None
+*
+********************************************************************/
+void APP_TypematicSetTiming(bool on, uint8_t delay, uint8_t interval,
+                            uint8_t minInterval, uint8_t acceleration);
+
+/*********************************************************************
+* Function: void APP_TypematicPress(uint8_t usage);
+*
+* Overview: Starts the repeat of a key that was pressed, in place of any
+*           key repeating.
+*
+* PreCondition: Any repeat stopped with APP_TypematicStop()
+*
+* Input: uint8_t usage - keyboard page usage of the key
+*
+* Output: None
+*
+********************************************************************/
+void APP_TypematicPress(uint8_t usage);
+
+/*********************************************************************
+* Function: void APP_TypematicRelease(uint8_t usage);
+*
+* Overview: Stops the repeat if the key released is the one repeating.
+*
+* PreCondition: None
+*
+* Input: uint8_t usage - keyboard page usage of the key
+*
+* Output: None
+*
+********************************************************************/
+void APP_TypematicRelease(uint8_t usage);
+
+/*********************************************************************
+* Function: uint8_t APP_TypematicStop(void);
+*
+* Overview: Stops any repeat.  A repeat stopped between its release and
+*           its press has left its key released in the report; the
+*           caller presses it again.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: usage of the key to press again, 0 for none
+*
+********************************************************************/
+uint8_t APP_TypematicStop(void);
+
+/*********************************************************************
+* Function: bool APP_TypematicGetStep(uint8_t *usage, bool *down);
+*
+* Overview: Takes the next change to report for the repeating key, once
+*           it is due.  Call for each report that could be sent.  The
+*           press owed for a release already sent is given even if
+*           typematic has been turned off since.
+*
+* PreCondition: None
+*
+* Input: uint8_t *usage - receives the usage of the repeating key
+*        bool *down - receives false for the release, true for the press
+*
+* Output: false if no change is due
+*
+********************************************************************/
+bool APP_TypematicGetStep(uint8_t *usage, bool *down);
+
+#endif //APP_TYPEMATIC_H
@@ -34,8 +34,8 @@ please contact mla_licensing@microchip.com
 								// that use EP0 IN or OUT for sending large amounts of
 								// application related data.
 									
-#define USB_MAX_NUM_INT     	1   //Set this number to match the maximum interface number used in the descriptors for this firmware project
-#define USB_MAX_EP_NUMBER	    1   //Set this number to match the maximum endpoint number used in the descriptors for this firmware project
+#define USB_MAX_NUM_INT     	3   //Set this number to match the number of interfaces (0-2) used in the descriptors for this firmware project
+#define USB_MAX_EP_NUMBER	    3   //Set this number to match the maximum endpoint number used in the descriptors for this firmware project
 
 //------------------------------------------------------------------------------
 //Select an endpoint ping-pong bufferring mode.  Some microcontrollers only
@@ -150,19 +150,37 @@ please contact mla_licensing@microchip.com
 
 /** DEVICE CLASS USAGE *********************************************/
 #define USB_USE_HID
+#define USB_USE_CDC
 
 /** ENDPOINTS ALLOCATION *******************************************/
 
 /* HID */
 #define HID_INTF_ID             0x00
 #define HID_EP 					1
-#define HID_INT_OUT_EP_SIZE     1
-#define HID_INT_IN_EP_SIZE      8
+#define HID_INT_OUT_EP_SIZE     2
+#define HID_INT_IN_EP_SIZE      16
 #define HID_NUM_OF_DSC          1
-#define HID_RPT01_SIZE          63
-//#define USER_GET_REPORT_HANDLER USBHIDCBGetReportHandler	
+#define HID_RPT01_SIZE          134
+#define USER_GET_REPORT_HANDLER USBHIDCBGetReportHandler	
 #define USER_SET_REPORT_HANDLER USBHIDCBSetReportHandler	
 #define USB_DEVICE_HID_IDLE_RATE_CALLBACK(reportID, newIdleRate)    USBHIDCBSetIdleRateHandler(reportID, newIdleRate)
+#define USB_DEVICE_HID_GET_IDLE_RATE_CALLBACK(reportID)             USBHIDCBGetIdleRateHandler(reportID)
+
+/* CDC control port, an interface association of interfaces 1 and 2.  The
+ * endpoint buffers fill the USB RAM left by the BDT and the HID buffers,
+ * see fixed_address_memory.h. */
+#define CDC_COMM_INTF_ID        0x01
+#define CDC_COMM_EP             2
+#define CDC_COMM_IN_EP_SIZE     10
+#define CDC_DATA_INTF_ID        0x02
+#define CDC_DATA_EP             3
+#define CDC_DATA_OUT_EP_SIZE    64
+#define CDC_DATA_IN_EP_SIZE     64
+#define USB_CDC_SUPPORT_ABSTRACT_CONTROL_MANAGEMENT_CAPABILITIES_D1 //Set_Line_Coding, Set_Control_Line_State, Get_Line_Coding, and Serial_State commands
+
+/* Time the windows the CDC driver masks the USB interrupt for, on Timer1.
+ * The longest one is on the main loop page of the feature report. */
+#define CDC_MEASURE_MASKED_CYCLES
 
 /** DEFINITIONS ****************************************************/
 
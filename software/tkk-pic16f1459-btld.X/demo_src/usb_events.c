@@ -30,10 +30,13 @@ please contact mla_licensing@microchip.com
 
 #include "usb.h"
 #include "usb_device_hid.h"
+#include "usb_device_cdc.h"
 
 /* Demo project includes */
 #include "app_led_usb_status.h"
 #include "app_device_keyboard.h"
+#include "app_device_cdc_control.h"
+#include "tick.h"
 
 
 // *****************************************************************************
@@ -41,7 +44,6 @@ please contact mla_licensing@microchip.com
 // Section: File Scope or Global Constants
 // *****************************************************************************
 // *****************************************************************************
-volatile signed int SOFCounter = 0;
 
 /*******************************************************************
  * Function:        bool USER_USB_CALLBACK_EVENT_HANDLER(
@@ -72,18 +74,9 @@ bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size
             break;
 
         case EVENT_SOF:
-            /* We are using the SOF as a timer to time the LED indicator.  Call
-             * the LED update function here. */
-            APP_LEDUpdateUSBStatus();
-            BUTTON_UpdateStates ();
-            if(SOFCounter < 32767)
-            {
-                SOFCounter++;
-            }
-            else
-            {
-                SOFCounter = 0;
-            }
+            /* The LED indicator and the buttons run from the Timer2 scan
+             * tick; the SOF only keeps the tick in phase with the frames. */
+            TICK_Synchronize();
             break;
 
         case EVENT_SUSPEND:
@@ -112,23 +105,28 @@ bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size
 
         case EVENT_CONFIGURED:
             /* When the device is configured, we can (re)initialize the keyboard
-             * demo code. */
+             * demo code and the control port. */
             APP_KeyboardInit();
+            CDCInitEP();
+            APP_DeviceCDCControlInitialize();
             break;
 
         case EVENT_SET_DESCRIPTOR:
             break;
 
         case EVENT_EP0_REQUEST:
-            /* We have received a non-standard USB request.  The HID driver
-             * needs to check to see if the request was for it. */
+            /* We have received a non-standard USB request.  The HID and CDC
+             * drivers need to check to see if the request was for them. */
             USBCheckHIDRequest();
+            USBCheckCDCRequest();
             break;
 
         case EVENT_BUS_ERROR:
             break;
 
         case EVENT_TRANSFER_TERMINATED:
+            /* Let the CDC driver re-arm its data endpoint after a halt. */
+            USBCDCEventHandler(event, pdata, size);
             break;
 
         default:
@@ -20,9 +20,22 @@ please contact mla_licensing@microchip.com
 #ifndef FIXED_MEMORY_ADDRESS_H
 #define FIXED_MEMORY_ADDRESS_H
 
+/* The @ address qualifier is XC8 only.  Other compilers (an off-target
+ * build of the application code) get the buffers wherever they land. */
+#if defined(__XC8)
 #define FIXED_ADDRESS_MEMORY
 
+/* Endpoint buffers live in the USB RAM, banks 0-6.  Bank 0 holds the BDT
+ * and the endpoint 0 buffers, bank 1 the HID reports and banks 2 to 5
+ * one CDC data buffer each, both ping-pong halves in each direction.
+ * The CDC driver does not use its control buffer. */
 #define KEYBOARD_INPUT_REPORT_DATA_BUFFER_ADDRESS_TAG  @0x0A0
-#define KEYBOARD_OUTPUT_REPORT_DATA_BUFFER_ADDRESS_TAG  @0x120
+#define KEYBOARD_OUTPUT_REPORT_DATA_BUFFER_ADDRESS_TAG  @0x0C0
+#define OUT_DATA_BUFFER_ADDRESS_TAG     @0x120
+#define IN_DATA_BUFFER_ADDRESS_TAG      @0x1A0
+#define OUT_DATA_ODD_BUFFER_ADDRESS_TAG @0x220
+#define IN_DATA_ODD_BUFFER_ADDRESS_TAG  @0x2A0
+#define CONTROL_BUFFER_ADDRESS_TAG      @0x320
+#endif
 
 #endif //FIXED_MEMORY_ADDRESS
\ No newline at end of file
@@ -22,10 +22,13 @@ please contact mla_licensing@microchip.com
 #define LED_USB_DEVICE_STATE                            LED_D1
 #define LED_USB_DEVICE_HID_KEYBOARD_CAPS_LOCK           LED_D2
 
-#define BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_0            BUTTON_S1
-#define BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_1            BUTTON_S2
-#define BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_2            BUTTON_S3
+/* The keys and their usages are in the keymap, see app_keymap.c. */
+#if defined(MATRIX_SCAN_ENABLE)
+#define BUTTON_USB_DEVICE_REMOTE_WAKEUP                 BUTTON_R0C0
+#else
 #define BUTTON_USB_DEVICE_REMOTE_WAKEUP                 BUTTON_S1
+#endif
+#define BUTTON_USB_DEVICE_HID_KEYBOARD_DEBOUNCE         BUTTON_DEBOUNCE_EAGER
 
 /* USB Stack I/O options. */
 #define self_power                                      1
@@ -21,6 +21,10 @@ please contact mla_licensing@microchip.com
 #include "usb.h"
 #include "usb_device.h"
 #include "leds.h"
+#include "tick.h"
+#include "app_led_usb_status.h"
+#include "app_settings.h"
+#include "app_keymap.h"
 
 /** CONFIGURATION Bits **********************************************/
 // PIC16F1459 configuration bit settings:
@@ -94,9 +98,17 @@ void SYSTEM_Initialize( SYSTEM_STATE state )
             #endif
             LED_Enable(LED_USB_DEVICE_STATE);
             LED_Enable(LED_USB_DEVICE_HID_KEYBOARD_CAPS_LOCK);
-            BUTTON_Enable(BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_0);
-            BUTTON_Enable(BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_1);
-            BUTTON_Enable(BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_2);
+            {
+                uint8_t key;
+
+                for(key = 0; key < APP_KeymapGetKeyCount(); key++)
+                {
+                    BUTTON_Enable(APP_KeymapGetButton(key));
+                }
+            }
+            BUTTON_Enable(BUTTON_USB_DEVICE_REMOTE_WAKEUP);
+            APP_SettingsLoad();
+            TICK_Initialize();
             break;
 			
         case SYSTEM_STATE_USB_SUSPEND: 
@@ -111,7 +123,32 @@ void SYSTEM_Initialize( SYSTEM_STATE state )
 			
 void interrupt SYS_InterruptHigh(void)
 {
+    if(INTCONbits.IOCIE && INTCONbits.IOCIF)
+    {
+        BUTTON_InterruptHandler();
+    }
+
+    //The scan tick keeps running while the bus is suspended, so a key
+    //press can still be seen and used to wake the host.
+    if(PIE1bits.TMR2IE && PIR1bits.TMR2IF)
+    {
+        if(TICK_InterruptHandler() == true)
+        {
+            APP_LEDUpdateUSBStatus();
+        }
+
+        #if defined(MATRIX_SCAN_ENABLE)
+        MATRIX_ScanRow();
+        #endif
+        BUTTON_UpdateStates();
+    }
+
+    //The CDC driver masks the USB interrupt around its buffer handoffs;
+    //the other sources still come in then, and must leave USB alone.
     #if defined(USB_INTERRUPT)
-        USBDeviceTasks();
+        if(PIE2bits.USBIE && PIR2bits.USBIF)
+        {
+            USBDeviceTasks();
+        }
     #endif
 }
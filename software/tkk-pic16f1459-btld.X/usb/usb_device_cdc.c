@@ -0,0 +1,1545 @@
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright 2015 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+//DOM-IGNORE-END
+
+/********************************************************************
+ Change History:
+  Rev    Description
+  ----   -----------
+  2.3    Deprecated the mUSBUSARTIsTxTrfReady() macro.  It is 
+         replaced by the USBUSARTIsTxTrfReady() function.
+
+  2.6    Minor definition changes
+
+  2.6a   No Changes
+
+  2.7    Fixed error in the part support list of the variables section
+         where the address of the CDC variables are defined.  The 
+         PIC18F2553 was incorrectly named PIC18F2453 and the PIC18F4558
+         was incorrectly named PIC18F4458.
+
+         http://www.microchip.com/forums/fb.aspx?m=487397
+
+  2.8    Minor change to CDCInitEP() to enhance ruggedness in
+         multi0-threaded usage scenarios.
+  
+  2.9b   Updated to implement optional support for DTS reporting.
+
+********************************************************************/
+
+/** I N C L U D E S **********************************************************/
+#include "system.h"
+#include "usb.h"
+#include "usb_device_cdc.h"
+
+#ifdef USB_USE_CDC
+
+/* With ping-pong buffering on the data endpoint both OUT buffer descriptors
+ * are kept armed, each with its own buffer, so the host can send the next
+ * packet while the application is still working on the last one.  The same
+ * goes for IN: one packet can be filled while the other is being sent. */
+#if (USB_PING_PONG_MODE == USB_PING_PONG__FULL_PING_PONG) || (USB_PING_PONG_MODE == USB_PING_PONG__ALL_BUT_EP0)
+    #define CDC_DATA_OUT_BUFFERS 2
+    #define CDC_DATA_IN_BUFFERS 2
+#else
+    #define CDC_DATA_OUT_BUFFERS 1
+    #define CDC_DATA_IN_BUFFERS 1
+#endif
+
+#ifndef FIXED_ADDRESS_MEMORY
+    #define IN_DATA_BUFFER_ADDRESS_TAG
+    #define IN_DATA_ODD_BUFFER_ADDRESS_TAG
+    #define OUT_DATA_BUFFER_ADDRESS_TAG
+    #define OUT_DATA_ODD_BUFFER_ADDRESS_TAG
+    #define CONTROL_BUFFER_ADDRESS_TAG
+#endif
+
+#if !defined(IN_DATA_BUFFER_ADDRESS_TAG) || !defined(OUT_DATA_BUFFER_ADDRESS_TAG) || !defined(CONTROL_BUFFER_ADDRESS_TAG)
+    #error "One of the fixed memory address definitions is not defined.  Please define the required address tags for the required buffers."
+#endif
+
+#if defined(CDC_TX_FIFO_SIZE) && (CDC_TX_FIFO_SIZE > 128)
+    #error "CDC_TX_FIFO_SIZE must not be larger than 128."
+#endif
+
+#if (CDC_DATA_OUT_BUFFERS == 2) && !defined(OUT_DATA_ODD_BUFFER_ADDRESS_TAG)
+    #error "Ping-pong buffering needs a second OUT buffer.  Please define OUT_DATA_ODD_BUFFER_ADDRESS_TAG."
+#endif
+
+#if (CDC_DATA_IN_BUFFERS == 2) && !defined(IN_DATA_ODD_BUFFER_ADDRESS_TAG)
+    #error "Ping-pong buffering needs a second IN buffer.  Please define IN_DATA_ODD_BUFFER_ADDRESS_TAG."
+#endif
+
+/* OUT buffers are re-armed on their own buffer descriptor, the same way
+ * USBTransferOnePacket() arms one. */
+#if defined(USB_DEVICE_DISABLE_DTS_CHECKING)
+    #define CDC_DTS_CHECKING_ENABLED 0
+#else
+    #define CDC_DTS_CHECKING_ENABLED _DTSEN
+#endif
+
+/** V A R I A B L E S ********************************************************/
+volatile unsigned char cdc_data_tx[CDC_DATA_IN_EP_SIZE] IN_DATA_BUFFER_ADDRESS_TAG;
+#if (CDC_DATA_IN_BUFFERS == 2)
+volatile unsigned char cdc_data_tx_odd[CDC_DATA_IN_EP_SIZE] IN_DATA_ODD_BUFFER_ADDRESS_TAG;
+#endif
+volatile unsigned char cdc_data_rx[CDC_DATA_OUT_EP_SIZE] OUT_DATA_BUFFER_ADDRESS_TAG;
+#if (CDC_DATA_OUT_BUFFERS == 2)
+volatile unsigned char cdc_data_rx_odd[CDC_DATA_OUT_EP_SIZE] OUT_DATA_ODD_BUFFER_ADDRESS_TAG;
+#endif
+
+// IN buffers in the order they are filled and sent
+static volatile unsigned char * const cdc_tx_buffer[CDC_DATA_IN_BUFFERS] =
+{
+    cdc_data_tx,
+#if (CDC_DATA_IN_BUFFERS == 2)
+    cdc_data_tx_odd,
+#endif
+};
+
+// OUT buffers in the order they are armed and handed out
+static volatile unsigned char * const cdc_rx_buffer[CDC_DATA_OUT_BUFFERS] =
+{
+    cdc_data_rx,
+#if (CDC_DATA_OUT_BUFFERS == 2)
+    cdc_data_rx_odd,
+#endif
+};
+
+typedef union
+{
+    LINE_CODING lineCoding;
+    CDC_NOTICE cdcNotice;
+} CONTROL_BUFFER;
+
+//static CONTROL_BUFFER controlBuffer CONTROL_BUFFER_ADDRESS_TAG;
+
+LINE_CODING line_coding;    // Buffer to store line coding information
+CDC_NOTICE cdc_notice;
+
+#if defined(USB_CDC_SUPPORT_DSR_REPORTING)
+    SERIAL_STATE_NOTIFICATION SerialStatePacket;
+#endif
+
+uint8_t cdc_rx_len;            // total rx length
+uint8_t cdc_rx_next;           // OUT buffer handed out next
+uint8_t cdc_rx_rearm;          // OUT buffers whose transfer was terminated
+bool cdc_rx_borrowed;          // OUT buffer cdc_rx_next is out on loan
+uint8_t cdc_trf_state;         // States are defined cdc.h
+POINTER pCDCSrc;            // Dedicated source pointer
+POINTER pCDCDst;            // Dedicated destination pointer
+uint8_t cdc_tx_len;            // total tx length
+uint8_t cdc_tx_next;           // IN buffer filled next
+uint8_t cdc_mem_type;          // _ROM, _RAM
+
+USB_HANDLE CDCDataOutHandle[CDC_DATA_OUT_BUFFERS];
+static volatile BDT_ENTRY *cdc_rx_bd[CDC_DATA_OUT_BUFFERS]; // BD each OUT buffer is bound to
+USB_HANDLE CDCDataInHandle[CDC_DATA_IN_BUFFERS];
+
+#if defined(CDC_TX_FIFO_SIZE)
+    static uint8_t cdc_tx_fifo[CDC_TX_FIFO_SIZE];
+    uint8_t cdc_tx_fifo_tail;      // oldest byte in the FIFO
+    uint8_t cdc_tx_fifo_count;     // bytes in the FIFO
+    bool cdc_tx_fifo_flush;        // send a short packet on the next pass
+    bool cdc_tx_fifo_zlp;          // last packet was full, close with a ZLP
+#endif
+
+
+CONTROL_SIGNAL_BITMAP control_signal_bitmap;
+uint32_t BaudRateGen;			// BRG value calculated from baud rate
+
+/*
+ * The driver masks the USB interrupt only around handing buffers to and
+ * from the SIE and the state that goes with them.  With
+ * CDC_MEASURE_MASKED_CYCLES each of those windows is timed with Timer1,
+ * which then belongs to the driver.  The timer is stopped before the
+ * interrupt is unmasked, so its 16-bit count reads consistently.  Other
+ * interrupts stay enabled and are timed along with the window.
+ */
+#if defined(CDC_MEASURE_MASKED_CYCLES)
+    uint16_t cdc_masked_cycles;    // longest masked window so far
+
+    #define CDCMaskInterrupts()             \
+    {                                       \
+        USBMaskInterrupts();                \
+        TMR1H = 0;                          \
+        TMR1L = 0;                          \
+        T1CONbits.TMR1ON = 1;               \
+    }
+    #define CDCUnmaskInterrupts()           \
+    {                                       \
+        T1CONbits.TMR1ON = 0;               \
+        if(TMR1 > cdc_masked_cycles)        \
+            cdc_masked_cycles = TMR1;       \
+        USBUnmaskInterrupts();              \
+    }
+#else
+    #define CDCMaskInterrupts()     USBMaskInterrupts()
+    #define CDCUnmaskInterrupts()   USBUnmaskInterrupts()
+#endif
+
+#if defined(USB_CDC_SUPPORT_DSR_REPORTING)
+    BM_SERIAL_STATE SerialStateBitmap;
+    BM_SERIAL_STATE OldSerialStateBitmap;
+    USB_HANDLE CDCNotificationInHandle;
+#endif
+
+/**************************************************************************
+  SEND_ENCAPSULATED_COMMAND and GET_ENCAPSULATED_RESPONSE are required
+  requests according to the CDC specification.
+  However, it is not really being used here, therefore a dummy buffer is
+  used for conformance.
+ **************************************************************************/
+#define dummy_length    0x08
+uint8_t dummy_encapsulated_cmd_response[dummy_length];
+
+#if defined(USB_CDC_SET_LINE_CODING_HANDLER)
+CTRL_TRF_RETURN USB_CDC_SET_LINE_CODING_HANDLER(CTRL_TRF_PARAMS);
+#endif
+
+/** P R I V A T E  P R O T O T Y P E S ***************************************/
+void USBCDCSetLineCoding(void);
+
+/** D E C L A R A T I O N S **************************************************/
+//#pragma code
+
+/** C L A S S  S P E C I F I C  R E Q ****************************************/
+/******************************************************************************
+ 	Function:
+ 		void USBCheckCDCRequest(void)
+ 
+ 	Description:
+ 		This routine checks the most recently received SETUP data packet to 
+ 		see if the request is specific to the CDC class.  If the request was
+ 		a CDC specific request, this function will take care of handling the
+ 		request and responding appropriately.
+ 		
+ 	PreCondition:
+ 		This function should only be called after a control transfer SETUP
+ 		packet has arrived from the host.
+
+	Parameters:
+		None
+		
+	Return Values:
+		None
+		
+	Remarks:
+		This function does not change status or do anything if the SETUP packet
+		did not contain a CDC class specific request.		 
+  *****************************************************************************/
+void USBCheckCDCRequest(void)
+{
+    /*
+     * If request recipient is not an interface then return
+     */
+    if(SetupPkt.Recipient != USB_SETUP_RECIPIENT_INTERFACE_BITFIELD) return;
+
+    /*
+     * If request type is not class-specific then return
+     */
+    if(SetupPkt.RequestType != USB_SETUP_TYPE_CLASS_BITFIELD) return;
+
+    /*
+     * Interface ID must match interface numbers associated with
+     * CDC class, else return
+     */
+    if((SetupPkt.bIntfID != CDC_COMM_INTF_ID)&&
+       (SetupPkt.bIntfID != CDC_DATA_INTF_ID)) return;
+    
+    switch(SetupPkt.bRequest)
+    {
+        //****** These commands are required ******//
+        case SEND_ENCAPSULATED_COMMAND:
+         //send the packet
+            inPipes[0].pSrc.bRam = (uint8_t*)&dummy_encapsulated_cmd_response;
+            inPipes[0].wCount.Val = dummy_length;
+            inPipes[0].info.bits.ctrl_trf_mem = USB_EP0_RAM;
+            inPipes[0].info.bits.busy = 1;
+            break;
+        case GET_ENCAPSULATED_RESPONSE:
+            // Populate dummy_encapsulated_cmd_response first.
+            inPipes[0].pSrc.bRam = (uint8_t*)&dummy_encapsulated_cmd_response;
+            inPipes[0].info.bits.busy = 1;
+            break;
+        //****** End of required commands ******//
+
+        #if defined(USB_CDC_SUPPORT_ABSTRACT_CONTROL_MANAGEMENT_CAPABILITIES_D1)
+        case SET_LINE_CODING:
+            outPipes[0].wCount.Val = SetupPkt.wLength;
+            outPipes[0].pDst.bRam = (uint8_t*)LINE_CODING_TARGET;
+            outPipes[0].pFunc = LINE_CODING_PFUNC;
+            outPipes[0].info.bits.busy = 1;
+            break;
+            
+        case GET_LINE_CODING:
+            USBEP0SendRAMPtr(
+                (uint8_t*)&line_coding,
+                LINE_CODING_LENGTH,
+                USB_EP0_INCLUDE_ZERO);
+            break;
+
+        case SET_CONTROL_LINE_STATE:
+            control_signal_bitmap._byte = (uint8_t)SetupPkt.wValue;
+            //------------------------------------------------------------------            
+            //One way to control the RTS pin is to allow the USB host to decide the value
+            //that should be output on the RTS pin.  Although RTS and CTS pin functions
+            //are technically intended for UART hardware based flow control, some legacy
+            //UART devices use the RTS pin like a "general purpose" output pin 
+            //from the PC host.  In this usage model, the RTS pin is not related
+            //to flow control for RX/TX.
+            //In this scenario, the USB host would want to be able to control the RTS
+            //pin, and the below line of code should be uncommented.
+            //However, if the intention is to implement true RTS/CTS flow control
+            //for the RX/TX pair, then this application firmware should override
+            //the USB host's setting for RTS, and instead generate a real RTS signal,
+            //based on the amount of remaining buffer space available for the 
+            //actual hardware UART of this microcontroller.  In this case, the 
+            //below code should be left commented out, but instead RTS should be 
+            //controlled in the application firmware responsible for operating the 
+            //hardware UART of this microcontroller.
+            //---------            
+            //CONFIGURE_RTS(control_signal_bitmap.CARRIER_CONTROL);  
+            //------------------------------------------------------------------            
+            
+            #if defined(USB_CDC_SUPPORT_DTR_SIGNALING)
+                if(control_signal_bitmap.DTE_PRESENT == 1)
+                {
+                    UART_DTR = USB_CDC_DTR_ACTIVE_LEVEL;
+                }
+                else
+                {
+                    UART_DTR = (USB_CDC_DTR_ACTIVE_LEVEL ^ 1);
+                }        
+            #endif
+            inPipes[0].info.bits.busy = 1;
+            break;
+        #endif
+
+        #if defined(USB_CDC_SUPPORT_ABSTRACT_CONTROL_MANAGEMENT_CAPABILITIES_D2)
+        case SEND_BREAK:                        // Optional
+            inPipes[0].info.bits.busy = 1;
+			if (SetupPkt.wValue == 0xFFFF)  //0xFFFF means send break indefinitely until a new SEND_BREAK command is received
+			{
+				UART_Tx = 0;       // Prepare to drive TX low (for break signaling)
+				UART_TRISTx = 0;   // Make sure TX pin configured as an output
+				UART_ENABLE = 0;   // Turn off USART (to relinquish TX pin control)
+			}
+			else if (SetupPkt.wValue == 0x0000) //0x0000 means stop sending indefinite break 
+			{
+    			UART_ENABLE = 1;   // turn on USART
+				UART_TRISTx = 1;   // Make TX pin an input
+			}
+			else
+			{
+                //Send break signaling on the pin for (SetupPkt.wValue) milliseconds
+                UART_SEND_BREAK();
+			}
+            break;
+        #endif
+        default:
+            break;
+    }//end switch(SetupPkt.bRequest)
+
+}//end USBCheckCDCRequest
+
+/** U S E R  A P I ***********************************************************/
+
+/**************************************************************************
+  Function:
+        void CDCInitEP(void)
+    
+  Summary:
+    This function initializes the CDC function driver. This function should
+    be called after the SET_CONFIGURATION command (ex: within the context of
+    the USBCBInitEP() function).
+  Description:
+    This function initializes the CDC function driver. This function sets
+    the default line coding (baud rate, bit parity, number of data bits,
+    and format). This function also enables the endpoints and prepares for
+    the first transfer from the host.
+    
+    This function should be called after the SET_CONFIGURATION command.
+    This is most simply done by calling this function from the
+    USBCBInitEP() function.
+    
+    Typical Usage:
+    <code>
+        void USBCBInitEP(void)
+        {
+            CDCInitEP();
+        }
+    </code>
+  Conditions:
+    None
+  Remarks:
+    None                                                                   
+  **************************************************************************/
+void CDCInitEP(void)
+{
+    //Abstract line coding information
+    line_coding.dwDTERate   = 19200;      // baud rate
+    line_coding.bCharFormat = 0x00;             // 1 stop bit
+    line_coding.bParityType = 0x00;             // None
+    line_coding.bDataBits = 0x08;               // 5,6,7,8, or 16
+
+    cdc_rx_len = 0;
+    cdc_rx_next = 0;
+    cdc_rx_rearm = 0;
+    cdc_rx_borrowed = false;
+
+    #if defined(CDC_TX_FIFO_SIZE)
+        cdc_tx_fifo_tail = 0;
+        cdc_tx_fifo_count = 0;
+        cdc_tx_fifo_flush = false;
+        cdc_tx_fifo_zlp = false;
+    #endif
+    
+    /*
+     * Do not have to init Cnt of IN pipes here.
+     * Reason:  Number of BYTEs to send to the host
+     *          varies from one transaction to
+     *          another. Cnt should equal the exact
+     *          number of BYTEs to transmit for
+     *          a given IN transaction.
+     *          This number of BYTEs will only
+     *          be known right before the data is
+     *          sent.
+     */
+    USBEnableEndpoint(CDC_COMM_EP,USB_IN_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
+    USBEnableEndpoint(CDC_DATA_EP,USB_IN_ENABLED|USB_OUT_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
+
+    CDCDataOutHandle[0] = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
+    cdc_rx_bd[0] = (volatile BDT_ENTRY*)CDCDataOutHandle[0];
+    #if (CDC_DATA_OUT_BUFFERS == 2)
+        CDCDataOutHandle[1] = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx_odd,sizeof(cdc_data_rx_odd));
+        cdc_rx_bd[1] = (volatile BDT_ENTRY*)CDCDataOutHandle[1];
+    #endif
+    CDCDataInHandle[0] = NULL;
+    #if (CDC_DATA_IN_BUFFERS == 2)
+        CDCDataInHandle[1] = NULL;
+    #endif
+    cdc_tx_next = 0;
+
+    #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
+      	CDCNotificationInHandle = NULL;
+        mInitDTSPin();  //Configure DTS as a digital input
+      	SerialStateBitmap.byte = 0x00;
+      	OldSerialStateBitmap.byte = !SerialStateBitmap.byte;    //To force firmware to send an initial serial state packet to the host.
+        //Prepare a SerialState notification element packet (contains info like DSR state)
+        SerialStatePacket.bmRequestType = 0xA1; //Always 0xA1 for this type of packet.
+        SerialStatePacket.bNotification = SERIAL_STATE;
+        SerialStatePacket.wValue = 0x0000;  //Always 0x0000 for this type of packet
+        SerialStatePacket.wIndex = CDC_COMM_INTF_ID;  //Interface number  
+        SerialStatePacket.SerialState.byte = 0x00;
+        SerialStatePacket.Reserved = 0x00;
+        SerialStatePacket.wLength = 0x02;   //Always 2 bytes for this type of packet    
+        CDCNotificationHandler();
+  	#endif
+  	
+  	#if defined(USB_CDC_SUPPORT_DTR_SIGNALING)
+  	    mInitDTRPin();
+  	#endif
+  	
+  	#if defined(USB_CDC_SUPPORT_HARDWARE_FLOW_CONTROL)
+  	    mInitRTSPin();
+  	    mInitCTSPin();
+  	#endif
+    
+    cdc_trf_state = CDC_TX_READY;
+}//end CDCInitEP
+
+
+/**************************************************************************
+  Function: void CDCNotificationHandler(void)
+  Summary: Checks for changes in DSR status and reports them to the USB host.
+  Description: Checks for changes in DSR pin state and reports any changes
+               to the USB host. 
+  Conditions: CDCInitEP() must have been called previously, prior to calling
+              CDCNotificationHandler() for the first time.
+  Remarks:
+    This function is only implemented and needed when the 
+    USB_CDC_SUPPORT_DSR_REPORTING option has been enabled.  If the function is
+    enabled, it should be called periodically to sample the DSR pin and feed
+    the information to the USB host.  This can be done by calling 
+    CDCNotificationHandler() by itself, or, by calling CDCTxService() which
+    also calls CDCNotificationHandler() internally, when appropriate.
+  **************************************************************************/
+#if defined(USB_CDC_SUPPORT_DSR_REPORTING)
+void CDCNotificationHandler(void)
+{
+    //Check the DTS I/O pin and if a state change is detected, notify the 
+    //USB host by sending a serial state notification element packet.
+    if(UART_DTS == USB_CDC_DSR_ACTIVE_LEVEL) //UART_DTS must be defined to be an I/O pin in the hardware profile to use the DTS feature (ex: "PORTXbits.RXY")
+    {
+        SerialStateBitmap.bits.DSR = 1;
+    }  
+    else
+    {
+        SerialStateBitmap.bits.DSR = 0;
+    }        
+    
+    //If the state has changed, and the endpoint is available, send a packet to
+    //notify the hUSB host of the change.
+    if((SerialStateBitmap.byte != OldSerialStateBitmap.byte) && (!USBHandleBusy(CDCNotificationInHandle)))
+    {
+        //Copy the updated value into the USB packet buffer to send.
+        SerialStatePacket.SerialState.byte = SerialStateBitmap.byte;
+        //We don't need to write to the other bytes in the SerialStatePacket USB
+        //buffer, since they don't change and will always be the same as our
+        //initialized value.
+
+        //Send the packet over USB to the host.
+        CDCNotificationInHandle = USBTransferOnePacket(CDC_COMM_EP, IN_TO_HOST, (uint8_t*)&SerialStatePacket, sizeof(SERIAL_STATE_NOTIFICATION));
+        
+        //Save the old value, so we can detect changes later.
+        OldSerialStateBitmap.byte = SerialStateBitmap.byte;
+    }    
+}//void CDCNotificationHandler(void)    
+#else
+    #define CDCNotificationHandler() {}
+#endif
+
+
+/**********************************************************************************
+  Function:
+    bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size)
+    
+  Summary:
+    Handles events from the USB stack, which may have an effect on the CDC 
+    endpoint(s).
+
+  Description:
+    Handles events from the USB stack.  This function should be called when 
+    there is a USB event that needs to be processed by the CDC driver.
+    
+  Conditions:
+    Value of input argument 'len' should be smaller than the maximum
+    endpoint size responsible for receiving bulk data from USB host for CDC
+    class. Input argument 'buffer' should point to a buffer area that is
+    bigger or equal to the size specified by 'len'.
+  Input:
+    event - the type of event that occurred
+    pdata - pointer to the data that caused the event
+    size - the size of the data that is pointed to by pdata
+                                                                                   
+  **********************************************************************************/
+bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size)
+{
+    uint8_t i;
+
+    switch( (uint16_t)event )
+    {  
+        case EVENT_TRANSFER_TERMINATED:
+            /*
+             * A halt on the OUT endpoint terminates both ping-pong buffers,
+             * one after the other.  Re-arming here would put the first one
+             * back on a descriptor that is about to be terminated too, so
+             * just note them and let CDCRxBorrow() re-arm them in order.
+             */
+            for(i = 0; i < CDC_DATA_OUT_BUFFERS; i++)
+            {
+                if(pdata == CDCDataOutHandle[i])
+                {
+                    CDCDataOutHandle[i] = NULL;
+                    cdc_rx_rearm |= 1 << i;
+                    break;
+                }
+            }
+            for(i = 0; i < CDC_DATA_IN_BUFFERS; i++)
+            {
+                if(pdata == CDCDataInHandle[i])
+                {
+                    //flush all of the data in the CDC buffer
+                    cdc_trf_state = CDC_TX_READY;
+                    cdc_tx_len = 0;
+                }
+            }
+            break;
+        #if defined(CDC_TX_FIFO_SIZE)
+        case EVENT_SOF:
+            //send what the transmit FIFO holds once per frame
+            cdc_tx_fifo_flush = true;
+            break;
+        #endif
+        default:
+            return false;
+    }      
+    return true;
+}
+
+/**********************************************************************************
+  Function:
+        uint8_t getsUSBUSART(char *buffer, uint8_t len)
+    
+  Summary:
+    getsUSBUSART copies a string of BYTEs received through USB CDC Bulk OUT
+    endpoint to a user's specified location. It is a non-blocking function.
+    It does not wait for data if there is no data available. Instead it
+    returns '0' to notify the caller that there is no data available.
+
+  Description:
+    getsUSBUSART copies a string of BYTEs received through USB CDC Bulk OUT
+    endpoint to a user's specified location. It is a non-blocking function.
+    It does not wait for data if there is no data available. Instead it
+    returns '0' to notify the caller that there is no data available.
+    
+    Typical Usage:
+    <code>
+        uint8_t numBytes;
+        uint8_t buffer[64]
+    
+        numBytes = getsUSBUSART(buffer,sizeof(buffer)); //until the buffer is free.
+        if(numBytes \> 0)
+        {
+            //we received numBytes bytes of data and they are copied into
+            //  the "buffer" variable.  We can do something with the data
+            //  here.
+        }
+    </code>
+  Conditions:
+    Value of input argument 'len' should be smaller than the maximum
+    endpoint size responsible for receiving bulk data from USB host for CDC
+    class. Input argument 'buffer' should point to a buffer area that is
+    bigger or equal to the size specified by 'len'.
+  Input:
+    buffer -  Pointer to where received BYTEs are to be stored
+    len -     The number of BYTEs expected.
+                                                                                   
+  **********************************************************************************/
+uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len)
+{
+    uint8_t *data;
+    uint8_t count;
+
+    cdc_rx_len = 0;
+    
+    count = CDCRxBorrow(&data);
+    if(count != 0)
+    {
+        /*
+         * Adjust the expected number of BYTEs to equal
+         * the actual number of BYTEs received.
+         */
+        if(len > count)
+            len = count;
+        
+        /*
+         * Copy data from dual-ram buffer to user's buffer
+         */
+        for(cdc_rx_len = 0; cdc_rx_len < len; cdc_rx_len++)
+            buffer[cdc_rx_len] = data[cdc_rx_len];
+
+        /*
+         * Prepare dual-ram buffer for next OUT transaction
+         */
+        CDCRxRelease();
+
+    }//end if
+    
+    return cdc_rx_len;
+    
+}//end getsUSBUSART
+
+/************************************************************************
+  Function:
+        static void CDCRxArm(uint8_t i)
+    
+  Summary:
+    Hands OUT buffer 'i' back to the SIE on the buffer descriptor it was
+    bound to by CDCInitEP().
+
+  Description:
+    USBRxOnePacket() arms whichever buffer descriptor the stack's ping-pong
+    pointer is on, which is not always the one this buffer belongs to once
+    a transfer has been terminated.
+
+  Conditions:
+    Called with the USB interrupt masked.
+  ************************************************************************/
+static void CDCRxArm(uint8_t i)
+{
+    volatile BDT_ENTRY *bd;
+
+    bd = cdc_rx_bd[i];
+    bd->ADR = ConvertToPhysicalAddress(cdc_rx_buffer[i]);
+    bd->CNT = CDC_DATA_OUT_EP_SIZE;
+    #if (CDC_DATA_OUT_BUFFERS == 1)
+        bd->STAT.Val ^= _DTSMASK;
+    #endif
+    bd->STAT.Val &= _DTSMASK;
+    bd->STAT.Val |= (_DTSEN & CDC_DTS_CHECKING_ENABLED);
+    bd->STAT.Val |= _USIE;
+    CDCDataOutHandle[i] = (USB_HANDLE)bd;
+}//end CDCRxArm
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCRxBorrow(uint8_t **data)
+    
+  Summary:
+    CDCRxBorrow hands out the oldest packet received through the USB CDC Bulk
+    OUT endpoint in place, without copying it.  It is a non-blocking function.
+
+  Description:
+    CDCRxBorrow points 'data' at the dual-ram buffer holding the oldest
+    received packet and returns its length.  The buffer belongs to the
+    caller until CDCRxRelease() gives it back to the endpoint; calling
+    CDCRxBorrow() again before that returns the same packet.  With
+    ping-pong buffering the other buffer stays armed meanwhile, so the
+    host can keep sending while the caller parses.  Zero length packets
+    are released here and never handed out.
+    
+    Typical Usage:
+    <code>
+        uint8_t *data;
+        uint8_t numBytes;
+    
+        numBytes = CDCRxBorrow(&data);
+        if(numBytes \> 0)
+        {
+            //data[0] to data[numBytes - 1] hold the packet.  Use them,
+            //  then hand the buffer back.
+            CDCRxRelease();
+        }
+    </code>
+  Conditions:
+    The buffer must not be written to, and must not be used after
+    CDCRxRelease().
+  Input:
+    data -  Pointer to where the address of the received BYTEs is stored
+  Output:
+    uint8_t -    The number of BYTEs in the packet, 0 if no new CDC bulk OUT
+              endpoint data was available.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCRxBorrow(uint8_t **data)
+{
+    USB_HANDLE handle;
+    uint8_t rearm;
+    uint8_t i;
+    uint8_t len;
+
+    /*
+     * Buffers cut short by an endpoint halt go back on the endpoint, each
+     * on its own buffer descriptor.  A buffer out on loan keeps its flag
+     * until CDCRxRelease() has given it back.
+     */
+    CDCMaskInterrupts();
+    rearm = cdc_rx_rearm;
+    for(i = 0; i < CDC_DATA_OUT_BUFFERS; i++)
+    {
+        if((rearm & (1 << i)) && ((i != cdc_rx_next) || (cdc_rx_borrowed == false)))
+        {
+            CDCRxArm(i);
+            rearm &= ~(1 << i);
+        }
+    }
+    cdc_rx_rearm = rearm;
+    CDCUnmaskInterrupts();
+
+    handle = CDCDataOutHandle[cdc_rx_next];
+    if((handle == NULL) || USBHandleBusy(handle))
+    {
+        return 0;
+    }
+
+    cdc_rx_borrowed = true;
+    len = USBHandleGetLength(handle);
+    if(len == 0)
+    {
+        CDCRxRelease();
+        return 0;
+    }
+
+    *data = (uint8_t*)cdc_rx_buffer[cdc_rx_next];
+    return len;
+
+}//end CDCRxBorrow
+
+/**********************************************************************************
+  Function:
+        void CDCRxRelease(void)
+    
+  Summary:
+    CDCRxRelease gives the packet handed out by CDCRxBorrow() back to the
+    USB CDC Bulk OUT endpoint.
+
+  Description:
+    CDCRxRelease re-arms the dual-ram buffer last handed out by
+    CDCRxBorrow() for a later OUT transaction and moves on to the next
+    buffer.  It does nothing if no packet is waiting.
+    
+  Conditions:
+    None
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCRxRelease(void)
+{
+    USB_HANDLE handle;
+
+    handle = CDCDataOutHandle[cdc_rx_next];
+    if((handle == NULL) || USBHandleBusy(handle))
+    {
+        return;
+    }
+
+    CDCMaskInterrupts();
+    CDCRxArm(cdc_rx_next);
+    cdc_rx_borrowed = false;
+    if(++cdc_rx_next == CDC_DATA_OUT_BUFFERS)
+    {
+        cdc_rx_next = 0;
+    }
+    CDCUnmaskInterrupts();
+
+}//end CDCRxRelease
+
+/******************************************************************************
+  Function:
+	void putUSBUSART(char *data, uint8_t length)
+		
+  Summary:
+    putUSBUSART writes an array of data to the USB. Use this version, is
+    capable of transferring 0x00 (what is typically a NULL character in any of
+    the string transfer functions).
+
+  Description:
+    putUSBUSART writes an array of data to the USB. Use this version, is
+    capable of transferring 0x00 (what is typically a NULL character in any of
+    the string transfer functions).
+    
+    Typical Usage:
+    <code>
+        if(USBUSARTIsTxTrfReady())
+        {
+            char data[] = {0x00, 0x01, 0x02, 0x03, 0x04};
+            putUSBUSART(data,5);
+        }
+    </code>
+    
+    The transfer mechanism for device-to-host(put) is more flexible than
+    host-to-device(get). It can handle a string of data larger than the
+    maximum size of bulk IN endpoint. A state machine is used to transfer a
+    \long string of data over multiple USB transactions. CDCTxService()
+    must be called periodically to keep sending blocks of data to the host.
+
+  Conditions:
+    USBUSARTIsTxTrfReady() must return true. This indicates that the last
+    transfer is complete and is ready to receive a new block of data. The
+    string of characters pointed to by 'data' must equal to or smaller than
+    255 BYTEs.
+
+  Input:
+    char *data - pointer to a RAM array of data to be transfered to the host
+    uint8_t length - the number of bytes to be transfered (must be less than 255).
+		
+ *****************************************************************************/
+void putUSBUSART(uint8_t *data, uint8_t  length)
+{
+    /*
+     * User should have checked that cdc_trf_state is in CDC_TX_READY state
+     * before calling this function.
+     * As a safety precaution, this function checks the state one more time
+     * to make sure it does not override any pending transactions.
+     *
+     * Currently it just quits the routine without reporting any errors back
+     * to the user.
+     *
+     * Bottom line: User MUST make sure that USBUSARTIsTxTrfReady()==1
+     *             before calling this function!
+     * Example:
+     * if(USBUSARTIsTxTrfReady())
+     *     putUSBUSART(pData, Length);
+     *
+     * IMPORTANT: Never use the following blocking while loop to wait:
+     * while(!USBUSARTIsTxTrfReady())
+     *     putUSBUSART(pData, Length);
+     *
+     * The whole firmware framework is written based on cooperative
+     * multi-tasking and a blocking code is not acceptable.
+     * Use a state machine instead.
+     */
+    CDCMaskInterrupts();
+    if(cdc_trf_state == CDC_TX_READY)
+    {
+        mUSBUSARTTxRam((uint8_t*)data, length);     // See cdc.h
+    }
+    CDCUnmaskInterrupts();
+}//end putUSBUSART
+
+/******************************************************************************
+	Function:
+		void putsUSBUSART(char *data)
+		
+  Summary:
+    putsUSBUSART writes a string of data to the USB including the null
+    character. Use this version, 'puts', to transfer data from a RAM buffer.
+
+  Description:
+    putsUSBUSART writes a string of data to the USB including the null
+    character. Use this version, 'puts', to transfer data from a RAM buffer.
+    
+    Typical Usage:
+    <code>
+        if(USBUSARTIsTxTrfReady())
+        {
+            char data[] = "Hello World";
+            putsUSBUSART(data);
+        }
+    </code>
+    
+    The transfer mechanism for device-to-host(put) is more flexible than
+    host-to-device(get). It can handle a string of data larger than the
+    maximum size of bulk IN endpoint. A state machine is used to transfer a
+    \long string of data over multiple USB transactions. CDCTxService()
+    must be called periodically to keep sending blocks of data to the host.
+
+  Conditions:
+    USBUSARTIsTxTrfReady() must return true. This indicates that the last
+    transfer is complete and is ready to receive a new block of data. The
+    string of characters pointed to by 'data' must equal to or smaller than
+    255 BYTEs.
+
+  Input:
+    char *data -  null\-terminated string of constant data. If a
+                            null character is not found, 255 BYTEs of data
+                            will be transferred to the host.
+		
+ *****************************************************************************/
+ 
+void putsUSBUSART(char *data)
+{
+    uint8_t len;
+    char *pData;
+
+    /*
+     * User should have checked that cdc_trf_state is in CDC_TX_READY state
+     * before calling this function.
+     * As a safety precaution, this function checks the state one more time
+     * to make sure it does not override any pending transactions.
+     *
+     * Currently it just quits the routine without reporting any errors back
+     * to the user.
+     *
+     * Bottom line: User MUST make sure that USBUSARTIsTxTrfReady()==1
+     *             before calling this function!
+     * Example:
+     * if(USBUSARTIsTxTrfReady())
+     *     putsUSBUSART(pData, Length);
+     *
+     * IMPORTANT: Never use the following blocking while loop to wait:
+     * while(!USBUSARTIsTxTrfReady())
+     *     putsUSBUSART(pData);
+     *
+     * The whole firmware framework is written based on cooperative
+     * multi-tasking and a blocking code is not acceptable.
+     * Use a state machine instead.
+     */
+    
+    /*
+     * While loop counts the number of BYTEs to send including the
+     * null character.  Only the state check and the transfer setup
+     * below need the USB interrupt masked.
+     */
+    len = 0;
+    pData = data;
+    do
+    {
+        len++;
+        if(len == 255) break;       // Break loop once max len is reached.
+    }while(*pData++);
+    
+    CDCMaskInterrupts();
+    if(cdc_trf_state != CDC_TX_READY)
+    {
+        CDCUnmaskInterrupts();
+        return;
+    }
+
+    /*
+     * Second piece of information (length of data to send) is ready.
+     * Call mUSBUSARTTxRam to setup the transfer.
+     * The actual transfer process will be handled by CDCTxService(),
+     * which should be called once per Main Program loop.
+     */
+    mUSBUSARTTxRam((uint8_t*)data, len);     // See cdc.h
+    CDCUnmaskInterrupts();
+}//end putsUSBUSART
+
+/**************************************************************************
+  Function:
+        void putrsUSBUSART(const const char *data)
+    
+  Summary:
+    putrsUSBUSART writes a string of data to the USB including the null
+    character. Use this version, 'putrs', to transfer data literals and
+    data located in program memory.
+
+  Description:
+    putrsUSBUSART writes a string of data to the USB including the null
+    character. Use this version, 'putrs', to transfer data literals and
+    data located in program memory.
+    
+    Typical Usage:
+    <code>
+        if(USBUSARTIsTxTrfReady())
+        {
+            putrsUSBUSART("Hello World");
+        }
+    </code>
+    
+    The transfer mechanism for device-to-host(put) is more flexible than
+    host-to-device(get). It can handle a string of data larger than the
+    maximum size of bulk IN endpoint. A state machine is used to transfer a
+    \long string of data over multiple USB transactions. CDCTxService()
+    must be called periodically to keep sending blocks of data to the host.
+
+  Conditions:
+    USBUSARTIsTxTrfReady() must return true. This indicates that the last
+    transfer is complete and is ready to receive a new block of data. The
+    string of characters pointed to by 'data' must equal to or smaller than
+    255 BYTEs.
+
+  Input:
+    const const char *data -  null\-terminated string of constant data. If a
+                            null character is not found, 255 uint8_ts of data
+                            will be transferred to the host.
+                                                                           
+  **************************************************************************/
+void putrsUSBUSART(const const char *data)
+{
+    uint8_t len;
+    const const char *pData;
+
+    /*
+     * User should have checked that cdc_trf_state is in CDC_TX_READY state
+     * before calling this function.
+     * As a safety precaution, this function checks the state one more time
+     * to make sure it does not override any pending transactions.
+     *
+     * Currently it just quits the routine without reporting any errors back
+     * to the user.
+     *
+     * Bottom line: User MUST make sure that USBUSARTIsTxTrfReady()
+     *             before calling this function!
+     * Example:
+     * if(USBUSARTIsTxTrfReady())
+     *     putsUSBUSART(pData);
+     *
+     * IMPORTANT: Never use the following blocking while loop to wait:
+     * while(cdc_trf_state != CDC_TX_READY)
+     *     putsUSBUSART(pData);
+     *
+     * The whole firmware framework is written based on cooperative
+     * multi-tasking and a blocking code is not acceptable.
+     * Use a state machine instead.
+     */
+    
+    /*
+     * While loop counts the number of BYTEs to send including the
+     * null character.  Only the state check and the transfer setup
+     * below need the USB interrupt masked.
+     */
+    len = 0;
+    pData = data;
+    do
+    {
+        len++;
+        if(len == 255) break;       // Break loop once max len is reached.
+    }while(*pData++);
+    
+    CDCMaskInterrupts();
+    if(cdc_trf_state != CDC_TX_READY)
+    {
+        CDCUnmaskInterrupts();
+        return;
+    }
+
+    /*
+     * Second piece of information (length of data to send) is ready.
+     * Call mUSBUSARTTxRom to setup the transfer.
+     * The actual transfer process will be handled by CDCTxService(),
+     * which should be called once per Main Program loop.
+     */
+
+    mUSBUSARTTxRom((const uint8_t*)data,len); // See cdc.h
+    CDCUnmaskInterrupts();
+
+}//end putrsUSBUSART
+
+/************************************************************************
+  Function:
+        static void CDCTxSend(uint8_t len)
+    
+  Summary:
+    Hands the next IN buffer, holding 'len' BYTEs, to the SIE and moves
+    on to the other buffer.
+
+  Conditions:
+    Called with the USB interrupt masked.
+  ************************************************************************/
+static void CDCTxSend(uint8_t len)
+{
+    CDCDataInHandle[cdc_tx_next] = USBTxOnePacket(CDC_DATA_EP,(uint8_t*)cdc_tx_buffer[cdc_tx_next],len);
+    if(++cdc_tx_next == CDC_DATA_IN_BUFFERS)
+    {
+        cdc_tx_next = 0;
+    }
+}//end CDCTxSend
+
+#if defined(CDC_TX_FIFO_SIZE)
+/************************************************************************
+  Function:
+        static bool CDCTxFifoService(void)
+    
+  Summary:
+    Sends the next packet from the transmit FIFO, if one is due.
+
+  Conditions:
+    Called from CDCTxService() with the next IN buffer idle.  The FIFO
+    only changes in the main loop, so it is copied with the USB interrupt
+    enabled.
+  Output:
+    bool - true if a packet was queued.
+  ************************************************************************/
+static bool CDCTxFifoService(void)
+{
+    uint8_t *dst;
+    uint8_t byte_to_send;
+    uint8_t i;
+
+    /*
+     * Full packets go out as soon as they are there.  The rest waits for
+     * the next frame or CDCTxFlush(), so that small writes share packets.
+     */
+    if(cdc_tx_fifo_count >= CDC_DATA_IN_EP_SIZE)
+    {
+        byte_to_send = CDC_DATA_IN_EP_SIZE;
+    }
+    else if(cdc_tx_fifo_flush == true)
+    {
+        cdc_tx_fifo_flush = false;
+
+        /*
+         * A transfer that ended on a full packet is closed with a zero
+         * length packet. See USB Specification 2.0: Section 5.8.3
+         */
+        if((cdc_tx_fifo_count == 0) && (cdc_tx_fifo_zlp == false))
+        {
+            return false;
+        }
+        byte_to_send = cdc_tx_fifo_count;
+    }
+    else
+    {
+        return false;
+    }
+
+    dst = (uint8_t*)cdc_tx_buffer[cdc_tx_next];
+    for(i = 0; i < byte_to_send; i++)
+    {
+        dst[i] = cdc_tx_fifo[cdc_tx_fifo_tail];
+        if(++cdc_tx_fifo_tail == CDC_TX_FIFO_SIZE)
+        {
+            cdc_tx_fifo_tail = 0;
+        }
+    }
+    cdc_tx_fifo_count -= byte_to_send;
+    cdc_tx_fifo_zlp = (byte_to_send == CDC_DATA_IN_EP_SIZE);
+
+    CDCMaskInterrupts();
+    CDCTxSend(byte_to_send);
+    CDCUnmaskInterrupts();
+    return true;
+}//end CDCTxFifoService
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCTxWrite(const uint8_t *data, uint8_t length)
+    
+  Summary:
+    CDCTxWrite queues BYTEs for the USB CDC Bulk IN endpoint.  It is a
+    non-blocking function.
+
+  Description:
+    CDCTxWrite copies as much of 'data' as fits into the transmit FIFO and
+    returns how much that was.  CDCTxService() sends the FIFO in packets of
+    CDC_DATA_IN_EP_SIZE BYTEs as soon as there are that many, and whatever
+    is left over on the next start of frame or after CDCTxFlush().  Writes
+    made during the same frame therefore share packets.  A transfer that
+    ends on a full packet is closed with a zero length packet.
+    
+    Unlike putUSBUSART(), CDCTxWrite() can be called at any time, also
+    while a previous transfer is still in flight.
+
+    Typical Usage:
+    <code>
+        if(CDCTxAvailable() \>= sizeof(message))
+        {
+            CDCTxWrite(message, sizeof(message));
+        }
+    </code>
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h, and the application
+    forwards EVENT_SOF to USBCDCEventHandler().
+  Input:
+    data -    Pointer to the BYTEs to send, in RAM or program memory
+    length -  The number of BYTEs to send
+  Output:
+    uint8_t -    The number of BYTEs queued, from 0 up to length.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCTxWrite(const uint8_t *data, uint8_t length)
+{
+    uint8_t head;
+    uint8_t i;
+
+    if(length > (uint8_t)(CDC_TX_FIFO_SIZE - cdc_tx_fifo_count))
+    {
+        length = CDC_TX_FIFO_SIZE - cdc_tx_fifo_count;
+    }
+
+    head = cdc_tx_fifo_tail + cdc_tx_fifo_count;
+    if(head >= CDC_TX_FIFO_SIZE)
+    {
+        head -= CDC_TX_FIFO_SIZE;
+    }
+
+    for(i = 0; i < length; i++)
+    {
+        cdc_tx_fifo[head] = data[i];
+        if(++head == CDC_TX_FIFO_SIZE)
+        {
+            head = 0;
+        }
+    }
+    cdc_tx_fifo_count += length;
+
+    return length;
+}//end CDCTxWrite
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCTxAvailable(void)
+    
+  Summary:
+    CDCTxAvailable returns how many BYTEs CDCTxWrite() would take right now.
+
+  Description:
+    CDCTxAvailable returns the free space in the transmit FIFO.  It only
+    grows between calls as CDCTxService() sends the FIFO out.
+    
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h.
+  Input:
+    None
+  Output:
+    uint8_t -    The number of BYTEs free in the transmit FIFO.
+                                                                                   
+  **********************************************************************************/
+uint8_t CDCTxAvailable(void)
+{
+    return CDC_TX_FIFO_SIZE - cdc_tx_fifo_count;
+}//end CDCTxAvailable
+
+/**********************************************************************************
+  Function:
+        void CDCTxFlush(void)
+    
+  Summary:
+    CDCTxFlush sends what is in the transmit FIFO without waiting for the
+    next start of frame.
+
+  Description:
+    CDCTxFlush lets the next CDCTxService() send the BYTEs in the transmit
+    FIFO even if they do not fill a packet, or the zero length packet that
+    closes a transfer.  It does not wait for the packet to go out.
+    
+  Conditions:
+    CDC_TX_FIFO_SIZE is defined in usb_config.h.
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCTxFlush(void)
+{
+    cdc_tx_fifo_flush = true;
+}//end CDCTxFlush
+#endif
+
+/************************************************************************
+  Function:
+        static bool CDCTxPacket(void)
+    
+  Summary:
+    Queues the next IN packet of the put*USBUSART() transfer, or of the
+    transmit FIFO once that transfer is done, in the next IN buffer.
+
+  Conditions:
+    Called from CDCTxService().  The next IN buffer belongs to the CPU while
+    its UOWN bit is clear, so it is filled with the USB interrupt enabled.
+    Only handing it to the SIE, together with the transfer state that goes
+    with it, happens masked.
+  Output:
+    bool - true if a packet was queued and the next buffer may take
+           another one.
+  ************************************************************************/
+static bool CDCTxPacket(void)
+{
+    uint8_t byte_to_send;
+    uint8_t state;
+    uint8_t i;
+    
+    if(USBHandleBusy(CDCDataInHandle[cdc_tx_next])) 
+    {
+        return false;
+    }
+
+    /*
+     * Completing stage is necessary while [ mCDCUSartTxIsBusy()==1 ].
+     * By having this stage, user can always check cdc_trf_state,
+     * and not having to call mCDCUsartTxIsBusy() directly.
+     */
+    if(cdc_trf_state == CDC_TX_COMPLETING)
+        cdc_trf_state = CDC_TX_READY;
+    
+    /*
+     * If CDC_TX_READY state, nothing to do but the transmit FIFO.
+     */
+    if(cdc_trf_state == CDC_TX_READY)
+    {
+        #if defined(CDC_TX_FIFO_SIZE)
+            return CDCTxFifoService();
+        #else
+            return false;
+        #endif
+    }
+    
+    /*
+     * If CDC_TX_BUSY_ZLP state, send zero length packet
+     */
+    if(cdc_trf_state == CDC_TX_BUSY_ZLP)
+    {
+        byte_to_send = 0;
+        //CDC_DATA_BD_IN.CNT = 0;
+        state = CDC_TX_COMPLETING;
+    }
+    else
+    {
+        /*
+         * First, have to figure out how many byte of data to send.
+         */
+    	if(cdc_tx_len > CDC_DATA_IN_EP_SIZE)
+    	    byte_to_send = CDC_DATA_IN_EP_SIZE;
+    	else
+    	    byte_to_send = cdc_tx_len;
+
+        /*
+         * Subtract the number of bytes just about to be sent from the total.
+         */
+    	cdc_tx_len = cdc_tx_len - byte_to_send;
+    	  
+        pCDCDst.bRam = (uint8_t*)cdc_tx_buffer[cdc_tx_next]; // Set destination pointer
+        
+        i = byte_to_send;
+        if(cdc_mem_type == USB_EP0_ROM)            // Determine type of memory source
+        {
+            while(i)
+            {
+                *pCDCDst.bRam = *pCDCSrc.bRom;
+                pCDCDst.bRam++;
+                pCDCSrc.bRom++;
+                i--;
+            }//end while(byte_to_send)
+        }
+        else
+        {
+            while(i)
+            {
+                *pCDCDst.bRam = *pCDCSrc.bRam;
+                pCDCDst.bRam++;
+                pCDCSrc.bRam++;
+                i--;
+            }
+        }
+        
+        /*
+         * Lastly, determine if a zero length packet state is necessary.
+         * See explanation in USB Specification 2.0: Section 5.8.3
+         */
+        state = CDC_TX_BUSY;
+        if(cdc_tx_len == 0)
+        {
+            if(byte_to_send == CDC_DATA_IN_EP_SIZE)
+                state = CDC_TX_BUSY_ZLP;
+            else
+                state = CDC_TX_COMPLETING;
+        }//end if(cdc_tx_len...)
+
+    }//end if(cdc_tx_sate == CDC_TX_BUSY)
+
+    CDCMaskInterrupts();
+
+    /*
+     * An endpoint halt flushes the transfer from the interrupt.  If that
+     * happened while the packet was being copied, drop the packet.
+     */
+    if(cdc_trf_state == CDC_TX_READY)
+    {
+        CDCUnmaskInterrupts();
+        return false;
+    }
+
+    cdc_trf_state = state;
+    CDCTxSend(byte_to_send);
+    CDCUnmaskInterrupts();
+    
+    return true;
+}//end CDCTxPacket
+
+
+/************************************************************************
+  Function:
+        void CDCTxService(void)
+    
+  Summary:
+    CDCTxService handles device-to-host transaction(s). This function
+    should be called once per Main Program loop after the device reaches
+    the configured state.
+  Description:
+    CDCTxService handles device-to-host transaction(s). This function
+    should be called once per Main Program loop after the device reaches
+    the configured state (after the CDCIniEP() function has already executed).
+    This function is needed, in order to advance the internal software state 
+    machine that takes care of sending multiple transactions worth of IN USB
+    data to the host, associated with CDC serial data.  Failure to call 
+    CDCTxService() periodically will prevent data from being sent to the
+    USB host, over the CDC serial data interface.
+    
+    Typical Usage:
+    <code>
+    void main(void)
+    {
+        USBDeviceInit();
+        while(1)
+        {
+            USBDeviceTasks();
+            if((USBGetDeviceState() \< CONFIGURED_STATE) ||
+               (USBIsDeviceSuspended() == true))
+            {
+                //Either the device is not configured or we are suspended
+                //  so we don't want to do execute any application code
+                continue;   //go back to the top of the while loop
+            }
+            else
+            {
+                //Keep trying to send data to the PC as required
+                CDCTxService();
+    
+                //Run application code.
+                UserApplication();
+            }
+        }
+    }
+    </code>
+  Conditions:
+    CDCIniEP() function should have already executed/the device should be
+    in the CONFIGURED_STATE.
+  Remarks:
+    None                                                                 
+  ************************************************************************/
+ 
+void CDCTxService(void)
+{
+    uint8_t i;
+
+    #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
+        CDCMaskInterrupts();
+        CDCNotificationHandler();
+        CDCUnmaskInterrupts();
+    #endif
+
+    /*
+     * With ping-pong buffering two IN packets can be in flight at once,
+     * so fill every buffer that is idle.
+     */
+    for(i = 0; i < CDC_DATA_IN_BUFFERS; i++)
+    {
+        if(CDCTxPacket() == false)
+            break;
+    }
+}//end CDCTxService
+
+#if defined(CDC_MEASURE_MASKED_CYCLES)
+/**********************************************************************************
+  Function:
+        uint16_t CDCGetMaskedCycles(void)
+    
+  Summary:
+    CDCGetMaskedCycles returns the longest time the CDC driver has kept the
+    USB interrupt masked, in instruction cycles.
+
+  Description:
+    Each window the driver masks the USB interrupt for is timed with
+    Timer1 running from the instruction clock.  SOF and EP0 control
+    traffic wait for the longest of them.  The figure includes the few
+    cycles spent starting and stopping the timer, and the time spent in
+    any other interrupt serviced inside the window, since the timer keeps
+    counting through it.  USB events wait for that time as well.
+    
+  Conditions:
+    CDC_MEASURE_MASKED_CYCLES is defined in usb_config.h and Timer1 is not
+    used for anything else.
+  Input:
+    None
+  Output:
+    uint16_t -    The longest masked window since CDCClearMaskedCycles().
+                                                                                   
+  **********************************************************************************/
+uint16_t CDCGetMaskedCycles(void)
+{
+    return cdc_masked_cycles;
+}//end CDCGetMaskedCycles
+
+/**********************************************************************************
+  Function:
+        void CDCClearMaskedCycles(void)
+    
+  Summary:
+    CDCClearMaskedCycles starts timing the longest masked window afresh.
+
+  Conditions:
+    CDC_MEASURE_MASKED_CYCLES is defined in usb_config.h.
+  Input:
+    None
+                                                                                   
+  **********************************************************************************/
+void CDCClearMaskedCycles(void)
+{
+    cdc_masked_cycles = 0;
+}//end CDCClearMaskedCycles
+#endif
+
+#endif //USB_USE_CDC
+
+/** EOF cdc.c ****************************************************************/
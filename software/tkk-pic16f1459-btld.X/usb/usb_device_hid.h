@@ -97,6 +97,59 @@ please contact mla_licensing@microchip.com
  *******************************************************************/
 void USBCheckHIDRequest(void);
 
+/********************************************************************
+    Function:
+        uint8_t USBHIDGetProtocol(void)
+
+    Summary:
+        Returns the protocol selected by the host
+
+    Description:
+        Returns the protocol last selected by a SET_PROTOCOL request.
+        A boot interface must send boot reports while the host has
+        selected BOOT_PROTOCOL, whatever its report descriptor says.
+
+    PreCondition:
+        None
+
+    Parameters:
+        None
+
+    Return Values:
+        uint8_t - BOOT_PROTOCOL or RPT_PROTOCOL
+
+    Remarks:
+        None
+
+ *******************************************************************/
+uint8_t USBHIDGetProtocol(void);
+
+/********************************************************************
+    Function:
+        void USBHIDResetProtocol(void)
+
+    Summary:
+        Returns the interface to the report protocol
+
+    Description:
+        Selects RPT_PROTOCOL, the protocol an interface starts in after
+        the device is reset.  Call when the device is configured.
+
+    PreCondition:
+        None
+
+    Parameters:
+        None
+
+    Return Values:
+        None
+
+    Remarks:
+        None
+
+ *******************************************************************/
+void USBHIDResetProtocol(void);
+
 /********************************************************************
     Function:
         bool HIDTxHandleBusy(USB_HANDLE handle)
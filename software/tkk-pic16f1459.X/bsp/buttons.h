@@ -21,6 +21,7 @@
  *******************************************************************/
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifndef BUTTONS_H
 #define BUTTONS_H
@@ -31,9 +32,79 @@ typedef enum
     BUTTON_NONE,
     BUTTON_S1,
     BUTTON_S2,
-    BUTTON_S3
+    BUTTON_S3,
+    /* Keys of the scanned matrix (MATRIX_SCAN_ENABLE), row by row.  A
+     * matrix build has no direct buttons; S1-S3 are R0C0-R0C2 there. */
+    BUTTON_R0C0,
+    BUTTON_R0C1,
+    BUTTON_R0C2,
+    BUTTON_R0C3,
+    BUTTON_R1C0,
+    BUTTON_R1C1,
+    BUTTON_R1C2,
+    BUTTON_R1C3,
+    BUTTON_R2C0,
+    BUTTON_R2C1,
+    BUTTON_R2C2,
+    BUTTON_R2C3,
+    BUTTON_R3C0,
+    BUTTON_R3C1,
+    BUTTON_R3C2,
+    BUTTON_R3C3
 } BUTTON;
 
+/*** Debounce Algorithms ********************************************/
+typedef enum
+{
+    /* Two consecutive pressed samples taken one sample period apart,
+     * 10-20ms latency with the default period. */
+    BUTTON_DEBOUNCE_STATE_MACHINE,
+    /* Press on the first pressed sample, release after the lockout. */
+    BUTTON_DEBOUNCE_EAGER
+} BUTTON_DEBOUNCE_MODE;
+
+/*** Key Events *****************************************************/
+/* A key event is one byte, the BUTTON that changed plus
+ * BUTTON_EVENT_PRESSED when it went down. */
+typedef uint8_t BUTTON_EVENT;
+
+#define BUTTON_EVENT_PRESSED            0x80
+#define BUTTON_EVENT_BUTTON(event)      ((BUTTON)((event) & 0x7F))
+
+/*** Key Statistics *************************************************/
+/* Wear counters of a key.  The counters stick at 65535. */
+typedef struct
+{
+    uint16_t actuations;    // debounced presses
+    uint16_t edges;         // raw contact changes, from the edge interrupt
+    uint16_t bounces;       // raw changes that were not debounced changes
+    uint8_t longestBounce;  // longest burst of edges, in ms
+} BUTTON_STATS;
+
+/* Edges closer together than this belong to the same bounce burst. */
+#define BUTTON_BOUNCE_GAP_MS            10
+
+/* Release lockout applied by BUTTON_Enable(), in milliseconds. */
+#define BUTTON_RELEASE_LOCKOUT_DEFAULT  8
+/* BUTTON_DEBOUNCE_STATE_MACHINE sample period at start-up, in ms. */
+#define BUTTON_SAMPLE_PERIOD_DEFAULT    10
+
+/*********************************************************************
+* Function: void BUTTON_UpdateStates(void);
+*
+* Overview: Samples the buttons and advances the debounce algorithm
+*           selected with BUTTON_SetDebounceMode().  Must be called on
+*           every scan tick.
+*
+* PreCondition: button configured via BUTTON_Enable()
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_UpdateStates (void);
+
 /*********************************************************************
 * Function: bool BUTTON_IsPressed(BUTTON button);
 *
@@ -50,10 +121,105 @@ typedef enum
 * Output: TRUE if pressed; FALSE if not pressed.
 *
 ********************************************************************/
-void BUTTON_UpdateStates (void);
-
 bool BUTTON_IsPressed(BUTTON button);
 
+/*********************************************************************
+* Function: uint16_t BUTTON_GetPressTime(BUTTON button);
+*
+* Overview: Returns the TICK_Get() time of the last press of the button:
+*           the edge that closed the contact.  A matrix has no edge
+*           interrupt; there BUTTON_DEBOUNCE_STATE_MACHINE stamps a press
+*           with the first sample that saw it closed.
+*
+* PreCondition: button configured via BUTTON_Enable()
+*
+* Input: BUTTON button - the button to query
+*
+* Output: time of the last press in milliseconds
+*
+********************************************************************/
+uint16_t BUTTON_GetPressTime(BUTTON button);
+
+/*********************************************************************
+* Function: void BUTTON_GetStats(BUTTON button, BUTTON_STATS *counters);
+*
+* Overview: Returns the wear counters of a button.  A switch that wears
+*           out shows up as a growing share of bounces and a longer
+*           longest bounce before users report double presses.
+*
+* PreCondition: Must not be interrupted by BUTTON_UpdateStates() (call
+*               from interrupt context).
+*
+* Input: BUTTON button - the button to query
+*        BUTTON_STATS *counters - receives the counters
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_GetStats(BUTTON button, BUTTON_STATS *counters);
+
+/*********************************************************************
+* Function: void BUTTON_ClearStats(void);
+*
+* Overview: Clears the wear counters of every button.
+*
+* PreCondition: Must not be interrupted by BUTTON_UpdateStates() (call
+*               from interrupt context).
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_ClearStats(void);
+
+/*********************************************************************
+* Function: void BUTTON_SetDebounceMode(BUTTON_DEBOUNCE_MODE mode);
+*
+* Overview: Selects the debounce algorithm used by BUTTON_UpdateStates().
+*           All buttons restart from the released state; a release event
+*           is queued for each button that was pressed.
+*
+* PreCondition: None
+*
+* Input: BUTTON_DEBOUNCE_MODE mode - the algorithm to use
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_SetDebounceMode(BUTTON_DEBOUNCE_MODE mode);
+
+/*********************************************************************
+* Function: void BUTTON_SetSamplePeriod(uint8_t milliseconds);
+*
+* Overview: Sets how often BUTTON_DEBOUNCE_STATE_MACHINE samples the
+*           buttons.
+*
+* PreCondition: None
+*
+* Input: uint8_t milliseconds - sample period, 1-255ms
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_SetSamplePeriod(uint8_t milliseconds);
+
+/*********************************************************************
+* Function: void BUTTON_SetReleaseLockout(BUTTON button, uint8_t milliseconds);
+*
+* Overview: Sets how long the contact of a button must read open before
+*           BUTTON_DEBOUNCE_EAGER reports it released.
+*
+* PreCondition: None
+*
+* Input: BUTTON button - the button to configure
+*        uint8_t milliseconds - release lockout time, 1-255ms
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_SetReleaseLockout(BUTTON button, uint8_t milliseconds);
+
 /*********************************************************************
 * Function: void BUTTON_Enable(BUTTON button);
 *
@@ -72,4 +238,52 @@ bool BUTTON_IsPressed(BUTTON button);
 ********************************************************************/
 void BUTTON_Enable(BUTTON button);
 
+/*********************************************************************
+* Function: bool BUTTON_GetEvent(BUTTON_EVENT *event);
+*
+* Overview: Takes the oldest key event from the event queue.  Every
+*           debounced press and release is queued by
+*           BUTTON_UpdateStates(), so short taps are seen even when the
+*           caller only polls once per report.
+*
+* PreCondition: None.  Only one caller may consume events.
+*
+* Input: BUTTON_EVENT *event - receives the event
+*
+* Output: true if an event was returned, false if the queue is empty
+*
+********************************************************************/
+bool BUTTON_GetEvent(BUTTON_EVENT *event);
+
+/*********************************************************************
+* Function: uint16_t BUTTON_GetEventOverflowCount(void);
+*
+* Overview: Returns the number of key events dropped because the event
+*           queue was full.  A consumer that sees the count change has
+*           missed events and should resynchronize with
+*           BUTTON_IsPressed().
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: dropped events since start-up, wrapping at 65536
+*
+********************************************************************/
+uint16_t BUTTON_GetEventOverflowCount(void);
+
+/*********************************************************************
+* Function: void BUTTON_InterruptHandler(void);
+*
+* Overview: Captures button edges from the interrupt-on-change flags.
+*
+* PreCondition: Called from the interrupt vector when IOCIF is set.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void BUTTON_InterruptHandler(void);
+
 #endif //BUTTONS_H
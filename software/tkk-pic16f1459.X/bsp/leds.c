@@ -22,23 +22,23 @@
 
 #include <leds.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <xc.h>
 
-#define LED_D1_LAT LATCbits.LATC6
-#define LED_D2_LAT LATCbits.LATC7
-// #define LED_D3_LAT LATCbits.LATC2
-// #define LED_D4_LAT LATCbits.LATC3
+/*** LED Definitions ************************************************/
+/* The LEDs are on PORTC and are driven by mask through the whole port
+ * registers, as buttons.c reads the keys. */
+#define LED_LAT             LATC
+#define LED_TRIS            TRISC
 
-#define LED_D1_TRIS TRISCbits.TRISC6
-#define LED_D2_TRIS TRISCbits.TRISC7
-// #define LED_D3_TRIS TRISCbits.TRISC2
-// #define LED_D4_TRIS TRISCbits.TRISC3
+#define D1_MASK  0x40   // RC6
+#define D2_MASK  0x80   // RC7
+// #define D3_MASK  0x04   // RC2
+// #define D4_MASK  0x08   // RC3
 
-#define LED_ON  1
-#define LED_OFF 0
-
-#define PIN_INPUT  1
-#define PIN_OUTPUT 0
+/* Pin mask of each LED, in LED enumeration order.  LED_NONE and the
+ * LEDs this board does not fit have no pin. */
+static const uint8_t ledMask[] = { 0, D1_MASK, D2_MASK, 0, 0 };
 
 /*********************************************************************
 * Function: void LED_On(LED led);
@@ -58,27 +58,7 @@
 ********************************************************************/
 void LED_On(LED led)
 {
-    switch(led)
-    {
-        case LED_D1:
-            LED_D1_LAT = LED_ON;
-            break;
-
-        case LED_D2:
-            LED_D2_LAT = LED_ON;
-            break;
-/*			
-        case LED_D3:
-            LED_D3_LAT = LED_ON;
-            break;
-			
-        case LED_D4:
-            LED_D4_LAT = LED_ON;
-            break;
-*/
-        case LED_NONE:
-            break;
-    }
+    LED_LAT |= ledMask[led];
 }
 
 /*********************************************************************
@@ -99,27 +79,7 @@ void LED_On(LED led)
 ********************************************************************/
 void LED_Off(LED led)
 {
-    switch(led)
-    {
-        case LED_D1:
-            LED_D1_LAT = LED_OFF;
-            break;
-
-        case LED_D2:
-            LED_D2_LAT = LED_OFF;
-            break;
-/*			
-        case LED_D3:
-            LED_D3_LAT = LED_OFF;
-            break;
-			
-        case LED_D4:
-            LED_D4_LAT = LED_OFF;
-            break;
-*/
-        case LED_NONE:
-            break;
-    }
+    LED_LAT &= ~ledMask[led];
 }
 
 /*********************************************************************
@@ -140,27 +100,7 @@ void LED_Off(LED led)
 ********************************************************************/
 void LED_Toggle(LED led)
 {
-    switch(led)
-    {
-        case LED_D1:
-            LED_D1_LAT ^= 1;
-            break;
-
-        case LED_D2:
-            LED_D2_LAT ^= 1;
-            break;
-/*			
-        case LED_D3:
-            LED_D3_LAT ^= 1;
-            break;
-			
-        case LED_D4:
-            LED_D4_LAT ^= 1;
-            break;
-*/
-        case LED_NONE:
-            break;
-    }
+    LED_LAT ^= ledMask[led];
 }
 
 /*********************************************************************
@@ -181,25 +121,7 @@ void LED_Toggle(LED led)
 ********************************************************************/
 bool LED_Get(LED led)
 {
-    switch(led)
-    {
-        case LED_D1:
-            return ( (LED_D1_LAT == LED_ON) ? true : false );
-
-        case LED_D2:
-            return ( (LED_D2_LAT == LED_ON) ? true : false );
-/*			
-        case LED_D3:
-            return ( (LED_D3_LAT == LED_ON) ? true : false );
-			
-        case LED_D4:
-            return ( (LED_D4_LAT == LED_ON) ? true : false );
-*/
-        case LED_NONE:
-            return false;
-    }
-    
-    return false;
+    return ( ((LED_LAT & ledMask[led]) != 0) ? true : false );
 }
 
 /*********************************************************************
@@ -219,25 +141,5 @@ bool LED_Get(LED led)
 ********************************************************************/
 void LED_Enable(LED led)
 {
-    switch(led)
-    {
-        case LED_D1:
-            LED_D1_TRIS = PIN_OUTPUT;
-            break;
-
-        case LED_D2:
-            LED_D2_TRIS = PIN_OUTPUT;
-            break;
-/*			
-        case LED_D3:
-            LED_D3_TRIS = PIN_OUTPUT;
-            break;
-			
-        case LED_D4:
-            LED_D4_TRIS = PIN_OUTPUT;
-            break;
-*/
-        case LED_NONE:
-            break;
-    }
+    LED_TRIS &= ~ledMask[led];
 }
@@ -0,0 +1,204 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <matrix.h>
+
+#if defined(MATRIX_SCAN_ENABLE)
+
+#if MATRIX_COLS != 4 || MATRIX_ROWS != 4
+#error "the scan packs two rows of four columns into each lane and wraps the row index with a mask"
+#endif
+
+/*** Pin Definitions ************************************************/
+#define MATRIX_ROW_TRIS     TRISC
+#define MATRIX_ROW_LAT      LATC
+#define MATRIX_ROW_ANSEL    ANSELC
+#define MATRIX_ROW_MASK     0x0F    // RC0-RC3
+
+#define MATRIX_COL_PORT     PORTB
+#define MATRIX_COL_TRIS     TRISB
+#define MATRIX_COL_WPU      WPUB
+#define MATRIX_COL_ANSEL    ANSELB
+#define MATRIX_COL_MASK     0xF0    // RB4-RB7
+#define MATRIX_COL_SHIFT    4
+
+static const uint8_t rowDrive[MATRIX_ROWS] = { 0x01, 0x02, 0x04, 0x08 };
+
+/* Columns closed on each row in the scan in progress and in the last
+ * accepted scan, 1 = closed, column c in bit c. */
+static uint8_t scanRows[MATRIX_ROWS];
+static uint8_t keyRows[MATRIX_ROWS];
+static uint8_t row;
+static uint16_t ghostCount;
+
+/*********************************************************************
+* Function: static void MATRIX_Publish(void);
+*
+* Overview: Accepts a complete scan.  Without diodes, three keys on the
+*           corners of a rectangle also close the fourth; two rows that
+*           share two or more closed columns are ambiguous and keep
+*           their previous state.
+*
+********************************************************************/
+static void MATRIX_Publish(void)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t shared;
+    uint8_t ghost = 0;
+
+    for(i = 0; i < MATRIX_ROWS - 1; i++)
+    {
+        for(j = i + 1; j < MATRIX_ROWS; j++)
+        {
+            shared = scanRows[i] & scanRows[j];
+            // two or more bits set
+            if((shared & (shared - 1)) != 0)
+            {
+                ghost |= rowDrive[i] | rowDrive[j];
+            }
+        }
+    }
+
+    for(i = 0; i < MATRIX_ROWS; i++)
+    {
+        if((ghost & rowDrive[i]) == 0)
+        {
+            keyRows[i] = scanRows[i];
+        }
+    }
+
+    if(ghost != 0)
+    {
+        ghostCount++;
+    }
+}
+
+/*********************************************************************
+* Function: void MATRIX_Initialize(void);
+*
+* Overview: Configures the row and column pins and drives the first row.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void MATRIX_Initialize(void)
+{
+    //Rows idle as inputs with their latches low, and are driven low one
+    //at a time by switching TRIS, so two closed keys in a column never
+    //short a high row to a low one.
+    MATRIX_ROW_LAT &= ~MATRIX_ROW_MASK;
+    MATRIX_ROW_ANSEL &= ~MATRIX_ROW_MASK;
+    MATRIX_ROW_TRIS |= MATRIX_ROW_MASK;
+
+    OPTION_REGbits.nWPUEN = 0;
+    MATRIX_COL_ANSEL &= ~MATRIX_COL_MASK;
+    MATRIX_COL_TRIS |= MATRIX_COL_MASK;
+    MATRIX_COL_WPU |= MATRIX_COL_MASK;
+
+    row = 0;
+    MATRIX_ROW_TRIS &= ~rowDrive[0];
+}
+
+/*********************************************************************
+* Function: void MATRIX_Read(uint8_t *lanes);
+*
+* Overview: Copies the last complete scan into button lanes, key
+*           r * MATRIX_COLS + c in bit (key & 7) of lanes[key >> 3].
+*           A 1 bit is a closed contact.
+*
+* PreCondition: MATRIX_Initialize() called.  Must not be interrupted by
+*               MATRIX_ScanRow() (call from interrupt context).
+*
+* Input: uint8_t *lanes - MATRIX_KEYS / 8 bytes
+*
+* Output: None
+*
+********************************************************************/
+void MATRIX_Read(uint8_t *lanes)
+{
+    uint8_t i;
+
+    for(i = 0; i < MATRIX_ROWS; i += 2)
+    {
+        *lanes++ = keyRows[i] | (keyRows[i + 1] << MATRIX_COLS);
+    }
+}
+
+/*********************************************************************
+* Function: uint16_t MATRIX_GetGhostCount(void);
+*
+* Overview: Returns the number of scans in which a ghost key could not
+*           be told apart from a real one.  Rows that show a ghost keep
+*           their previous state until the ambiguity clears.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: number of ambiguous scans, wrapping at 65536
+*
+********************************************************************/
+uint16_t MATRIX_GetGhostCount(void)
+{
+    return ghostCount;
+}
+
+/*********************************************************************
+* Function: void MATRIX_ScanRow(void);
+*
+* Overview: Reads the columns of the row driven by the previous call and
+*           drives the next row, so each row has a full tick to settle.
+*           A full scan takes MATRIX_ROWS ticks, 1ms at 4kHz.
+*
+*           Cycle budget: about 40 instruction cycles per row and
+*           another 120 at the end of each scan for the ghost check,
+*           well under 200 cycles (17us) of the 1500 cycle (125us) tick
+*           at the fastest TICK_RATE_HZ.
+*
+* PreCondition: Called from the tick interrupt, once per tick.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void MATRIX_ScanRow(void)
+{
+    scanRows[row] = ((uint8_t)~MATRIX_COL_PORT & MATRIX_COL_MASK) >> MATRIX_COL_SHIFT;
+
+    row = (row + 1) & (MATRIX_ROWS - 1);
+    MATRIX_ROW_TRIS = (MATRIX_ROW_TRIS | MATRIX_ROW_MASK) & ~rowDrive[row];
+
+    if(row == 0)
+    {
+        MATRIX_Publish();
+    }
+}
+
+#endif //MATRIX_SCAN_ENABLE
@@ -0,0 +1,129 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#ifndef TICK_H
+#define TICK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*** Tick Definitions ***********************************************/
+/* Rate of the Timer2 scan tick in Hz until TICK_SetRate() is called:
+ * 1000, 2000, 4000 or 8000.  The keys are sampled on every tick and a
+ * scanned matrix steps one row per tick, so a 4x4 matrix needs 4000 or
+ * more for a 1kHz full scan. */
+#define TICK_RATE_HZ        4000
+
+/*********************************************************************
+* Function: void TICK_Initialize(void);
+*
+* Overview: Starts Timer2 at the tick rate and enables its interrupt.
+*           The tick keeps running while the bus is suspended or the
+*           device is unconfigured.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void TICK_Initialize(void);
+
+/*********************************************************************
+* Function: bool TICK_InterruptHandler(void);
+*
+* Overview: Timer2 interrupt handler.  Clears the interrupt and advances
+*           the millisecond clock once every millisecond of ticks.
+*
+* PreCondition: Called from the interrupt vector when TMR2IF is set.
+*
+* Input: None
+*
+* Output: true on the tick that starts a new millisecond
+*
+********************************************************************/
+bool TICK_InterruptHandler(void);
+
+/*********************************************************************
+* Function: bool TICK_SetRate(uint16_t rateHz);
+*
+* Overview: Changes the tick rate.  Takes effect at once if the tick is
+*           running; the millisecond clock carries on counting.
+*
+* PreCondition: None
+*
+* Input: uint16_t rateHz - 1000, 2000, 4000 or 8000
+*
+* Output: false if the rate is not supported, the rate is unchanged
+*
+********************************************************************/
+bool TICK_SetRate(uint16_t rateHz);
+
+/*********************************************************************
+* Function: uint16_t TICK_GetRate(void);
+*
+* Overview: Returns the tick rate set by TICK_SetRate().
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: tick rate in Hz
+*
+********************************************************************/
+uint16_t TICK_GetRate(void);
+
+/*********************************************************************
+* Function: void TICK_Synchronize(void);
+*
+* Overview: Keeps the millisecond tick in phase with the USB frames.
+*           Called from the SOF event; restarts the timer only when the
+*           millisecond tick has drifted by more than one tick, or at
+*           every SOF at 1kHz, where the drift can't be read.
+*
+* PreCondition: TICK_Initialize() called
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void TICK_Synchronize(void);
+
+/*********************************************************************
+* Function: uint16_t TICK_Get(void);
+*
+* Overview: Returns the monotonic millisecond clock.  The count wraps
+*           every 65.536 seconds; compare times by subtraction only,
+*           i.e. (uint16_t)(TICK_Get() - then) >= interval.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: milliseconds since start-up, modulo 65536
+*
+********************************************************************/
+uint16_t TICK_Get(void);
+
+#endif //TICK_H
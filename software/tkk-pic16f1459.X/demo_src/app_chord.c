@@ -0,0 +1,370 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system.h"
+#include "buttons.h"
+#include "tick.h"
+#include "app_keymap.h"
+#include "app_chord.h"
+
+/* Chord window, see APP_ChordSetWindow(). */
+static volatile uint8_t chordWindow = APP_CHORD_WINDOW_DEFAULT;
+
+/* Presses held back, in the order they were made, as a set of keys, and
+ * the time of the first. */
+static uint8_t heldKey[APP_CHORD_KEYS_MAX];
+static uint8_t heldCount;
+static KEYMAP_KEYS heldKeys;
+static uint16_t heldStart;
+
+/* Chords down: the keys of each that are still down, whose releases the
+ * chord takes, its number, and whether its action is still pressed.  A
+ * slot with no keys is free. */
+#define CHORD_ACTIVE_MAX    2
+
+static KEYMAP_KEYS activeKeys[CHORD_ACTIVE_MAX];
+static uint8_t activeChord[CHORD_ACTIVE_MAX];
+static bool activeDown[CHORD_ACTIVE_MAX];
+
+/* Key changes decided and not taken yet.  Button events are only taken
+ * while the queue is empty, and one event queues at most the presses held
+ * back and its own change. */
+#define CHORD_QUEUE_SIZE    (APP_CHORD_KEYS_MAX + 1)
+
+static uint8_t queueKey[CHORD_QUEUE_SIZE];
+static uint8_t queueChord[CHORD_QUEUE_SIZE];
+static bool queueDown[CHORD_QUEUE_SIZE];
+static uint8_t queueHead;
+static uint8_t queueCount;
+
+/* Longest time a press has been held back, in ms. */
+static uint8_t longestDelay;
+
+static void APP_ChordQueue(uint8_t key, uint8_t chord, bool down)
+{
+    uint8_t tail;
+
+    if(queueCount == CHORD_QUEUE_SIZE)
+    {
+        return;
+    }
+
+    tail = (queueHead + queueCount) % CHORD_QUEUE_SIZE;
+    queueKey[tail] = key;
+    queueChord[tail] = chord;
+    queueDown[tail] = down;
+    queueCount++;
+}
+
+/* Counts the chords that have all of keys, and finds the one that has
+ * exactly them. */
+static uint8_t APP_ChordCount(KEYMAP_KEYS keys, uint8_t *exact)
+{
+    KEYMAP_KEYS chordKeys;
+    uint8_t chord;
+    uint8_t count;
+
+    count = 0;
+    *exact = KEYMAP_NO_CHORD;
+    for(chord = 0; chord < APP_KeymapGetChordCount(); chord++)
+    {
+        chordKeys = APP_KeymapGetChordKeys(chord);
+        if((chordKeys & keys) == keys)
+        {
+            count++;
+            if(chordKeys == keys)
+            {
+                *exact = chord;
+            }
+        }
+    }
+    return count;
+}
+
+/* Ends the hold back: the keys held make a chord, or their presses go on
+ * as they were made. */
+static void APP_ChordDecide(void)
+{
+    uint16_t delay;
+    uint8_t chord;
+    uint8_t slot;
+    uint8_t i;
+
+    delay = TICK_Get() - heldStart;
+    if(delay > longestDelay)
+    {
+        longestDelay = (delay > 0xFF) ? 0xFF : (uint8_t)delay;
+    }
+
+    APP_ChordCount(heldKeys, &chord);
+    for(slot = 0; slot < CHORD_ACTIVE_MAX; slot++)
+    {
+        if(activeKeys[slot] == 0)
+        {
+            break;
+        }
+    }
+
+    if((chord != KEYMAP_NO_CHORD) && (slot < CHORD_ACTIVE_MAX))
+    {
+        activeKeys[slot] = heldKeys;
+        activeChord[slot] = chord;
+        activeDown[slot] = true;
+        APP_ChordQueue(heldKey[0], chord, true);
+    }
+    else
+    {
+        for(i = 0; i < heldCount; i++)
+        {
+            APP_ChordQueue(heldKey[i], KEYMAP_NO_CHORD, true);
+        }
+    }
+
+    heldCount = 0;
+    heldKeys = 0;
+}
+
+static void APP_ChordPress(uint8_t key)
+{
+    KEYMAP_KEYS keys;
+    uint8_t chord;
+    uint8_t count;
+
+    // a key that cannot be part of the same chord decides the keys held
+    if((heldCount != 0) &&
+       ((heldCount == APP_CHORD_KEYS_MAX) ||
+        (APP_ChordCount(heldKeys | KEYMAP_KEY(key), &chord) == 0)))
+    {
+        APP_ChordDecide();
+    }
+
+    keys = heldKeys | KEYMAP_KEY(key);
+    count = APP_ChordCount(keys, &chord);
+    if((chordWindow == 0) || (count == 0))
+    {
+        APP_ChordQueue(key, KEYMAP_NO_CHORD, true);
+        return;
+    }
+
+    if(heldCount == 0)
+    {
+        heldStart = TICK_Get();
+    }
+    heldKey[heldCount] = key;
+    heldCount++;
+    heldKeys = keys;
+
+    // no more keys can make a larger chord, so there is no need to wait
+    if((count == 1) && (chord != KEYMAP_NO_CHORD))
+    {
+        APP_ChordDecide();
+    }
+}
+
+static void APP_ChordRelease(uint8_t key)
+{
+    uint8_t slot;
+
+    if((heldKeys & KEYMAP_KEY(key)) != 0)
+    {
+        APP_ChordDecide();
+    }
+
+    // the first key of a chord released releases the chord
+    for(slot = 0; slot < CHORD_ACTIVE_MAX; slot++)
+    {
+        if((activeKeys[slot] & KEYMAP_KEY(key)) != 0)
+        {
+            activeKeys[slot] &= ~KEYMAP_KEY(key);
+            if(activeDown[slot] == true)
+            {
+                activeDown[slot] = false;
+                APP_ChordQueue(key, activeChord[slot], false);
+            }
+            return;
+        }
+    }
+
+    APP_ChordQueue(key, KEYMAP_NO_CHORD, false);
+}
+
+/*********************************************************************
+* Function: void APP_ChordSetWindow(uint8_t window);
+*
+* Overview: Sets the chord window.  May be called in interrupt context.
+*
+* PreCondition: None
+*
+* Input: uint8_t window - longest time in ms between the first and the
+*                         last press of a chord, 0 to turn chords off
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordSetWindow(uint8_t window)
+{
+    chordWindow = window;
+}
+
+/*********************************************************************
+* Function: void APP_ChordReset(void);
+*
+* Overview: Forgets every press held back, every chord down and every
+*           key change not yet taken.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordReset(void)
+{
+    uint8_t slot;
+
+    heldCount = 0;
+    heldKeys = 0;
+    for(slot = 0; slot < CHORD_ACTIVE_MAX; slot++)
+    {
+        activeKeys[slot] = 0;
+        activeDown[slot] = false;
+    }
+    queueHead = 0;
+    queueCount = 0;
+}
+
+/*********************************************************************
+* Function: void APP_ChordTasks(void);
+*
+* Overview: Takes the button events and decides the presses held back
+*           past the chord window.  Call from the main loop.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordTasks(void)
+{
+    BUTTON_EVENT event;
+    uint8_t key;
+
+    // the changes already decided are taken first
+    if(queueCount != 0)
+    {
+        return;
+    }
+
+    if((heldCount != 0) && ((uint16_t)(TICK_Get() - heldStart) >= chordWindow))
+    {
+        APP_ChordDecide();
+        return;
+    }
+
+    while((queueCount == 0) && (BUTTON_GetEvent(&event) == true))
+    {
+        key = APP_KeymapFindKey(BUTTON_EVENT_BUTTON(event));
+        if(key == KEYMAP_NO_KEY)
+        {
+            continue;
+        }
+
+        if((event & BUTTON_EVENT_PRESSED) != 0)
+        {
+            APP_ChordPress(key);
+        }
+        else
+        {
+            APP_ChordRelease(key);
+        }
+    }
+}
+
+/*********************************************************************
+* Function: bool APP_ChordGetKey(uint8_t *key, uint8_t *chord,
+*                                bool *down);
+*
+* Overview: Takes the oldest key change decided.
+*
+* PreCondition: None
+*
+* Input: uint8_t *key - receives the key number; for a chord, the first
+*                       of its keys pressed or released
+*        uint8_t *chord - receives the chord number, or KEYMAP_NO_CHORD
+*                         for a change of the key itself
+*        bool *down - receives true for a press, false for a release
+*
+* Output: false if there is none
+*
+********************************************************************/
+bool APP_ChordGetKey(uint8_t *key, uint8_t *chord, bool *down)
+{
+    if(queueCount == 0)
+    {
+        return false;
+    }
+
+    *key = queueKey[queueHead];
+    *chord = queueChord[queueHead];
+    *down = queueDown[queueHead];
+    queueHead = (queueHead + 1) % CHORD_QUEUE_SIZE;
+    queueCount--;
+    return true;
+}
+
+/*********************************************************************
+* Function: uint8_t APP_ChordGetLongestDelay(void);
+*
+* Overview: Returns the longest time a press has been held back since
+*           the statistics were cleared.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: time in ms, 255 for 255 ms or more
+*
+********************************************************************/
+uint8_t APP_ChordGetLongestDelay(void)
+{
+    return longestDelay;
+}
+
+/*********************************************************************
+* Function: void APP_ChordClearStats(void);
+*
+* Overview: Clears the longest time a press has been held back.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordClearStats(void)
+{
+    longestDelay = 0;
+}
@@ -0,0 +1,134 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef APP_CHORD_H
+#define APP_CHORD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_keymap.h"
+
+/* Chords (the CHORD lines of app_keymap.c) sit between the buttons and
+ * the keymap: a press of a key that is part of a chord is held back until
+ * the keys down make a chord, a key that cannot be part of the same chord
+ * is pressed, a key held back is released, or the chord window has passed
+ * since the first press held back.  Keys down that make a chord then
+ * press its action instead of their own; otherwise the presses held back
+ * go on, in order.  The chord is released with the first of its keys.
+ *
+ * A press is held back at most the chord window, in ms; keys that are in
+ * no chord are never held back.  A chord has up to APP_CHORD_KEYS_MAX
+ * keys. */
+#define APP_CHORD_WINDOW_DEFAULT    50
+#define APP_CHORD_KEYS_MAX          4
+
+/*********************************************************************
+* Function: void APP_ChordSetWindow(uint8_t window);
+*
+* Overview: Sets the chord window.  May be called in interrupt context.
+*
+* PreCondition: None
+*
+* Input: uint8_t window - longest time in ms between the first and the
+*                         last press of a chord, 0 to turn chords off
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordSetWindow(uint8_t window);
+
+/*********************************************************************
+* Function: void APP_ChordReset(void);
+*
+* Overview: Forgets every press held back, every chord down and every
+*           key change not yet taken.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordReset(void);
+
+/*********************************************************************
+* Function: void APP_ChordTasks(void);
+*
+* Overview: Takes the button events and decides the presses held back
+*           past the chord window.  Call from the main loop.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordTasks(void);
+
+/*********************************************************************
+* Function: bool APP_ChordGetKey(uint8_t *key, uint8_t *chord,
+*                                bool *down);
+*
+* Overview: Takes the oldest key change decided.
+*
+* PreCondition: None
+*
+* Input: uint8_t *key - receives the key number; for a chord, the first
+*                       of its keys pressed or released
+*        uint8_t *chord - receives the chord number, or KEYMAP_NO_CHORD
+*                         for a change of the key itself
+*        bool *down - receives true for a press, false for a release
+*
+* Output: false if there is none
+*
+********************************************************************/
+bool APP_ChordGetKey(uint8_t *key, uint8_t *chord, bool *down);
+
+/*********************************************************************
+* Function: uint8_t APP_ChordGetLongestDelay(void);
+*
+* Overview: Returns the longest time a press has been held back since
+*           the statistics were cleared.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: time in ms, 255 for 255 ms or more
+*
+********************************************************************/
+uint8_t APP_ChordGetLongestDelay(void);
+
+/*********************************************************************
+* Function: void APP_ChordClearStats(void);
+*
+* Overview: Clears the longest time a press has been held back.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_ChordClearStats(void);
+
+#endif //APP_CHORD_H
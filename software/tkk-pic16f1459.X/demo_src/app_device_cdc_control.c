@@ -0,0 +1,247 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#include "system.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "usb.h"
+
+#include "app_device_cdc_control.h"
+#include "app_device_keyboard.h"
+#include "usb_config.h"
+
+/** VARIABLES ******************************************************/
+
+/* Packet borrowed from the CDC driver and how much of it has been
+ * parsed. */
+static uint8_t *readBuffer;
+static uint8_t readLength;
+static uint8_t readPosition;
+
+/* Line being parsed: the bytes so far, the hex digits of the next one
+ * and how many of them there are, and whether the line is bad. */
+static uint8_t lineBytes[APP_FEATURE_REPORT_SIZE];
+static uint8_t lineCount;
+static uint8_t lineValue;
+static uint8_t lineDigits;
+static bool lineError;
+
+/* Answer to the last line; the driver reads it while it sends it. */
+static char writeBuffer[(3 * APP_FEATURE_REPORT_SIZE) + 1];
+static uint8_t writeLength;
+
+static const char hexDigits[] = "0123456789ABCDEF";
+
+static void APP_DeviceCDCControlEndByte(void)
+{
+    if(lineDigits == 0)
+    {
+        return;
+    }
+
+    if(lineCount == APP_FEATURE_REPORT_SIZE)
+    {
+        lineError = true;
+    }
+    else
+    {
+        lineBytes[lineCount++] = lineValue;
+    }
+    lineValue = 0;
+    lineDigits = 0;
+}
+
+static void APP_DeviceCDCControlAnswer(void)
+{
+    uint8_t page[APP_FEATURE_REPORT_SIZE];
+    uint8_t i;
+    bool gie;
+
+    if(lineError == true)
+    {
+        strcpy(writeBuffer, "?\r\n");
+        writeLength = 3;
+        return;
+    }
+
+    memset(page, 0, sizeof(page));
+    memcpy(page, lineBytes, lineCount);
+
+    //The pages are served from the USB interrupt too, and they change the
+    //debouncer and the tick the Timer2 scan uses, so keep the whole
+    //interrupt out, as the feature report does by running in it.
+    gie = INTCONbits.GIE;
+    INTCONbits.GIE = 0;
+    if(lineCount > 1)
+    {
+        APP_KeyboardSetFeaturePage(page);
+        memset(&page[1], 0, sizeof(page) - 1);
+    }
+    APP_KeyboardGetFeaturePage(page);
+    INTCONbits.GIE = gie;
+
+    writeLength = 0;
+    for(i = 0; i < sizeof(page); i++)
+    {
+        writeBuffer[writeLength++] = hexDigits[page[i] >> 4];
+        writeBuffer[writeLength++] = hexDigits[page[i] & 0x0F];
+        writeBuffer[writeLength++] = ' ';
+    }
+    writeBuffer[writeLength - 1] = '\r';
+    writeBuffer[writeLength++] = '\n';
+}
+
+static void APP_DeviceCDCControlParse(uint8_t c)
+{
+    uint8_t digit;
+
+    if((c >= '0') && (c <= '9'))
+    {
+        digit = c - '0';
+    }
+    else if((c >= 'A') && (c <= 'F'))
+    {
+        digit = c - 'A' + 10;
+    }
+    else if((c >= 'a') && (c <= 'f'))
+    {
+        digit = c - 'a' + 10;
+    }
+    else
+    {
+        APP_DeviceCDCControlEndByte();
+        if((c == '\r') || (c == '\n'))
+        {
+            // an empty line, or the LF of a CR LF, is no request
+            if((lineCount != 0) || (lineError == true))
+            {
+                APP_DeviceCDCControlAnswer();
+            }
+            lineCount = 0;
+            lineError = false;
+        }
+        else if(c != ' ')
+        {
+            lineError = true;
+        }
+        return;
+    }
+
+    if(lineDigits == 2)
+    {
+        lineError = true;
+    }
+    lineValue = (uint8_t)(lineValue << 4) | digit;
+    lineDigits++;
+}
+
+/*********************************************************************
+* Function: void APP_DeviceCDCControlInitialize(void);
+*
+* Overview: Initializes the control port.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_DeviceCDCControlInitialize(void)
+{
+    line_coding.bCharFormat = 0;
+    line_coding.bDataBits = 8;
+    line_coding.bParityType = 0;
+    line_coding.dwDTERate = 9600;
+
+    readLength = 0;
+    readPosition = 0;
+    lineCount = 0;
+    lineValue = 0;
+    lineDigits = 0;
+    lineError = false;
+    writeLength = 0;
+}
+
+/*********************************************************************
+* Function: void APP_DeviceCDCControlTasks(void);
+*
+* Overview: Answers the lines received, one per call, and keeps the CDC
+*           driver transmitting.
+*
+* PreCondition: APP_DeviceCDCControlInitialize() has been called since
+*               the device was configured.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_DeviceCDCControlTasks(void)
+{
+    /* If the USB device isn't configured yet, we can't really do anything
+     * else since we don't have a host to talk to. */
+    if( USBGetDeviceState() < CONFIGURED_STATE )
+    {
+        return;
+    }
+
+    /* If we are currently suspended the host will not take anything. */
+    if( USBIsDeviceSuspended()== true )
+    {
+        return;
+    }
+
+    /* The driver sends the answer from writeBuffer, so only parse on once
+     * it is done.  The rest of a packet with several lines waits for the
+     * next call. */
+    if(USBUSARTIsTxTrfReady() == true)
+    {
+        if(readPosition == readLength)
+        {
+            readLength = CDCRxBorrow(&readBuffer);
+            readPosition = 0;
+        }
+
+        while((readPosition < readLength) && (writeLength == 0))
+        {
+            APP_DeviceCDCControlParse(readBuffer[readPosition++]);
+        }
+
+        /* The packet is kept in the endpoint buffer until it has all been
+         * parsed; the other buffer takes the next one meanwhile. */
+        if((readLength != 0) && (readPosition == readLength))
+        {
+            CDCRxRelease();
+            readLength = 0;
+            readPosition = 0;
+        }
+
+        if(writeLength != 0)
+        {
+            putUSBUSART((uint8_t*)writeBuffer, writeLength);
+            writeLength = 0;
+        }
+    }
+
+    CDCTxService();
+}
@@ -28,8 +28,17 @@ please contact mla_licensing@microchip.com
 #include "system.h"
 #include "usb.h"
 #include "usb_device_hid.h"
+#include "usb_device_cdc.h"
 
 #include "app_led_usb_status.h"
+#include "app_device_keyboard.h"
+#include "app_settings.h"
+#include "app_keymap.h"
+#include "app_macro.h"
+#include "app_tap_hold.h"
+#include "app_chord.h"
+#include "app_typematic.h"
+#include "tick.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -37,11 +46,48 @@ please contact mla_licensing@microchip.com
 // *****************************************************************************
 // *****************************************************************************
 
+/* Keyboard page usages reported in the key bitmap of the input report:
+ * 0x00 (no event) up to 0x67 (Keypad =), a whole number of bytes. */
+#define KEYBOARD_USAGE_COUNT    104
+#define KEYBOARD_BITMAP_SIZE    (KEYBOARD_USAGE_COUNT / 8)
+
+/* Modifier keys are reported as bits of the modifier byte instead. */
+#define KEYBOARD_USAGE_LEFT_CONTROL     0xE0
+
+/* Keyboard page usage a boot report fills every slot with when more keys
+ * are down than it has slots. */
+#define KEYBOARD_USAGE_ERROR_ROLL_OVER  0x01
+
+/* Key slots of the boot protocol input report. */
+#define KEYBOARD_BOOT_KEY_COUNT 6
+
+/* Generic desktop system controls, reported as bits 0-2 of the system
+ * control input report. */
+#define KEYBOARD_SYSTEM_POWER_DOWN      0x81
+#define KEYBOARD_SYSTEM_WAKE_UP         0x83
+
+/* Report IDs.  The boot protocol keyboard report has none. */
+#define KEYBOARD_REPORT_ID_NONE         0
+#define KEYBOARD_REPORT_ID_KEYBOARD     1
+#define KEYBOARD_REPORT_ID_CONSUMER     2
+#define KEYBOARD_REPORT_ID_SYSTEM       3
+#define KEYBOARD_REPORT_ID_FEATURE      4
+
+/* Entries of the tables indexed by INPUT report ID, 0 included. */
+#define KEYBOARD_INPUT_REPORT_IDS       (KEYBOARD_REPORT_ID_SYSTEM + 1)
+
+/* SET_IDLE durations are in units of 4ms; 0 repeats a report only when it
+ * changes.  The keyboard report repeats every 500ms until the host says
+ * otherwise, the other reports do not repeat. */
+#define KEYBOARD_IDLE_UNIT_MS           4
+#define KEYBOARD_IDLE_DEFAULT           (500 / KEYBOARD_IDLE_UNIT_MS)
+
 //Class specific descriptor - HID Keyboard
 const struct{uint8_t report[HID_RPT01_SIZE];}hid_rpt01={
 {   0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
     0x09, 0x06,                    // USAGE (Keyboard)
     0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, KEYBOARD_REPORT_ID_KEYBOARD, //   REPORT_ID (1)
     0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
     0x19, 0xe0,                    //   USAGE_MINIMUM (Keyboard LeftControl)
     0x29, 0xe7,                    //   USAGE_MAXIMUM (Keyboard Right GUI)
@@ -50,9 +96,6 @@ const struct{uint8_t report[HID_RPT01_SIZE];}hid_rpt01={
     0x75, 0x01,                    //   REPORT_SIZE (1)
     0x95, 0x08,                    //   REPORT_COUNT (8)
     0x81, 0x02,                    //   INPUT (Data,Var,Abs)
-    0x95, 0x01,                    //   REPORT_COUNT (1)
-    0x75, 0x08,                    //   REPORT_SIZE (8)
-    0x81, 0x03,                    //   INPUT (Cnst,Var,Abs)
     0x95, 0x05,                    //   REPORT_COUNT (5)
     0x75, 0x01,                    //   REPORT_SIZE (1)
     0x05, 0x08,                    //   USAGE_PAGE (LEDs)
@@ -62,15 +105,52 @@ const struct{uint8_t report[HID_RPT01_SIZE];}hid_rpt01={
     0x95, 0x01,                    //   REPORT_COUNT (1)
     0x75, 0x03,                    //   REPORT_SIZE (3)
     0x91, 0x03,                    //   OUTPUT (Cnst,Var,Abs)
-    0x95, 0x06,                    //   REPORT_COUNT (6)
-    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x95, KEYBOARD_USAGE_COUNT,    //   REPORT_COUNT (104)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
     0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
-    0x25, 0x65,                    //   LOGICAL_MAXIMUM (101)
+    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
     0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
     0x19, 0x00,                    //   USAGE_MINIMUM (Reserved (no event indicated))
-    0x29, 0x65,                    //   USAGE_MAXIMUM (Keyboard Application)
+    0x29, KEYBOARD_USAGE_COUNT - 1,//   USAGE_MAXIMUM (Keypad =)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+    0x05, 0x0c,                    // USAGE_PAGE (Consumer Devices)
+    0x09, 0x01,                    // USAGE (Consumer Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, KEYBOARD_REPORT_ID_CONSUMER, //   REPORT_ID (2)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x26, 0xff, 0x03,              //   LOGICAL_MAXIMUM (1023)
+    0x19, 0x00,                    //   USAGE_MINIMUM (Unassigned)
+    0x2a, 0xff, 0x03,              //   USAGE_MAXIMUM (1023)
+    0x75, 0x10,                    //   REPORT_SIZE (16)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
     0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
-    0xc0}                          // End Collection
+    0xc0,                          // END_COLLECTION
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x80,                    // USAGE (System Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, KEYBOARD_REPORT_ID_SYSTEM, //   REPORT_ID (3)
+    0x19, 0x81,                    //   USAGE_MINIMUM (System Power Down)
+    0x29, 0x83,                    //   USAGE_MAXIMUM (System Wake Up)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x95, 0x03,                    //   REPORT_COUNT (3)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0x95, 0x05,                    //   REPORT_COUNT (5)
+    0x81, 0x03,                    //   INPUT (Cnst,Var,Abs)
+    0xc0,                          // END_COLLECTION
+    0x06, 0x00, 0xff,              // USAGE_PAGE (Vendor Defined Page 1)
+    0x09, 0x01,                    // USAGE (Vendor Usage 1)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, KEYBOARD_REPORT_ID_FEATURE, //   REPORT_ID (4)
+    0x09, 0x01,                    //   USAGE (Vendor Usage 1)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x26, 0xff, 0x00,              //   LOGICAL_MAXIMUM (255)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x95, APP_FEATURE_REPORT_SIZE, //   REPORT_COUNT (8)
+    0xb1, 0x02,                    //   FEATURE (Data,Var,Abs)
+    0xc0}                          // END_COLLECTION
 };
 
 
@@ -116,60 +196,76 @@ typedef struct __attribute__((packed))
         } bits;
     } modifiers;
 
-    /* There is one byte of constant data/padding that is specified in the
-     * input report:
-     *
-     *  0x95, 0x01,                    //   REPORT_COUNT (1)
-     *  0x75, 0x08,                    //   REPORT_SIZE (8)
-     *  0x81, 0x03,                    //   INPUT (Cnst,Var,Abs)
-     */
-    unsigned :8;
-
-    /* The last INPUT item in the INPUT report is an array type.  This array
-     * contains an entry for each of the keys that are currently pressed until
-     * the array limit, in this case 6 concurent key presses.
+    /* The last INPUT item in the INPUT report is a bitmap with one bit for
+     * each key, so any number of keys can be down at once (n-key rollover):
      *
-     *  0x95, 0x06,                    //   REPORT_COUNT (6)
-     *  0x75, 0x08,                    //   REPORT_SIZE (8)
+     *  0x95, 0x68,                    //   REPORT_COUNT (104)
+     *  0x75, 0x01,                    //   REPORT_SIZE (1)
      *  0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
-     *  0x25, 0x65,                    //   LOGICAL_MAXIMUM (101)
+     *  0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
      *  0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
      *  0x19, 0x00,                    //   USAGE_MINIMUM (Reserved (no event indicated))
-     *  0x29, 0x65,                    //   USAGE_MAXIMUM (Keyboard Application)
-     *
-     * Report count is 6 indicating that the array has 6 total entries.
-     * Report size is 8 indicating each entry in the array is one byte.
-     * The usage minimum indicates the lowest key value (Reserved/no event)
-     * The usage maximum indicates the highest key value (Application button)
-     * The logical minimum indicates the remapped value for the usage minimum:
-     *   No Event has a logical value of 0.
-     * The logical maximum indicates the remapped value for the usage maximum:
-     *   Application button has a logical value of 101.
-     *
-     * In this case the logical min/max match the usage min/max so the logical
-     * remapping doesn't actually change the values.
-     *
-     * To send a report with the 'a' key pressed (usage value of 0x04, logical
-     * value in this example of 0x04 as well), then the array input would be the
-     * following:
-     *
-     * LSB [0x04][0x00][0x00][0x00][0x00][0x00] MSB
-     *
-     * If the 'b' button was then pressed with the 'a' button still held down,
-     * the report would then look like this:
+     *  0x29, 0x67,                    //   USAGE_MAXIMUM (Keypad =)
+     *  0x81, 0x02,                    //   INPUT (Data,Var,Abs)
      *
-     * LSB [0x04][0x05][0x00][0x00][0x00][0x00] MSB
-     *
-     * If the 'a' button was then released with the 'b' button still held down,
-     * the resulting array would be the following:
-     *
-     * LSB [0x05][0x00][0x00][0x00][0x00][0x00] MSB
-     *
-     * The 'a' key was removed from the array and all other items in the array
-     * were shifted down. */
-    uint8_t keys[6];
+     * Usage n is bit (n & 7) of keys[n >> 3].  To send a report with the
+     * 'a' key pressed (usage 0x04), keys[0] is 0x10; pressing 'b' (usage
+     * 0x05) as well makes it 0x30.  The report is the same size however
+     * many keys are down, and two reports differ exactly where the bits
+     * of a key differ. */
+    uint8_t keys[KEYBOARD_BITMAP_SIZE];
 } KEYBOARD_INPUT_REPORT;
 
+/* The INPUT report sent while the host has selected the boot protocol.
+ * Its layout is fixed by the HID specification, appendix B.1, whatever
+ * the report descriptor says: the modifier byte, a reserved byte and an
+ * array of up to six pressed keys.  If more keys are down every entry
+ * reads KEYBOARD_USAGE_ERROR_ROLL_OVER. */
+typedef struct __attribute__((packed))
+{
+    uint8_t modifiers;
+    unsigned :8;
+    uint8_t keys[KEYBOARD_BOOT_KEY_COUNT];
+} KEYBOARD_BOOT_INPUT_REPORT;
+
+/* The Consumer Control INPUT report: the one consumer usage down, or 0.
+ *
+ *  0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+ *  0x26, 0xff, 0x03,              //   LOGICAL_MAXIMUM (1023)
+ *  0x19, 0x00,                    //   USAGE_MINIMUM (Unassigned)
+ *  0x2a, 0xff, 0x03,              //   USAGE_MAXIMUM (1023)
+ *  0x75, 0x10,                    //   REPORT_SIZE (16)
+ *  0x95, 0x01,                    //   REPORT_COUNT (1)
+ *  0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t reportId;
+    uint16_t usage;
+} KEYBOARD_CONSUMER_REPORT;
+
+/* The System Control INPUT report: bit n for usage 0x81 + n (System
+ * Power Down, System Sleep, System Wake Up). */
+typedef struct __attribute__((packed))
+{
+    uint8_t reportId;
+    uint8_t controls;
+} KEYBOARD_SYSTEM_REPORT;
+
+/* The endpoint buffer holds any of the INPUT reports.  In the report
+ * protocol each starts with its report ID. */
+typedef union
+{
+    struct __attribute__((packed))
+    {
+        uint8_t reportId;
+        KEYBOARD_INPUT_REPORT report;
+    } keyboard;
+    KEYBOARD_BOOT_INPUT_REPORT boot;
+    KEYBOARD_CONSUMER_REPORT consumer;
+    KEYBOARD_SYSTEM_REPORT system;
+} KEYBOARD_INPUT_BUFFER;
+
 
 /* This typedef defines the only OUTPUT report found in the HID report
  * descriptor and gives an easy way to parse the OUTPUT report. */
@@ -215,14 +311,39 @@ typedef union __attribute__((packed))
 } KEYBOARD_OUTPUT_REPORT;
 
 
+/* INPUT reports that can wait on the IN endpoint at once, one in each of
+ * its ping-pong buffers, so a report can be queued while the host has not
+ * taken the one before it yet. */
+#define KEYBOARD_IN_QUEUE_DEPTH     2
+
 /* This creates a storage type for all of the information required to track the
- * current state of the keyboard. */
+ * current state of the keyboard.  nextIN is the queue slot (and input report
+ * buffer) the next INPUT report goes in; the endpoint's buffers are armed in
+ * turn, so its handle is the one of the oldest report still queued. */
 typedef struct
 {
-    USB_HANDLE lastINTransmission;
+    USB_HANDLE lastINTransmission[KEYBOARD_IN_QUEUE_DEPTH];
     USB_HANDLE lastOUTTransmission;
+    uint8_t nextIN;
 } KEYBOARD;
 
+/* Steps of a remote wakeup: the bus must be idle for 5ms before the
+ * device signals resume, and resume is driven for 1-15ms. */
+typedef enum
+{
+    KEYBOARD_RESUME_NONE,
+    KEYBOARD_RESUME_WAIT_IDLE,
+    KEYBOARD_RESUME_SIGNALLING
+} KEYBOARD_RESUME_STATE;
+
+#define KEYBOARD_RESUME_IDLE_MS     5
+#define KEYBOARD_RESUME_SIGNAL_MS   3
+
+/* HID report types, in the high byte of wValue of GET_REPORT and
+ * SET_REPORT requests. */
+#define HID_REPORT_TYPE_OUTPUT      0x02
+#define HID_REPORT_TYPE_FEATURE     0x03
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: File Scope or Global Variables
@@ -230,15 +351,89 @@ typedef struct
 // *****************************************************************************
 static KEYBOARD keyboard;
 
+/* Keys down as of the last key event applied, as a report protocol INPUT
+ * report, and the event overflow count they were last synchronized with. */
+static KEYBOARD_INPUT_REPORT keyReport;
+static uint16_t keyEventOverflow;
+
+/* A key change taken from the chords that waits for the actions it made
+ * the dual-role keys decide, see APP_ChordGetKey(). */
+static uint8_t waitingKey;
+static uint8_t waitingChord;
+static bool waitingDown;
+static bool eventWaiting;
+
+/* keyGeneration counts the changes to keyReport; sentGeneration is its
+ * value when the last INPUT report was sent.  While they differ the
+ * report is dirty and needs sending. */
+static uint8_t keyGeneration;
+static uint8_t sentGeneration;
+
+/* Protocol the last INPUT report was sent in. */
+static uint8_t reportProtocol;
+
+/* Consumer usage and system controls down, and whether they changed
+ * since their report was last sent. */
+static uint16_t consumerUsage;
+static bool consumerPending;
+static uint8_t systemControls;
+static bool systemPending;
+
+/* ID of the INPUT report sent in the last transaction. */
+static uint8_t lastReportId;
+
+/* Idle rate of each INPUT report in 4ms units, set by SET_IDLE, and the
+ * time each report was last sent. */
+static volatile uint8_t idleRate[KEYBOARD_INPUT_REPORT_IDS];
+static uint16_t idleStart[KEYBOARD_INPUT_REPORT_IDS];
+
+/* Report of the playing macro step, and a macro the host asked to start
+ * through the feature report. */
+static KEYBOARD_INPUT_REPORT macroReport;
+static volatile uint8_t macroRequest = APP_MACRO_NONE;
+
+/* Time from the press of a key to the host taking the report carrying
+ * it: a histogram in ms (the last bucket holds everything longer), the
+ * extremes, and the press of each queued report that carries one. */
+#define LATENCY_BUCKETS     16
+
+static uint16_t latencyHistogram[LATENCY_BUCKETS];
+static uint16_t latencySamples;
+static uint8_t latencyMin;
+static uint8_t latencyMax;
+static bool latencyPending[KEYBOARD_IN_QUEUE_DEPTH];
+static uint16_t latencyStart[KEYBOARD_IN_QUEUE_DEPTH];
+static BUTTON latencyButton;
+
+/* Input reports handed to the endpoint and APP_KeyboardTasks() calls
+ * (main loop iterations), counted over one-second windows. */
+static uint16_t reportCount;
+static uint16_t reportRate;
+static uint32_t loopCount;
+static uint32_t loopRate;
+static uint16_t reportWindowStart;
+
+/* Remote wakeup step, and the time it started. */
+static KEYBOARD_RESUME_STATE resumeState = KEYBOARD_RESUME_NONE;
+static uint16_t resumeStart;
+
+/* Vendor feature report, with its report ID first, and the page selected
+ * by the last SET_REPORT. */
+static uint8_t featureReport[1 + APP_FEATURE_REPORT_SIZE];
+static uint8_t featurePage;
+
 #if !defined(KEYBOARD_INPUT_REPORT_DATA_BUFFER_ADDRESS_TAG)
     #define KEYBOARD_INPUT_REPORT_DATA_BUFFER_ADDRESS_TAG
 #endif
-static KEYBOARD_INPUT_REPORT inputReport KEYBOARD_INPUT_REPORT_DATA_BUFFER_ADDRESS_TAG;
+static KEYBOARD_INPUT_BUFFER inputReport[KEYBOARD_IN_QUEUE_DEPTH] KEYBOARD_INPUT_REPORT_DATA_BUFFER_ADDRESS_TAG;
 
 #if !defined(KEYBOARD_OUTPUT_REPORT_DATA_BUFFER_ADDRESS_TAG)
     #define KEYBOARD_OUTPUT_REPORT_DATA_BUFFER_ADDRESS_TAG
 #endif
-static volatile KEYBOARD_OUTPUT_REPORT outputReport KEYBOARD_OUTPUT_REPORT_DATA_BUFFER_ADDRESS_TAG;
+static volatile uint8_t outputBuffer[2] KEYBOARD_OUTPUT_REPORT_DATA_BUFFER_ADDRESS_TAG;
+
+/* The last LED state received. */
+static KEYBOARD_OUTPUT_REPORT outputReport;
 
 
 // *****************************************************************************
@@ -247,17 +442,21 @@ static volatile KEYBOARD_OUTPUT_REPORT outputReport KEYBOARD_OUTPUT_REPORT_DATA_
 // *****************************************************************************
 // *****************************************************************************
 static void APP_KeyboardProcessOutputReport(void);
-
-
-//Exteranl variables declared in other .c files
-extern volatile signed int SOFCounter;
-
-
-//Application variables that need wide scope
-KEYBOARD_INPUT_REPORT oldInputReport;
-signed int keyboardIdleRate;
-signed int LocalSOFCount;
-static signed int OldSOFCount;
+static uint8_t APP_KeyboardScheduleReport(bool keyboardPending);
+static bool APP_KeyboardSendKeys(uint8_t protocol, KEYBOARD_INPUT_BUFFER *buffer);
+static void APP_KeyboardQueueReport(KEYBOARD_INPUT_BUFFER *buffer, uint8_t length);
+static void APP_KeyboardSyncKeys(void);
+static bool APP_KeyboardApplyEvent(uint8_t key, uint8_t chord, bool down);
+static void APP_KeyboardApplyKey(uint8_t key, bool down);
+static void APP_KeyboardApplyAction(KEYMAP_ACTION action, bool down);
+static void APP_KeyboardSetUsage(uint8_t usage, bool down);
+static void APP_KeyboardStopRepeat(void);
+static bool APP_KeyboardSetReportUsage(KEYBOARD_INPUT_REPORT *report, uint8_t usage, bool down);
+static void APP_KeyboardBuildBootReport(KEYBOARD_BOOT_INPUT_REPORT *boot, const KEYBOARD_INPUT_REPORT *report);
+static void APP_KeyboardSendResume(void);
+static void APP_KeyboardRecordLatency(uint16_t latency);
+static void APP_KeyboardClearLatency(void);
+static bool APP_KeyboardIdleExpired(uint8_t reportId, uint16_t now);
 
 
 
@@ -269,34 +468,64 @@ static signed int OldSOFCount;
 // *****************************************************************************
 void APP_KeyboardInit(void)
 {
-    //initialize the variable holding the handle for the last
-    // transmission
-    keyboard.lastINTransmission = 0;
-    
-    //Set the default idle rate to 500ms (until the host sends a SET_IDLE request to change it to a new value)
-    keyboardIdleRate = 500;
+    uint8_t reportId;
 
-    //Copy the (possibly) interrupt context SOFCounter value into a local variable.
-    //Using a while() loop to do this since the SOFCounter isn't necessarily atomically
-    //updated and therefore we need to read it a minimum of twice to ensure we captured the correct value.
-    while(OldSOFCount != SOFCounter)
+    //initialize the variables holding the handles for the last
+    // transmissions, starting with the first buffer
+    keyboard.lastINTransmission[0] = 0;
+    keyboard.lastINTransmission[1] = 0;
+    keyboard.nextIN = 0;
+    
+    //Set the default idle rates (until the host sends a SET_IDLE request to change them),
+    //counted from now.
+    for(reportId = 0; reportId < KEYBOARD_INPUT_REPORT_IDS; reportId++)
     {
-        OldSOFCount = SOFCounter;
+        idleRate[reportId] = 0;
+        idleStart[reportId] = TICK_Get();
     }
+    idleRate[KEYBOARD_REPORT_ID_KEYBOARD] = KEYBOARD_IDLE_DEFAULT;
+
+    //Start from the current key states and drop the events that led to them.
+    APP_KeyboardSyncKeys();
+
+    //A newly configured interface talks the report protocol until the host
+    //selects the boot protocol.
+    USBHIDResetProtocol();
+    reportProtocol = RPT_PROTOCOL;
+
+    //Reports still on the endpoint were lost with the configuration.
+    latencyPending[0] = false;
+    latencyPending[1] = false;
+    latencyButton = BUTTON_NONE;
+    lastReportId = KEYBOARD_REPORT_ID_NONE;
 
     //enable the HID endpoint
     USBEnableEndpoint(HID_EP, USB_IN_ENABLED|USB_OUT_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
 
     //Arm OUT endpoint so we can receive caps lock, num lock, etc. info from host
-    keyboard.lastOUTTransmission = HIDRxPacket(HID_EP,(uint8_t*)&outputReport, sizeof(outputReport) );
+    keyboard.lastOUTTransmission = HIDRxPacket(HID_EP,(uint8_t*)outputBuffer, sizeof(outputBuffer) );
 }
 
 void APP_KeyboardTasks(void)
 {
-    signed int TimeDeltaMilliseconds;
-    unsigned char i;
-    bool needToSendNewReportPacket;
-    int keynum = 0;
+    bool keyboardPending;
+    KEYMAP_ACTION action;
+    bool down;
+    uint8_t usage;
+    uint16_t now;
+    bool live;
+    uint8_t protocol;
+    uint8_t reportId;
+    uint8_t slot;
+    KEYBOARD_INPUT_BUFFER *buffer;
+
+    /* A remote wakeup is signalled a step at a time from here, so the
+     * main loop and the USB interrupt carry on while it is. */
+    if(resumeState != KEYBOARD_RESUME_NONE)
+    {
+        APP_KeyboardSendResume();
+        return;
+    }
 
     /* If the USB device isn't configured yet, we can't really do anything
      * else since we don't have a host to talk to.  So jump back to the
@@ -313,103 +542,176 @@ void APP_KeyboardTasks(void)
     if( USBIsDeviceSuspended()== true )
     {
         //Check if we should assert a remote wakeup request to the USB host,
-        //when the user presses the pushbutton.
-        if(BUTTON_IsPressed(BUTTON_USB_DEVICE_REMOTE_WAKEUP) == 0)
+        //when the user presses the pushbutton.  The scan tick keeps running
+        //while suspended, so the button state is current.
+        if((BUTTON_IsPressed(BUTTON_USB_DEVICE_REMOTE_WAKEUP) == true) &&
+           (USBGetRemoteWakeupStatus() == true) &&
+           (USBIsBusSuspended() == true))
         {
-            //Add code here to issue a resume signal.
+            APP_KeyboardSendResume();
         }
 
         return;
     }
-    
-    //Copy the (possibly) interrupt context SOFCounter value into a local variable.
-    //Using a while() loop to do this since the SOFCounter isn't necessarily atomically
-    //updated and we need to read it a minimum of twice to ensure we captured the correct value.
-    while(LocalSOFCount != SOFCounter)
+
+    loopCount++;
+    now = TICK_Get();
+
+    //Take the key events through the chords, and decide the chords and
+    //dual-role keys whose windows have passed.
+    APP_ChordTasks();
+    APP_TapHoldTasks();
+    if((uint16_t)(now - reportWindowStart) >= 1000)
     {
-        LocalSOFCount = SOFCounter;
+        reportWindowStart = now;
+        reportRate = reportCount;
+        reportCount = 0;
+        loopRate = loopCount;
+        loopCount = 0;
     }
 
-    //Compute the elapsed time since the last input report was sent (we need
-    //this info for properly obeying the HID idle rate set by the host).
-    TimeDeltaMilliseconds = LocalSOFCount - OldSOFCount;
-    //Check for negative value due to count wraparound back to zero.
-    if(TimeDeltaMilliseconds < 0)
+    /* Time the presses whose reports the host has taken.  The queue slots
+     * are checked in the order they were armed. */
+    slot = keyboard.nextIN;
+    do
     {
-        TimeDeltaMilliseconds = (32767 - OldSOFCount) + LocalSOFCount;
-    }
-    //Check if the TimeDelay is quite large.  If the idle rate is == 0 (which represents "infinity"),
-    //then the TimeDeltaMilliseconds could also become infinity (which would cause overflow)
-    //if there is no recent button presses or other changes occurring on the keyboard.
-    //Therefore, saturate the TimeDeltaMilliseconds if it gets too large, by virtue
-    //of updating the OldSOFCount, even if we haven't actually sent a packet recently.
-    if(TimeDeltaMilliseconds > 5000)
+        if((latencyPending[slot] == true) &&
+           (HIDTxHandleBusy(keyboard.lastINTransmission[slot]) == false))
+        {
+            APP_KeyboardRecordLatency(now - latencyStart[slot]);
+            latencyPending[slot] = false;
+        }
+        slot = (slot + 1) % KEYBOARD_IN_QUEUE_DEPTH;
+    } while(slot != keyboard.nextIN);
+
+    /* Check if the next IN buffer is busy, and if it isn't check if we want to send
+     * keystroke data to the host.  The other buffer may still hold a report
+     * the host has not taken yet. */
+    if(HIDTxHandleBusy(keyboard.lastINTransmission[keyboard.nextIN]) == false)
     {
-        OldSOFCount = LocalSOFCount - 5000;
-    }
+        slot = keyboard.nextIN;
+        buffer = &inputReport[slot];
+
+        /* Apply one key event per report, so a press and release that both
+         * happen while the endpoint is busy still produce two reports.  The
+         * actions decided by dual-role keys come before any later event.  If
+         * events were dropped, fall back to the current key states. */
+        if(APP_TapHoldGetAction(&action, &down) == true)
+        {
+            APP_KeyboardApplyAction(action, down);
+        }
+        else if(BUTTON_GetEventOverflowCount() != keyEventOverflow)
+        {
+            APP_KeyboardSyncKeys();
+        }
+        else if((eventWaiting == true) ||
+                (APP_ChordGetKey(&waitingKey, &waitingChord, &waitingDown) == true))
+        {
+            //A chord is timed from the first of its keys pressed, so the time
+            //it was held back counts.
+            eventWaiting = !APP_KeyboardApplyEvent(waitingKey, waitingChord, waitingDown);
+            if((eventWaiting == false) && (waitingDown == true) &&
+               (latencyButton == BUTTON_NONE))
+            {
+                latencyButton = APP_KeymapGetButton(waitingKey);
+            }
+        }
+        else if(idleRate[KEYBOARD_REPORT_ID_KEYBOARD] != 0)
+        {
+            //The host repeats keys itself again.
+            APP_KeyboardStopRepeat();
+        }
+        else if(APP_TypematicGetStep(&usage, &down) == true)
+        {
+            //With nothing else to report, repeat a held key the host does not
+            //repeat itself, as a release and a press in consecutive reports.
+            APP_KeyboardSetUsage(usage, down);
+        }
 
+        //Start a macro the host asked for.
+        if(macroRequest != APP_MACRO_NONE)
+        {
+            APP_MacroStart(macroRequest);
+            macroRequest = APP_MACRO_NONE;
+        }
 
-    /* Check if the IN endpoint is busy, and if it isn't check if we want to send
-     * keystroke data to the host. */
-    if(HIDTxHandleBusy(keyboard.lastINTransmission) == false)
-    {
-        /* Clear the INPUT report buffer.  Set to all zeros. */
-        memset(&inputReport, 0, sizeof(inputReport));
+        //The keys need sending if they changed since the last report.  Key
+        //events keep keyReport up to date, so there is nothing to rebuild or
+        //compare here.  A change of protocol also needs a report in the new
+        //format, and a playing macro has a step for every free transaction.
+        protocol = USBHIDGetProtocol();
+        keyboardPending = (keyGeneration != sentGeneration) ||
+                          (protocol != reportProtocol) ||
+                          (APP_MacroIsPlaying() == true);
 
-        if(BUTTON_IsPressed(BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_0) == true)
+        //Repeat each report the host has set an idle rate for once that
+        //long has passed since it was last sent.
+        if(APP_KeyboardIdleExpired(KEYBOARD_REPORT_ID_KEYBOARD, now) == true)
         {
-            inputReport.keys[keynum++] = 0x04;
+            keyboardPending = true;
         }
-        
-        if(BUTTON_IsPressed(BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_1) == true)
+        if(APP_KeyboardIdleExpired(KEYBOARD_REPORT_ID_CONSUMER, now) == true)
         {
-            inputReport.keys[keynum++] = 0x05;
+            consumerPending = true;
         }
-        
-        if(BUTTON_IsPressed(BUTTON_USB_DEVICE_HID_KEYBOARD_KEY_2) == true)
+        if(APP_KeyboardIdleExpired(KEYBOARD_REPORT_ID_SYSTEM, now) == true)
         {
-            inputReport.keys[keynum++] = 0x06;
+            systemPending = true;
         }
-        
-        //Check to see if the new packet contents are somehow different from the most
-        //recently sent packet contents.
-        needToSendNewReportPacket = false;
-        for(i = 0; i < sizeof(inputReport); i++)
+
+        //Pick the report to send in this transaction, if any.  The boot
+        //protocol only has the keyboard report.
+        if(protocol == BOOT_PROTOCOL)
         {
-            if(*((uint8_t*)&oldInputReport + i) != *((uint8_t*)&inputReport + i))
-            {
-                needToSendNewReportPacket = true;
-                break;
-            }
+            reportId = keyboardPending ? KEYBOARD_REPORT_ID_KEYBOARD : KEYBOARD_REPORT_ID_NONE;
+        }
+        else
+        {
+            reportId = APP_KeyboardScheduleReport(keyboardPending);
         }
 
-        //Check if the host has set the idle rate to something other than 0 (which is effectively "infinite").
-        //If the idle rate is non-infinite, check to see if enough time has elapsed since
-        //the last packet was sent, and it is time to send a new repeated packet or not.
-        if(keyboardIdleRate != 0)
+        live = true;
+        switch(reportId)
         {
-            //Check if the idle rate time limit is met.  If so, need to send another HID input report packet to the host
-            if(TimeDeltaMilliseconds >= keyboardIdleRate)
-            {
-                needToSendNewReportPacket = true;
-            }
+            case KEYBOARD_REPORT_ID_KEYBOARD:
+                live = APP_KeyboardSendKeys(protocol, buffer);
+                break;
+
+            case KEYBOARD_REPORT_ID_CONSUMER:
+                buffer->consumer.reportId = KEYBOARD_REPORT_ID_CONSUMER;
+                buffer->consumer.usage = consumerUsage;
+                consumerPending = false;
+                APP_KeyboardQueueReport(buffer, sizeof(buffer->consumer));
+                break;
+
+            case KEYBOARD_REPORT_ID_SYSTEM:
+                buffer->system.reportId = KEYBOARD_REPORT_ID_SYSTEM;
+                buffer->system.controls = systemControls;
+                systemPending = false;
+                APP_KeyboardQueueReport(buffer, sizeof(buffer->system));
+                break;
+
+            default:
+                break;
         }
 
-        //Now send the new input report packet, if it is appropriate to do so (ex: new data is
-        //present or the idle rate limit was met).
-        if(needToSendNewReportPacket == true)
+        if(reportId != KEYBOARD_REPORT_ID_NONE)
         {
-            //Save the old input report packet contents.  We do this so we can detect changes in report packet content
-            //useful for determining when something has changed and needs to get re-sent to the host when using
-            //infinite idle rate setting.
-            oldInputReport = inputReport;
-
-            /* Send the 8 byte packet over USB to the host. */
-            keyboard.lastINTransmission = HIDTxPacket(HID_EP, (uint8_t*)&inputReport, sizeof(inputReport));
-            OldSOFCount = LocalSOFCount;    //Save the current time, so we know when to send the next packet (which depends in part on the idle rate setting)
+            lastReportId = reportId;
+            idleStart[reportId] = now;
+            reportCount++;
+
+            //Time the first press since the last report by the first report
+            //that carries the live key states.
+            if((live == true) && (latencyButton != BUTTON_NONE))
+            {
+                latencyStart[slot] = BUTTON_GetPressTime(latencyButton);
+                latencyPending[slot] = true;
+                latencyButton = BUTTON_NONE;
+            }
         }
 
-    }//if(HIDTxHandleBusy(keyboard.lastINTransmission) == false)
+    }//if(HIDTxHandleBusy(keyboard.lastINTransmission[keyboard.nextIN]) == false)
 
 
     /* Check if any data was sent from the PC to the keyboard device.  Report
@@ -420,14 +722,444 @@ void APP_KeyboardTasks(void)
      * control transfer on EP0.  See the USBHIDCBSetReportHandler() function. */
     if(HIDRxHandleBusy(keyboard.lastOUTTransmission) == false)
     {
-        APP_KeyboardProcessOutputReport();
+        /* In the report protocol the LED state follows the report ID. */
+        if((USBHIDGetProtocol() == BOOT_PROTOCOL) || (USBHandleGetLength(keyboard.lastOUTTransmission) < sizeof(outputBuffer)))
+        {
+            outputReport.value = outputBuffer[0];
+            APP_KeyboardProcessOutputReport();
+        }
+        else if(outputBuffer[0] == KEYBOARD_REPORT_ID_KEYBOARD)
+        {
+            outputReport.value = outputBuffer[1];
+            APP_KeyboardProcessOutputReport();
+        }
 
-        keyboard.lastOUTTransmission = HIDRxPacket(HID_EP,(uint8_t*)&outputReport,sizeof(outputReport));
+        keyboard.lastOUTTransmission = HIDRxPacket(HID_EP,(uint8_t*)outputBuffer,sizeof(outputBuffer));
     }
     
     return;		
 }
 
+static uint8_t APP_KeyboardScheduleReport(bool keyboardPending)
+{
+    bool pending[KEYBOARD_INPUT_REPORT_IDS];
+    uint8_t reportId;
+
+    pending[KEYBOARD_REPORT_ID_NONE] = false;
+    pending[KEYBOARD_REPORT_ID_KEYBOARD] = keyboardPending;
+    pending[KEYBOARD_REPORT_ID_CONSUMER] = consumerPending;
+    pending[KEYBOARD_REPORT_ID_SYSTEM] = systemPending;
+
+    // highest priority first, but never the same report twice in a row while
+    // another one waits, so no report waits more than one transaction
+    for(reportId = KEYBOARD_REPORT_ID_SYSTEM; reportId != KEYBOARD_REPORT_ID_NONE; reportId--)
+    {
+        if((pending[reportId] == true) && (reportId != lastReportId))
+        {
+            return reportId;
+        }
+    }
+
+    return pending[lastReportId] ? lastReportId : KEYBOARD_REPORT_ID_NONE;
+}
+
+static bool APP_KeyboardSendKeys(uint8_t protocol, KEYBOARD_INPUT_BUFFER *buffer)
+{
+    KEYBOARD_INPUT_REPORT *report;
+    uint8_t modifiers;
+    uint8_t usage;
+
+    //A playing macro sends one step in every keyboard report and holds the
+    //keys back until it is done.  After a macro step the host no longer has
+    //the keys, so they are sent again once it is over.
+    if(APP_MacroNextStep(&modifiers, &usage) == true)
+    {
+        memset(&macroReport, 0, sizeof(macroReport));
+        macroReport.modifiers.value = modifiers;
+        APP_KeyboardSetReportUsage(&macroReport, usage, true);
+        report = &macroReport;
+        sentGeneration = (uint8_t)(keyGeneration - 1);
+    }
+    else
+    {
+        report = &keyReport;
+        sentGeneration = keyGeneration;
+    }
+    reportProtocol = protocol;
+
+    /* Send the packet over USB to the host, in the layout of the
+     * protocol the host selected.  The caller restarts the idle rate
+     * period. */
+    if(protocol == BOOT_PROTOCOL)
+    {
+        APP_KeyboardBuildBootReport(&buffer->boot, report);
+        APP_KeyboardQueueReport(buffer, sizeof(buffer->boot));
+    }
+    else
+    {
+        buffer->keyboard.reportId = KEYBOARD_REPORT_ID_KEYBOARD;
+        buffer->keyboard.report = *report;
+        APP_KeyboardQueueReport(buffer, sizeof(buffer->keyboard));
+    }
+
+    return (report == &keyReport);
+}
+
+static bool APP_KeyboardIdleExpired(uint8_t reportId, uint16_t now)
+{
+    uint8_t rate;
+
+    // 0 is an infinite idle rate.  The millisecond clock wraps every 65s,
+    // far longer than the longest idle rate of 1020ms.
+    rate = idleRate[reportId];
+    if(rate == 0)
+    {
+        return false;
+    }
+    return ((uint16_t)(now - idleStart[reportId]) >= (uint16_t)rate * KEYBOARD_IDLE_UNIT_MS);
+}
+
+static void APP_KeyboardQueueReport(KEYBOARD_INPUT_BUFFER *buffer, uint8_t length)
+{
+    //Arm the endpoint's next ping-pong buffer.  The stack alternates them, so
+    //the report is sent right after the one still queued, if any.
+    keyboard.lastINTransmission[keyboard.nextIN] = HIDTxPacket(HID_EP, (uint8_t*)buffer, length);
+    keyboard.nextIN = (keyboard.nextIN + 1) % KEYBOARD_IN_QUEUE_DEPTH;
+}
+
+static void APP_KeyboardSyncKeys(void)
+{
+    BUTTON_EVENT event;
+    uint8_t key;
+
+    keyEventOverflow = BUTTON_GetEventOverflowCount();
+    while(BUTTON_GetEvent(&event) == true)
+    {
+    }
+    eventWaiting = false;
+
+    APP_KeymapReleaseAll();
+    APP_ChordReset();
+    APP_TapHoldReset();
+    APP_TypematicStop();
+    memset(&keyReport, 0, sizeof(keyReport));
+    keyGeneration++;
+    if(consumerUsage != 0)
+    {
+        consumerUsage = 0;
+        consumerPending = true;
+    }
+    if(systemControls != 0)
+    {
+        systemControls = 0;
+        systemPending = true;
+    }
+    for(key = 0; key < APP_KeymapGetKeyCount(); key++)
+    {
+        if(BUTTON_IsPressed(APP_KeymapGetButton(key)) == true)
+        {
+            APP_KeyboardApplyKey(key, true);
+        }
+    }
+}
+
+static bool APP_KeyboardApplyEvent(uint8_t key, uint8_t chord, bool down)
+{
+    // a press decides the dual-role keys still undecided; their actions go
+    // first, and the key is looked up in the layer they leave
+    if(down && (APP_TapHoldInterrupt(key) == true))
+    {
+        return false;
+    }
+
+    if(chord != KEYMAP_NO_CHORD)
+    {
+        APP_KeyboardApplyAction(APP_KeymapGetChord(chord), down);
+    }
+    else
+    {
+        APP_KeyboardApplyKey(key, down);
+    }
+    return true;
+}
+
+static void APP_KeyboardApplyKey(uint8_t key, bool down)
+{
+    KEYMAP_ACTION action;
+
+    action = down ? APP_KeymapPress(key) : APP_KeymapRelease(key);
+
+    // dual-role keys report what they decide later, through APP_TapHoldGetAction()
+    if(KEYMAP_ACTION_KIND(action) == KEYMAP_KIND_TAP_HOLD)
+    {
+        if(down)
+        {
+            APP_TapHoldPress(KEYMAP_ACTION_ARG(action), key);
+        }
+        else
+        {
+            APP_TapHoldRelease(KEYMAP_ACTION_ARG(action));
+        }
+        return;
+    }
+
+    APP_KeyboardApplyAction(action, down);
+}
+
+static void APP_KeyboardApplyAction(KEYMAP_ACTION action, bool down)
+{
+    uint8_t usage;
+    uint8_t mask;
+
+    switch(KEYMAP_ACTION_KIND(action))
+    {
+        case KEYMAP_KIND_MOMENTARY:
+        case KEYMAP_KIND_TOGGLE:
+            // layer keys report nothing
+            APP_KeymapApplyLayer(action, down);
+            break;
+
+        case KEYMAP_KIND_USAGE:
+            if(action != KEYMAP_NONE)
+            {
+                usage = KEYMAP_ACTION_ARG(action);
+                APP_KeyboardSetUsage(usage, down);
+
+                // another key stops the repeat, as on a PC keyboard
+                if(down && (usage < KEYBOARD_USAGE_LEFT_CONTROL))
+                {
+                    APP_KeyboardStopRepeat();
+                }
+            }
+            break;
+
+        case KEYMAP_KIND_REPEAT:
+            usage = KEYMAP_ACTION_ARG(action);
+            APP_KeyboardSetUsage(usage, down);
+            if(down)
+            {
+                APP_KeyboardStopRepeat();
+                APP_TypematicPress(usage);
+            }
+            else
+            {
+                APP_TypematicRelease(usage);
+            }
+            break;
+
+        case KEYMAP_KIND_MACRO:
+            if(down)
+            {
+                APP_MacroStart(KEYMAP_ACTION_ARG(action));
+            }
+            break;
+
+        case KEYMAP_KIND_CONSUMER:
+            // one consumer usage at a time: the last one pressed
+            usage = KEYMAP_ACTION_ARG(action);
+            if(down)
+            {
+                consumerUsage = usage;
+                consumerPending = true;
+            }
+            else if(consumerUsage == usage)
+            {
+                consumerUsage = 0;
+                consumerPending = true;
+            }
+            break;
+
+        case KEYMAP_KIND_SYSTEM:
+            usage = KEYMAP_ACTION_ARG(action);
+            if((usage >= KEYBOARD_SYSTEM_POWER_DOWN) && (usage <= KEYBOARD_SYSTEM_WAKE_UP))
+            {
+                mask = 1 << (usage - KEYBOARD_SYSTEM_POWER_DOWN);
+                systemControls = down ? (systemControls | mask) : (systemControls & ~mask);
+                systemPending = true;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void APP_KeyboardSetUsage(uint8_t usage, bool down)
+{
+    if(APP_KeyboardSetReportUsage(&keyReport, usage, down) == true)
+    {
+        keyGeneration++;
+    }
+}
+
+static void APP_KeyboardStopRepeat(void)
+{
+    uint8_t usage;
+
+    //The key is still held if the repeat stopped between its release and
+    //its press.
+    usage = APP_TypematicStop();
+    if(usage != 0)
+    {
+        APP_KeyboardSetUsage(usage, true);
+    }
+}
+
+static bool APP_KeyboardSetReportUsage(KEYBOARD_INPUT_REPORT *report, uint8_t usage, bool down)
+{
+    uint8_t *bits;
+    uint8_t mask;
+
+    if(usage >= KEYBOARD_USAGE_LEFT_CONTROL)
+    {
+        bits = &report->modifiers.value;
+        mask = 1 << (usage - KEYBOARD_USAGE_LEFT_CONTROL);
+    }
+    else if((usage != 0) && (usage < KEYBOARD_USAGE_COUNT))
+    {
+        bits = &report->keys[usage >> 3];
+        mask = 1 << (usage & 0x07);
+    }
+    else
+    {
+        return false;
+    }
+
+    if(((*bits & mask) != 0) == down)
+    {
+        return false;
+    }
+
+    *bits ^= mask;
+    return true;
+}
+
+static void APP_KeyboardBuildBootReport(KEYBOARD_BOOT_INPUT_REPORT *boot, const KEYBOARD_INPUT_REPORT *report)
+{
+    uint8_t i;
+    uint8_t bits;
+    uint8_t usage;
+    uint8_t count;
+
+    memset(boot, 0, sizeof(*boot));
+    boot->modifiers = report->modifiers.value;
+
+    count = 0;
+    for(i = 0; i < KEYBOARD_BITMAP_SIZE; i++)
+    {
+        bits = report->keys[i];
+        for(usage = i << 3; bits != 0; usage++, bits >>= 1)
+        {
+            if((bits & 0x01) == 0)
+            {
+                continue;
+            }
+
+            if(count == KEYBOARD_BOOT_KEY_COUNT)
+            {
+                // too many keys for the boot report: report the roll over
+                memset(boot->keys, KEYBOARD_USAGE_ERROR_ROLL_OVER, KEYBOARD_BOOT_KEY_COUNT);
+                return;
+            }
+            boot->keys[count++] = usage;
+        }
+    }
+}
+
+static void APP_KeyboardSendResume(void)
+{
+    uint16_t now = TICK_Get();
+
+    switch(resumeState)
+    {
+        case KEYBOARD_RESUME_NONE:
+            //Leave suspend; the USB interrupt must not see it half done.
+            USBMaskInterrupts();
+            USBSuspendControl = 0;
+            USBBusIsSuspended = false;
+            USBUnmaskInterrupts();
+
+            resumeStart = now;
+            resumeState = KEYBOARD_RESUME_WAIT_IDLE;
+            break;
+
+        case KEYBOARD_RESUME_WAIT_IDLE:
+            //The bus must be idle for at least 5ms before signalling resume;
+            //the host suspends it after 3ms, so wait a little longer to be
+            //sure.
+            if((uint16_t)(now - resumeStart) >= KEYBOARD_RESUME_IDLE_MS)
+            {
+                USBResumeControl = 1;
+                resumeStart = now;
+                resumeState = KEYBOARD_RESUME_SIGNALLING;
+            }
+            break;
+
+        case KEYBOARD_RESUME_SIGNALLING:
+            //Drive resume signalling for 1-15ms, then let the host take over.
+            if((uint16_t)(now - resumeStart) >= KEYBOARD_RESUME_SIGNAL_MS)
+            {
+                USBResumeControl = 0;
+                resumeState = KEYBOARD_RESUME_NONE;
+            }
+            break;
+    }
+}
+
+static void APP_KeyboardRecordLatency(uint16_t latency)
+{
+    uint8_t ms;
+
+    ms = (latency > 0xFF) ? 0xFF : (uint8_t)latency;
+
+    /* The feature report reads these from the USB interrupt. */
+    USBMaskInterrupts();
+
+    if((latencySamples == 0) || (ms < latencyMin))
+    {
+        latencyMin = ms;
+    }
+    if(ms > latencyMax)
+    {
+        latencyMax = ms;
+    }
+    if(latencySamples != 0xFFFF)
+    {
+        latencySamples++;
+        latencyHistogram[(ms < LATENCY_BUCKETS) ? ms : (LATENCY_BUCKETS - 1)]++;
+    }
+
+    USBUnmaskInterrupts();
+}
+
+static void APP_KeyboardClearLatency(void)
+{
+    memset(latencyHistogram, 0, sizeof(latencyHistogram));
+    latencySamples = 0;
+    latencyMin = 0;
+    latencyMax = 0;
+}
+
+static uint8_t APP_KeyboardLatencyPercentile(uint8_t percent)
+{
+    uint16_t rank;
+    uint16_t seen;
+    uint8_t ms;
+
+    // the smallest latency at or below which percent of the samples fall
+    rank = (uint16_t)((((uint32_t)latencySamples * percent) + 99) / 100);
+    seen = 0;
+    for(ms = 0; ms < LATENCY_BUCKETS - 1; ms++)
+    {
+        seen += latencyHistogram[ms];
+        if(seen >= rank)
+        {
+            return ms;
+        }
+    }
+    return LATENCY_BUCKETS - 1;
+}
+
 static void APP_KeyboardProcessOutputReport(void)
 {
     if(outputReport.leds.capsLock)
@@ -442,34 +1174,234 @@ static void APP_KeyboardProcessOutputReport(void)
 
 static void USBHIDCBSetReportComplete(void)
 {
-    /* 1 byte of LED state data should now be in the CtrlTrfData buffer.  Copy
-     * it to the OUTPUT report buffer for processing */
-    outputReport.value = CtrlTrfData[0];
+    /* 1 byte of LED state data should now be in the CtrlTrfData buffer,
+     * after the report ID in the report protocol.  Copy it to the OUTPUT
+     * report for processing */
+    if(USBHIDGetProtocol() == BOOT_PROTOCOL)
+    {
+        outputReport.value = CtrlTrfData[0];
+    }
+    else if(CtrlTrfData[0] == KEYBOARD_REPORT_ID_KEYBOARD)
+    {
+        outputReport.value = CtrlTrfData[1];
+    }
+    else
+    {
+        return;
+    }
 
     /* Process the OUTPUT report. */
     APP_KeyboardProcessOutputReport();
 }
 
+static void APP_KeyboardPutWord(uint8_t *report, uint16_t value)
+{
+    report[0] = (uint8_t)value;
+    report[1] = (uint8_t)(value >> 8);
+}
+
+static void APP_KeyboardGetStatusReport(uint8_t *report)
+{
+    APP_KeyboardPutWord(&report[1], BUTTON_GetEventOverflowCount());
+    #if defined(MATRIX_SCAN_ENABLE)
+    APP_KeyboardPutWord(&report[3], MATRIX_GetGhostCount());
+    #endif
+    APP_KeyboardPutWord(&report[5], reportRate);
+}
+
+static void APP_KeyboardGetLoopReport(uint8_t *report)
+{
+    APP_KeyboardPutWord(&report[1], (uint16_t)loopRate);
+    APP_KeyboardPutWord(&report[3], (uint16_t)(loopRate >> 16));
+    APP_KeyboardPutWord(&report[5], CDCGetMaskedCycles());
+}
+
+static void APP_KeyboardGetLatencyReport(uint8_t *report)
+{
+    if(latencySamples == 0)
+    {
+        return;
+    }
+
+    report[1] = latencyMin;
+    report[2] = APP_KeyboardLatencyPercentile(50);
+    report[3] = APP_KeyboardLatencyPercentile(99);
+    report[4] = latencyMax;
+    APP_KeyboardPutWord(&report[5], latencySamples);
+}
+
+static void APP_KeyboardGetKeyStatsReport(uint8_t *report, BUTTON button)
+{
+    BUTTON_STATS stats;
+
+    BUTTON_GetStats(button, &stats);
+    APP_KeyboardPutWord(&report[1], stats.actuations);
+    APP_KeyboardPutWord(&report[3], stats.edges);
+    APP_KeyboardPutWord(&report[5], stats.bounces);
+    report[7] = stats.longestBounce;
+}
+
+void APP_KeyboardSetFeaturePage(const uint8_t *page)
+{
+    switch(page[0])
+    {
+        case APP_FEATURE_PAGE_SETTINGS:
+            APP_SettingsSetReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_MACRO:
+            macroRequest = page[1];
+            break;
+
+        case APP_FEATURE_PAGE_TYPEMATIC:
+            APP_SettingsSetTypematicReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_CHORD:
+            APP_SettingsSetChordReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_STATUS:
+            if((page[1] & APP_FEATURE_CLEAR_STATS) != 0)
+            {
+                BUTTON_ClearStats();
+                APP_KeyboardClearLatency();
+                APP_ChordClearStats();
+                CDCClearMaskedCycles();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void APP_KeyboardGetFeaturePage(uint8_t *page)
+{
+    switch(page[0])
+    {
+        case APP_FEATURE_PAGE_SETTINGS:
+            APP_SettingsGetReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_STATUS:
+            APP_KeyboardGetStatusReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_LATENCY:
+            APP_KeyboardGetLatencyReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_LOOP:
+            APP_KeyboardGetLoopReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_MACRO:
+            APP_MacroGetReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_TYPEMATIC:
+            APP_SettingsGetTypematicReport(page);
+            break;
+
+        case APP_FEATURE_PAGE_CHORD:
+            APP_SettingsGetChordReport(page);
+            page[3] = APP_ChordGetLongestDelay();
+            break;
+
+        default:
+            if((page[0] > APP_FEATURE_PAGE_KEY_STATS) &&
+               (page[0] <= APP_FEATURE_PAGE_KEY_STATS + BUTTON_R3C3))
+            {
+                APP_KeyboardGetKeyStatsReport(page,
+                    (BUTTON)(page[0] - APP_FEATURE_PAGE_KEY_STATS));
+            }
+            break;
+    }
+}
+
+static void USBHIDCBSetFeatureComplete(void)
+{
+    uint8_t *page;
+
+    /* The feature report follows its report ID in featureReport.  Byte 0
+     * selects the page for this and following GET_REPORT requests. */
+    page = &featureReport[1];
+    featurePage = page[0];
+    APP_KeyboardSetFeaturePage(page);
+}
+
+void USBHIDCBGetReportHandler(void)
+{
+    uint8_t *page;
+
+    /* Only the feature report can be read through the control endpoint;
+     * leaving any other request unhandled makes the stack STALL it. */
+    if((SetupPkt.W_Value.byte.HB != HID_REPORT_TYPE_FEATURE) ||
+       (SetupPkt.W_Value.byte.LB != KEYBOARD_REPORT_ID_FEATURE))
+    {
+        return;
+    }
+
+    memset(featureReport, 0, sizeof(featureReport));
+    featureReport[0] = KEYBOARD_REPORT_ID_FEATURE;
+    page = &featureReport[1];
+    page[0] = featurePage;
+    APP_KeyboardGetFeaturePage(page);
+
+    USBEP0SendRAMPtr(featureReport, sizeof(featureReport), USB_EP0_INCLUDE_ZERO);
+}
+
 void USBHIDCBSetReportHandler(void)
 {
+    /* The feature report with its ID is longer than the endpoint 0 buffer,
+     * so it is received into featureReport. */
+    if(SetupPkt.W_Value.byte.HB == HID_REPORT_TYPE_FEATURE)
+    {
+        if(SetupPkt.W_Value.byte.LB == KEYBOARD_REPORT_ID_FEATURE)
+        {
+            USBEP0Receive(featureReport, sizeof(featureReport), USBHIDCBSetFeatureComplete);
+        }
+        return;
+    }
+
     /* Prepare to receive the keyboard LED state data through a SET_REPORT
      * control transfer on endpoint 0.  The host should only send 1 byte,
-     * since this is all that the report descriptor allows it to send. */
+     * plus the report ID in the report protocol, since this is all that the
+     * report descriptor allows it to send. */
     USBEP0Receive((uint8_t*)&CtrlTrfData, USB_EP0_BUFF_SIZE, USBHIDCBSetReportComplete);
 }
 
 
 //Callback function called by the USB stack, whenever the host sends a new SET_IDLE
-//command.
+//command.  The duration is in 4ms units.
 void USBHIDCBSetIdleRateHandler(uint8_t reportID, uint8_t newIdleRate)
 {
-    //Make sure the report ID matches the keyboard input report id number.
-    //If however the firmware doesn't implement/use report ID numbers,
-    //then it should be == 0.
-    if(reportID == 0)
+    uint8_t i;
+
+    //Report ID 0 sets the idle rate of every input report.
+    if(reportID == KEYBOARD_REPORT_ID_NONE)
+    {
+        for(i = 0; i < KEYBOARD_INPUT_REPORT_IDS; i++)
+        {
+            idleRate[i] = newIdleRate;
+        }
+    }
+    else if(reportID < KEYBOARD_INPUT_REPORT_IDS)
+    {
+        idleRate[reportID] = newIdleRate;
+    }
+}
+
+//Callback function called by the USB stack, whenever the host sends a GET_IDLE
+//command.  Report ID 0 reads the idle rate of the keyboard report.
+uint8_t USBHIDCBGetIdleRateHandler(uint8_t reportID)
+{
+    if((reportID == KEYBOARD_REPORT_ID_NONE) || (reportID >= KEYBOARD_INPUT_REPORT_IDS))
     {
-        keyboardIdleRate = newIdleRate;
+        reportID = KEYBOARD_REPORT_ID_KEYBOARD;
     }
+    return idleRate[reportID];
 }
 
 
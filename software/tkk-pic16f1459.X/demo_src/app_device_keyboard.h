@@ -20,7 +20,88 @@ please contact mla_licensing@microchip.com
 #ifndef KEYBOARD_H
 #define KEYBOARD_H
 
+#include <stdint.h>
+
+/* The vendor feature report is APP_FEATURE_REPORT_SIZE bytes after its
+ * report ID, 4.  Byte 0 selects a page; a SET_REPORT selects its page for
+ * the GET_REPORTs that follow it.  16-bit values are sent low byte
+ * first. */
+#define APP_FEATURE_REPORT_SIZE     8
+
+/* Settings, see app_settings.h. */
+#define APP_FEATURE_PAGE_SETTINGS   0x00
+
+/* Status: [1..2] key events dropped, [3..4] ambiguous (ghost) matrix
+ * scans, [5..6] input reports sent in the last second.  A SET_REPORT
+ * with [1] = APP_FEATURE_CLEAR_STATS clears the key statistics, the
+ * latency figures, the longest chord hold back and the longest masked
+ * window. */
+#define APP_FEATURE_PAGE_STATUS     0x01
+#define APP_FEATURE_CLEAR_STATS     0x01
+
+/* Latency from the press of a key to the host taking the input report
+ * that carries it, in ms: [1] minimum, [2] median, [3] 99th percentile,
+ * [4] maximum, [5..6] presses timed.  The percentiles read 15 for
+ * anything of 15 ms or more.  All zero until a press has been timed. */
+#define APP_FEATURE_PAGE_LATENCY    0x02
+
+/* Main loop: [1..4] iterations in the last second.  The instruction
+ * cycles per iteration are the 12 MHz instruction clock divided by it.
+ * [5..6] the longest the CDC driver has kept the USB interrupt masked,
+ * in instruction cycles, counting any scan tick serviced meanwhile;
+ * that long an SOF waits to be seen.  Cleared with the key statistics. */
+#define APP_FEATURE_PAGE_LOOP       0x03
+
+/* Macros, see app_macro.h.  A SET_REPORT starts a macro, so a host can
+ * check the text it types. */
+#define APP_FEATURE_PAGE_MACRO      0x04
+
+/* Typematic repeat on the device, see app_settings.h. */
+#define APP_FEATURE_PAGE_TYPEMATIC  0x05
+
+/* Chords, see app_settings.h. */
+#define APP_FEATURE_PAGE_CHORD      0x06
+
+/* Statistics of one key, page APP_FEATURE_PAGE_KEY_STATS + BUTTON:
+ * [1..2] actuations, [3..4] raw edges, [5..6] bounces rejected by the
+ * debouncer, [7] longest bounce in ms. */
+#define APP_FEATURE_PAGE_KEY_STATS  0x10
+
 void APP_KeyboardInit(void);
 void APP_KeyboardTasks(void);
 
+/*********************************************************************
+* Function: void APP_KeyboardGetFeaturePage(uint8_t *page);
+*
+* Overview: Fills in a page of the vendor feature report, as a GET_REPORT
+*           reads it.  Call from the interrupt or with GIE cleared: the
+*           pages touch state the scan tick uses too.
+*
+* PreCondition: None
+*
+* Input: uint8_t *page - the feature report after its report ID; byte 0
+*                        selects the page, the others must be 0
+*
+* Output: None
+*
+********************************************************************/
+void APP_KeyboardGetFeaturePage(uint8_t *page);
+
+/*********************************************************************
+* Function: void APP_KeyboardSetFeaturePage(const uint8_t *page);
+*
+* Overview: Acts on a page of the vendor feature report, as a SET_REPORT
+*           writes it.  Call from the interrupt or with GIE cleared: the
+*           pages touch state the scan tick uses too.
+*
+* PreCondition: None
+*
+* Input: const uint8_t *page - the feature report after its report ID;
+*                              byte 0 selects the page
+*
+* Output: None
+*
+********************************************************************/
+void APP_KeyboardSetFeaturePage(const uint8_t *page);
+
 #endif
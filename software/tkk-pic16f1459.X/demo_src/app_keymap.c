@@ -0,0 +1,409 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "system.h"
+#include "app_keymap.h"
+
+/* The keymap of each board: one KEY(button, layer 0, layer 1) line per
+ * key, in key number order, one TAP_HOLD(tap, hold, double tap) line per
+ * dual-role key, in KEYMAP_TAP_HOLD() number order, and one CHORD(keys,
+ * action) line per chord, see app_chord.h.  The tables below are
+ * generated from them. */
+#if defined(MATRIX_SCAN_ENABLE)
+/* 4x4 matrix: a numeric keypad.  Holding the bottom right key selects a
+ * navigation layer, in which the top right key locks that layer on (or
+ * off again), the middle key types macro 0, and the right column and
+ * bottom left keys are media and sleep keys.  Tapping the bottom right
+ * key is Backspace.  The arrows and Delete repeat on the device. */
+#define KEYMAP_DESCRIPTION(KEY) \
+    KEY(BUTTON_R0C0, KEYMAP_USAGE(0x5F), KEYMAP_USAGE(0x4A))    /* 7      Home      */ \
+    KEY(BUTTON_R0C1, KEYMAP_USAGE(0x60), KEYMAP_REPEAT(0x52))   /* 8      Up        */ \
+    KEY(BUTTON_R0C2, KEYMAP_USAGE(0x61), KEYMAP_USAGE(0x4B))    /* 9      Page Up   */ \
+    KEY(BUTTON_R0C3, KEYMAP_USAGE(0x54), KEYMAP_TOGGLE(1))      /* /      layer 1   */ \
+    KEY(BUTTON_R1C0, KEYMAP_USAGE(0x5C), KEYMAP_REPEAT(0x50))   /* 4      Left      */ \
+    KEY(BUTTON_R1C1, KEYMAP_USAGE(0x5D), KEYMAP_MACRO(0))       /* 5      macro 0   */ \
+    KEY(BUTTON_R1C2, KEYMAP_USAGE(0x5E), KEYMAP_REPEAT(0x4F))   /* 6      Right     */ \
+    KEY(BUTTON_R1C3, KEYMAP_USAGE(0x55), KEYMAP_CONSUMER(0xE2)) /* *      Mute      */ \
+    KEY(BUTTON_R2C0, KEYMAP_USAGE(0x59), KEYMAP_USAGE(0x4D))    /* 1      End       */ \
+    KEY(BUTTON_R2C1, KEYMAP_USAGE(0x5A), KEYMAP_REPEAT(0x51))   /* 2      Down      */ \
+    KEY(BUTTON_R2C2, KEYMAP_USAGE(0x5B), KEYMAP_USAGE(0x4E))    /* 3      Page Down */ \
+    KEY(BUTTON_R2C3, KEYMAP_USAGE(0x56), KEYMAP_CONSUMER(0xCD)) /* -      Play/Pause*/ \
+    KEY(BUTTON_R3C0, KEYMAP_USAGE(0x62), KEYMAP_SYSTEM(0x82))   /* 0      Sleep     */ \
+    KEY(BUTTON_R3C1, KEYMAP_USAGE(0x63), KEYMAP_REPEAT(0x4C))   /* .      Delete    */ \
+    KEY(BUTTON_R3C2, KEYMAP_USAGE(0x58), KEYMAP_USAGE(0x2B))    /* Enter  Tab       */ \
+    KEY(BUTTON_R3C3, KEYMAP_TAP_HOLD(0), KEYMAP_TAP_HOLD(0))    /* tap-hold 0       */
+#define KEYMAP_TAP_HOLD_DESCRIPTION(TAP_HOLD) \
+    TAP_HOLD(KEYMAP_USAGE(0x2A), KEYMAP_MOMENTARY(1), KEYMAP_NONE)  /* Backspace, layer 1 */
+#define KEYMAP_CHORD_DESCRIPTION(CHORD)
+#elif defined(KEYMAP_BOARD_ONE_KEY)
+/* Tap for Enter, hold for Shift, double tap for macro 0. */
+#define KEYMAP_DESCRIPTION(KEY) \
+    KEY(BUTTON_S1, KEYMAP_TAP_HOLD(0), KEYMAP_TAP_HOLD(0))      /* tap-hold 0       */
+#define KEYMAP_TAP_HOLD_DESCRIPTION(TAP_HOLD) \
+    TAP_HOLD(KEYMAP_USAGE(0x28), KEYMAP_USAGE(0xE1), KEYMAP_MACRO(0))   /* Enter, Shift, macro 0 */
+#define KEYMAP_CHORD_DESCRIPTION(CHORD)
+#elif defined(KEYMAP_BOARD_THREE_KEY)
+/* a and c double as Shift and Control when held; a double tap of c is
+ * Enter.  b repeats on the device.  Pressing two keys together types d,
+ * e or f, and all three Escape. */
+#define KEYMAP_DESCRIPTION(KEY) \
+    KEY(BUTTON_S1, KEYMAP_TAP_HOLD(0), KEYMAP_TAP_HOLD(0))      /* tap-hold 0       */ \
+    KEY(BUTTON_S2, KEYMAP_REPEAT(0x05), KEYMAP_REPEAT(0x05))    /* b                */ \
+    KEY(BUTTON_S3, KEYMAP_TAP_HOLD(1), KEYMAP_TAP_HOLD(1))      /* tap-hold 1       */
+#define KEYMAP_TAP_HOLD_DESCRIPTION(TAP_HOLD) \
+    TAP_HOLD(KEYMAP_USAGE(0x04), KEYMAP_USAGE(0xE1), KEYMAP_NONE)           /* a, Shift          */ \
+    TAP_HOLD(KEYMAP_USAGE(0x06), KEYMAP_USAGE(0xE0), KEYMAP_USAGE(0x28))    /* c, Control, Enter */
+#define KEYMAP_CHORD_DESCRIPTION(CHORD) \
+    CHORD(KEYMAP_KEY(0) | KEYMAP_KEY(1), KEYMAP_USAGE(0x07))                  /* S1 S2     d      */ \
+    CHORD(KEYMAP_KEY(1) | KEYMAP_KEY(2), KEYMAP_USAGE(0x08))                  /* S2 S3     e      */ \
+    CHORD(KEYMAP_KEY(0) | KEYMAP_KEY(2), KEYMAP_USAGE(0x09))                  /* S1 S3     f      */ \
+    CHORD(KEYMAP_KEY(0) | KEYMAP_KEY(1) | KEYMAP_KEY(2), KEYMAP_USAGE(0x29))  /* S1 S2 S3  Escape */
+#elif defined(KEYMAP_BOARD_BIG_RED_BUTTON)
+/* Tap for Escape, double tap for Play/Pause. */
+#define KEYMAP_DESCRIPTION(KEY) \
+    KEY(BUTTON_S1, KEYMAP_TAP_HOLD(0), KEYMAP_TAP_HOLD(0))      /* tap-hold 0       */
+#define KEYMAP_TAP_HOLD_DESCRIPTION(TAP_HOLD) \
+    TAP_HOLD(KEYMAP_USAGE(0x29), KEYMAP_NONE, KEYMAP_CONSUMER(0xCD))    /* Escape, -, Play/Pause */
+#define KEYMAP_CHORD_DESCRIPTION(CHORD)
+#else
+#error "No keymap board selected in app_keymap.h"
+#endif
+
+#if KEYMAP_LAYERS != 2
+#error "The keymap descriptions have two layers"
+#endif
+
+#define KEYMAP_BUTTON(button, layer0, layer1)   button,
+#define KEYMAP_LAYER_0(button, layer0, layer1)  layer0,
+#define KEYMAP_LAYER_1(button, layer0, layer1)  layer1,
+#define KEYMAP_TAP_HOLD_ENTRY(tap, hold, doubleTap) { tap, hold, doubleTap },
+#define KEYMAP_CHORD_ENTRY(keys, action)            { keys, action },
+
+/* A chord: the keys pressed together and what they do. */
+typedef struct
+{
+    KEYMAP_KEYS keys;
+    KEYMAP_ACTION action;
+} KEYMAP_CHORD;
+
+/* Button of each key number. */
+static const BUTTON keymapButton[] = { KEYMAP_DESCRIPTION(KEYMAP_BUTTON) };
+
+#define KEYMAP_KEY_COUNT    (sizeof(keymapButton) / sizeof(keymapButton[0]))
+
+/* Action of each key in each layer, in program memory. */
+static const KEYMAP_ACTION keymap[KEYMAP_LAYERS][KEYMAP_KEY_COUNT] =
+{
+    { KEYMAP_DESCRIPTION(KEYMAP_LAYER_0) },
+    { KEYMAP_DESCRIPTION(KEYMAP_LAYER_1) }
+};
+
+/* Actions of each dual-role key, by KEYMAP_ROLE; unused entries are all
+ * KEYMAP_NONE. */
+static const KEYMAP_ACTION keymapTapHold[KEYMAP_TAP_HOLDS][KEYMAP_ROLES] =
+{
+    KEYMAP_TAP_HOLD_DESCRIPTION(KEYMAP_TAP_HOLD_ENTRY)
+};
+
+/* Chords, ended by an entry with no keys so a board can have none. */
+static const KEYMAP_CHORD keymapChord[] =
+{
+    KEYMAP_CHORD_DESCRIPTION(KEYMAP_CHORD_ENTRY)
+    { 0, KEYMAP_NONE }
+};
+
+#define KEYMAP_CHORD_COUNT  (sizeof(keymapChord) / sizeof(keymapChord[0]) - 1)
+
+/* Action each key that is down was pressed with. */
+static KEYMAP_ACTION keyAction[KEYMAP_KEY_COUNT];
+
+/* Momentary layer keys holding each layer, layers switched on by toggle
+ * layer keys (bit n for layer n), and the layer they select. */
+static uint8_t layerHeld[KEYMAP_LAYERS];
+static uint8_t layerToggled;
+static uint8_t activeLayer;
+
+static void APP_KeymapUpdateLayer(void)
+{
+    uint8_t layer;
+
+    activeLayer = 0;
+    for(layer = 1; layer < KEYMAP_LAYERS; layer++)
+    {
+        if((layerHeld[layer] != 0) || ((layerToggled & (1 << layer)) != 0))
+        {
+            activeLayer = layer;
+        }
+    }
+}
+
+/*********************************************************************
+* Function: uint8_t APP_KeymapGetKeyCount(void);
+*
+* Overview: Returns the number of keys in the keymap.  Keys are numbered
+*           from 0.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: number of keys
+*
+********************************************************************/
+uint8_t APP_KeymapGetKeyCount(void)
+{
+    return KEYMAP_KEY_COUNT;
+}
+
+/*********************************************************************
+* Function: BUTTON APP_KeymapGetButton(uint8_t key);
+*
+* Overview: Returns the button of a key.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number
+*
+* Output: the button read for the key
+*
+********************************************************************/
+BUTTON APP_KeymapGetButton(uint8_t key)
+{
+    return keymapButton[key];
+}
+
+/*********************************************************************
+* Function: uint8_t APP_KeymapFindKey(BUTTON button);
+*
+* Overview: Returns the key number of a button.
+*
+* PreCondition: None
+*
+* Input: BUTTON button - the button to look up
+*
+* Output: key number, or KEYMAP_NO_KEY if the button has no key
+*
+********************************************************************/
+uint8_t APP_KeymapFindKey(BUTTON button)
+{
+    uint8_t key;
+
+    for(key = 0; key < KEYMAP_KEY_COUNT; key++)
+    {
+        if(keymapButton[key] == button)
+        {
+            return key;
+        }
+    }
+    return KEYMAP_NO_KEY;
+}
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapPress(uint8_t key);
+*
+* Overview: Looks up the action of a key that was pressed in the active
+*           layer.  The action is kept until the key is released, so a
+*           layer change while the key is down does not change what its
+*           release does.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number
+*
+* Output: the action of the key
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapPress(uint8_t key)
+{
+    keyAction[key] = keymap[activeLayer][key];
+    return keyAction[key];
+}
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapRelease(uint8_t key);
+*
+* Overview: Returns the action taken by the press of a key that was
+*           released.
+*
+* PreCondition: None
+*
+* Input: uint8_t key - key number
+*
+* Output: the action the key was pressed with
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapRelease(uint8_t key)
+{
+    KEYMAP_ACTION action;
+
+    action = keyAction[key];
+    keyAction[key] = KEYMAP_NONE;
+    return action;
+}
+
+/*********************************************************************
+* Function: void APP_KeymapApplyLayer(KEYMAP_ACTION action, bool down);
+*
+* Overview: Acts on the press or release of a layer key.  Other actions
+*           are ignored.
+*
+* PreCondition: None
+*
+* Input: KEYMAP_ACTION action - the action pressed or released
+*        bool down - true for a press
+*
+* Output: None
+*
+********************************************************************/
+void APP_KeymapApplyLayer(KEYMAP_ACTION action, bool down)
+{
+    uint8_t layer;
+
+    layer = KEYMAP_ACTION_ARG(action);
+    if(layer >= KEYMAP_LAYERS)
+    {
+        return;
+    }
+
+    switch(KEYMAP_ACTION_KIND(action))
+    {
+        case KEYMAP_KIND_MOMENTARY:
+            if(down)
+            {
+                layerHeld[layer]++;
+            }
+            else if(layerHeld[layer] != 0)
+            {
+                layerHeld[layer]--;
+            }
+            APP_KeymapUpdateLayer();
+            break;
+
+        case KEYMAP_KIND_TOGGLE:
+            if(down)
+            {
+                layerToggled ^= (1 << layer);
+                APP_KeymapUpdateLayer();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapGetTapHold(uint8_t tapHold,
+*                                             uint8_t role);
+*
+* Overview: Returns one of the actions of a dual-role key.
+*
+* PreCondition: None
+*
+* Input: uint8_t tapHold - argument of the KEYMAP_TAP_HOLD() action
+*        uint8_t role - KEYMAP_ROLE_TAP, _HOLD or _DOUBLE_TAP
+*
+* Output: the action, or KEYMAP_NONE if the key has none for the role
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapGetTapHold(uint8_t tapHold, uint8_t role)
+{
+    if((tapHold >= KEYMAP_TAP_HOLDS) || (role >= KEYMAP_ROLES))
+    {
+        return KEYMAP_NONE;
+    }
+    return keymapTapHold[tapHold][role];
+}
+
+/*********************************************************************
+* Function: uint8_t APP_KeymapGetChordCount(void);
+*
+* Overview: Returns the number of chords in the keymap.  Chords are
+*           numbered from 0.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: number of chords
+*
+********************************************************************/
+uint8_t APP_KeymapGetChordCount(void)
+{
+    return KEYMAP_CHORD_COUNT;
+}
+
+/*********************************************************************
+* Function: KEYMAP_KEYS APP_KeymapGetChordKeys(uint8_t chord);
+*
+* Overview: Returns the keys pressed together for a chord.
+*
+* PreCondition: None
+*
+* Input: uint8_t chord - chord number
+*
+* Output: the keys of the chord
+*
+********************************************************************/
+KEYMAP_KEYS APP_KeymapGetChordKeys(uint8_t chord)
+{
+    return keymapChord[chord].keys;
+}
+
+/*********************************************************************
+* Function: KEYMAP_ACTION APP_KeymapGetChord(uint8_t chord);
+*
+* Overview: Returns the action of a chord.  Chords do not change with
+*           the layer.
+*
+* PreCondition: None
+*
+* Input: uint8_t chord - chord number
+*
+* Output: the action of the chord
+*
+********************************************************************/
+KEYMAP_ACTION APP_KeymapGetChord(uint8_t chord)
+{
+    return keymapChord[chord].action;
+}
+
+/*********************************************************************
+* Function: void APP_KeymapReleaseAll(void);
+*
+* Overview: Forgets every key that is down and every momentary layer.
+*           Toggled layers stay on.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void APP_KeymapReleaseAll(void)
+{
+    memset(keyAction, 0, sizeof(keyAction));
+    memset(layerHeld, 0, sizeof(layerHeld));
+    APP_KeymapUpdateLayer();
+}
@@ -24,7 +24,7 @@ please contact mla_licensing@microchip.com
 *           A fast blink indicates successfully connected.  A slow pulse
 *           indicates that it is still in the process of connecting.  Off
 *           indicates thta it is not attached to the bus or the bus is suspended.
-*           This should be called on every start of frame packet reception and
+*           This should be called every millisecond from the scan tick and
 *           if a suspend/resume event occurs.
 *
 * PreCondition: LEDs are enabled.
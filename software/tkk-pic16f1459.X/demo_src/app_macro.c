@@ -0,0 +1,244 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "system.h"
+#include "usb.h"
+#include "tick.h"
+#include "app_macro.h"
+
+/* The macros, numbered from 0.  Printable ASCII, '\n' (Enter), '\t'
+ * (Tab) and '\b' (Backspace) are typed on a US keyboard layout; any
+ * other character is skipped. */
+static const char macro0[] = "Hello from the tiny keyboard!\n";
+
+static const char * const macros[] =
+{
+    macro0
+};
+
+#define APP_MACRO_COUNT     (sizeof(macros) / sizeof(macros[0]))
+
+/* Keyboard page usage of each printable ASCII character, ' ' to '~',
+ * with APP_MACRO_SHIFT set for the characters typed with Shift. */
+#define APP_MACRO_SHIFT     0x80
+#define S(usage)            ((usage) | APP_MACRO_SHIFT)
+
+static const uint8_t asciiUsage[] =
+{
+    0x2C, S(0x1E), S(0x34), S(0x20), S(0x21), S(0x22), S(0x24), 0x34,       // sp ! " # $ % & '
+    S(0x26), S(0x27), S(0x25), S(0x2E), 0x36, 0x2D, 0x37, 0x38,             // ( ) * + , - . /
+    0x27, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24,                         // 0 1 2 3 4 5 6 7
+    0x25, 0x26, S(0x33), 0x33, S(0x36), 0x2E, S(0x37), S(0x38),             // 8 9 : ; < = > ?
+    S(0x1F), S(0x04), S(0x05), S(0x06), S(0x07), S(0x08), S(0x09), S(0x0A), // @ A B C D E F G
+    S(0x0B), S(0x0C), S(0x0D), S(0x0E), S(0x0F), S(0x10), S(0x11), S(0x12), // H I J K L M N O
+    S(0x13), S(0x14), S(0x15), S(0x16), S(0x17), S(0x18), S(0x19), S(0x1A), // P Q R S T U V W
+    S(0x1B), S(0x1C), S(0x1D), 0x2F, 0x31, 0x30, S(0x23), S(0x2D),          // X Y Z [ \ ] ^ _
+    0x35, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,                         // ` a b c d e f g
+    0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12,                         // h i j k l m n o
+    0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A,                         // p q r s t u v w
+    0x1B, 0x1C, 0x1D, S(0x2F), S(0x31), S(0x30), S(0x35)                    // x y z { | } ~
+};
+
+#undef S
+
+/* Left Shift in the modifier byte. */
+#define APP_MACRO_MODIFIER_SHIFT    0x02
+
+/* Macro playing, the next character and whether its release is next. */
+static uint8_t macroPlaying = APP_MACRO_NONE;
+static const char *macroText;
+static bool macroReleaseNext;
+
+/* Characters typed, and the start time and rate of the last macro. */
+static uint16_t macroCharacters;
+static uint16_t macroStart;
+static uint16_t macroLength;
+static uint16_t macroRate;
+
+static uint8_t APP_MacroUsage(char c)
+{
+    if((c >= ' ') && (c <= '~'))
+    {
+        return asciiUsage[c - ' '];
+    }
+
+    switch(c)
+    {
+        case '\n':
+            return 0x28;
+        case '\t':
+            return 0x2B;
+        case '\b':
+            return 0x2A;
+        default:
+            return 0;
+    }
+}
+
+static void APP_MacroFinish(void)
+{
+    uint16_t elapsed;
+
+    elapsed = TICK_Get() - macroStart;
+
+    // the feature report reads these from the USB interrupt
+    USBMaskInterrupts();
+    macroRate = (elapsed == 0) ? 0 :
+        (uint16_t)(((uint32_t)macroLength * 1000) / elapsed);
+    macroPlaying = APP_MACRO_NONE;
+    USBUnmaskInterrupts();
+}
+
+/*********************************************************************
+* Function: bool APP_MacroStart(uint8_t macro);
+*
+* Overview: Starts typing a macro.
+*
+* PreCondition: None
+*
+* Input: uint8_t macro - macro number, the argument of KEYMAP_MACRO()
+*
+* Output: true if started; false if there is no such macro or one is
+*         already playing
+*
+********************************************************************/
+bool APP_MacroStart(uint8_t macro)
+{
+    if((macro >= APP_MACRO_COUNT) || (macroPlaying != APP_MACRO_NONE))
+    {
+        return false;
+    }
+
+    macroText = macros[macro];
+    macroReleaseNext = false;
+    macroLength = 0;
+    macroStart = TICK_Get();
+    macroPlaying = macro;
+    return true;
+}
+
+/*********************************************************************
+* Function: bool APP_MacroIsPlaying(void);
+*
+* Overview: Returns whether a macro has steps left to report.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: true while a macro is playing
+*
+********************************************************************/
+bool APP_MacroIsPlaying(void)
+{
+    return (macroPlaying != APP_MACRO_NONE);
+}
+
+/*********************************************************************
+* Function: bool APP_MacroNextStep(uint8_t *modifiers, uint8_t *usage);
+*
+* Overview: Returns the next report of the playing macro.  Each
+*           character is a report with its key pressed followed by a
+*           report with every key released, so repeated characters are
+*           typed twice.
+*
+* PreCondition: None
+*
+* Input: uint8_t *modifiers - receives the modifier byte
+*        uint8_t *usage - receives the Keyboard page usage, 0 for none
+*
+* Output: false if no macro is playing
+*
+********************************************************************/
+bool APP_MacroNextStep(uint8_t *modifiers, uint8_t *usage)
+{
+    uint8_t code;
+
+    if(macroPlaying == APP_MACRO_NONE)
+    {
+        return false;
+    }
+
+    *modifiers = 0;
+    *usage = 0;
+
+    if(macroReleaseNext == true)
+    {
+        macroReleaseNext = false;
+        if(*macroText == '\0')
+        {
+            APP_MacroFinish();
+        }
+        return true;
+    }
+
+    // skip characters that cannot be typed
+    code = 0;
+    while((*macroText != '\0') && (code == 0))
+    {
+        code = APP_MacroUsage(*macroText++);
+    }
+
+    if(code == 0)
+    {
+        // nothing left but untypeable characters: the last report was a
+        // release already
+        APP_MacroFinish();
+        return true;
+    }
+
+    if((code & APP_MACRO_SHIFT) != 0)
+    {
+        *modifiers = APP_MACRO_MODIFIER_SHIFT;
+    }
+    *usage = (uint8_t)(code & 0x7F);
+    macroReleaseNext = true;
+
+    macroLength++;
+    if(macroCharacters != 0xFFFF)
+    {
+        macroCharacters++;
+    }
+    return true;
+}
+
+/*********************************************************************
+* Function: void APP_MacroGetReport(uint8_t *report);
+*
+* Overview: Fills in the macro page of the feature report.
+*
+* PreCondition: None
+*
+* Input: uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_MacroGetReport(uint8_t *report)
+{
+    report[1] = macroPlaying;
+    report[2] = (uint8_t)macroCharacters;
+    report[3] = (uint8_t)(macroCharacters >> 8);
+    report[4] = (uint8_t)macroRate;
+    report[5] = (uint8_t)(macroRate >> 8);
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef APP_MACRO_H
+#define APP_MACRO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Macro page of the vendor feature report (APP_FEATURE_PAGE_MACRO):
+ *   [1] macro playing, or APP_MACRO_NONE; SET_REPORT: macro to start
+ *   [2..3] characters typed by macros since reset
+ *   [4..5] characters per second of the last macro that finished */
+#define APP_MACRO_NONE              0xFF
+
+/*********************************************************************
+* Function: bool APP_MacroStart(uint8_t macro);
+*
+* Overview: Starts typing a macro.
+*
+* PreCondition: None
+*
+* Input: uint8_t macro - macro number, the argument of KEYMAP_MACRO()
+*
+* Output: true if started; false if there is no such macro or one is
+*         already playing
+*
+********************************************************************/
+bool APP_MacroStart(uint8_t macro);
+
+/*********************************************************************
+* Function: bool APP_MacroIsPlaying(void);
+*
+* Overview: Returns whether a macro has steps left to report.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: true while a macro is playing
+*
+********************************************************************/
+bool APP_MacroIsPlaying(void);
+
+/*********************************************************************
+* Function: bool APP_MacroNextStep(uint8_t *modifiers, uint8_t *usage);
+*
+* Overview: Returns the next report of the playing macro.  Each
+*           character is a report with its key pressed followed by a
+*           report with every key released, so repeated characters are
+*           typed twice.
+*
+* PreCondition: None
+*
+* Input: uint8_t *modifiers - receives the modifier byte
+*        uint8_t *usage - receives the Keyboard page usage, 0 for none
+*
+* Output: false if no macro is playing
+*
+********************************************************************/
+bool APP_MacroNextStep(uint8_t *modifiers, uint8_t *usage);
+
+/*********************************************************************
+* Function: void APP_MacroGetReport(uint8_t *report);
+*
+* Overview: Fills in the macro page of the feature report.
+*
+* PreCondition: None
+*
+* Input: uint8_t *report - the feature report
+*
+* Output: None
+*
+********************************************************************/
+void APP_MacroGetReport(uint8_t *report);
+
+#endif //APP_MACRO_H
@@ -0,0 +1,211 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "system.h"
+#include "tick.h"
+#include "app_typematic.h"
+
+/* Modifier usages; they never repeat. */
+#define TYPEMATIC_USAGE_LEFT_CONTROL    0xE0
+
+/* Timing, see APP_TypematicSetTiming(). */
+static volatile bool typematicOn = true;
+static volatile uint8_t typematicDelay = APP_TYPEMATIC_DELAY_DEFAULT;
+static volatile uint8_t typematicInterval = APP_TYPEMATIC_INTERVAL_DEFAULT;
+static volatile uint8_t typematicMinInterval = APP_TYPEMATIC_MIN_INTERVAL_DEFAULT;
+static volatile uint8_t typematicAcceleration = APP_TYPEMATIC_ACCELERATION_DEFAULT;
+
+/* Key repeating (0 for none), whether its press is the next step, the
+ * wait for the next release step from repeatStart, and the interval the
+ * repeat after that uses. */
+static uint8_t repeatUsage;
+static bool repeatPressNext;
+static uint16_t repeatStart;
+static uint16_t repeatWait;
+static uint8_t repeatInterval;
+
+/*********************************************************************
+* Function: void APP_TypematicSetTiming(bool on, uint8_t delay,
+*                                       uint8_t interval,
+*                                       uint8_t minInterval,
+*                                       uint8_t acceleration);
+*
+* Overview: Turns the repeat on or off and sets its timing.  May be
+*           called in interrupt context.
+*
+* PreCondition: None
+*
+* Input: bool on - false to never repeat
+*        uint8_t delay - time from the press to the first repeat, in
+*                        units of APP_TYPEMATIC_DELAY_UNIT_MS, 1-255
+*        uint8_t interval - ms between the first repeats, 1-255
+*        uint8_t minInterval - shortest ms between repeats, 1-interval
+*        uint8_t acceleration - ms taken off the interval by each repeat
+*
+* Output: None
+*
+********************************************************************/
+void APP_TypematicSetTiming(bool on, uint8_t delay, uint8_t interval,
+                            uint8_t minInterval, uint8_t acceleration)
+{
+    typematicOn = on;
+    typematicDelay = delay;
+    typematicInterval = interval;
+    typematicMinInterval = minInterval;
+    typematicAcceleration = acceleration;
+}
+
+/*********************************************************************
+* Function: void APP_TypematicPress(uint8_t usage);
+*
+* Overview: Starts the repeat of a key that was pressed, in place of any
+*           key repeating.
+*
+* PreCondition: Any repeat stopped with APP_TypematicStop()
+*
+* Input: uint8_t usage - keyboard page usage of the key
+*
+* Output: None
+*
+********************************************************************/
+void APP_TypematicPress(uint8_t usage)
+{
+    if((usage == 0) || (usage >= TYPEMATIC_USAGE_LEFT_CONTROL))
+    {
+        return;
+    }
+
+    repeatUsage = usage;
+    repeatPressNext = false;
+    repeatStart = TICK_Get();
+    repeatWait = (uint16_t)typematicDelay * APP_TYPEMATIC_DELAY_UNIT_MS;
+    repeatInterval = typematicInterval;
+}
+
+/*********************************************************************
+* Function: void APP_TypematicRelease(uint8_t usage);
+*
+* Overview: Stops the repeat if the key released is the one repeating.
+*
+* PreCondition: None
+*
+* Input: uint8_t usage - keyboard page usage of the key
+*
+* Output: None
+*
+********************************************************************/
+void APP_TypematicRelease(uint8_t usage)
+{
+    if(usage == repeatUsage)
+    {
+        repeatUsage = 0;
+        repeatPressNext = false;
+    }
+}
+
+/*********************************************************************
+* Function: uint8_t APP_TypematicStop(void);
+*
+* Overview: Stops any repeat.  A repeat stopped between its release and
+*           its press has left its key released in the report; the
+*           caller presses it again.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: usage of the key to press again, 0 for none
+*
+********************************************************************/
+uint8_t APP_TypematicStop(void)
+{
+    uint8_t usage;
+
+    usage = (repeatPressNext == true) ? repeatUsage : 0;
+    repeatUsage = 0;
+    repeatPressNext = false;
+    return usage;
+}
+
+/*********************************************************************
+* Function: bool APP_TypematicGetStep(uint8_t *usage, bool *down);
+*
+* Overview: Takes the next change to report for the repeating key, once
+*           it is due.  Call for each report that could be sent.  The
+*           press owed for a release already sent is given even if
+*           typematic has been turned off since.
+*
+* PreCondition: None
+*
+* Input: uint8_t *usage - receives the usage of the repeating key
+*        bool *down - receives false for the release, true for the press
+*
+* Output: false if no change is due
+*
+********************************************************************/
+bool APP_TypematicGetStep(uint8_t *usage, bool *down)
+{
+    uint16_t now;
+
+    if(repeatUsage == 0)
+    {
+        return false;
+    }
+
+    *usage = repeatUsage;
+
+    // the press goes in the report right after the release, and is owed
+    // even if typematic was turned off in between
+    if(repeatPressNext == true)
+    {
+        repeatPressNext = false;
+        *down = true;
+        return true;
+    }
+
+    if(typematicOn == false)
+    {
+        return false;
+    }
+
+    now = TICK_Get();
+    if((uint16_t)(now - repeatStart) < repeatWait)
+    {
+        return false;
+    }
+
+    // the repeats are timed from one release to the next
+    repeatStart = now;
+    repeatWait = repeatInterval;
+    if(repeatInterval > (uint16_t)typematicMinInterval + typematicAcceleration)
+    {
+        repeatInterval -= typematicAcceleration;
+    }
+    else
+    {
+        repeatInterval = typematicMinInterval;
+    }
+
+    repeatPressNext = true;
+    *down = false;
+    return true;
+}
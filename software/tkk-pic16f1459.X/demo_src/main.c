@@ -30,10 +30,13 @@ please contact mla_licensing@microchip.com
 
 #include "usb.h"
 #include "usb_device_hid.h"
+#include "usb_device_cdc.h"
 
 /* Demo project includes */
 #include "app_led_usb_status.h"
 #include "app_device_keyboard.h"
+#include "app_device_cdc_control.h"
+#include "app_settings.h"
 
 int main(void)
 {
@@ -63,6 +66,13 @@ int main(void)
 
         /* Run the keyboard demo tasks. */
         APP_KeyboardTasks();
+
+        /* Serve the control port after the keyboard, so an input report
+         * never waits for it; it handles one reply per pass. */
+        APP_DeviceCDCControlTasks();
+
+        /* Store the settings if the host asked for it. */
+        APP_SettingsTasks();
     }//end while
 }//end main
 
@@ -26,6 +26,7 @@ please contact mla_licensing@microchip.com
 
 #include "usb.h"
 #include "usb_device_hid.h"
+#include "usb_device_cdc.h"
 
 
 // *****************************************************************************
@@ -40,13 +41,13 @@ const USB_DEVICE_DESCRIPTOR device_dsc=
     0x12,    // Size of this descriptor in bytes
     USB_DESCRIPTOR_DEVICE,                // DEVICE descriptor type
     0x0200,                 // USB Spec Release Number in BCD format
-    0x00,                   // Class Code
-    0x00,                   // Subclass code
-    0x00,                   // Protocol code
+    0xEF,                   // Class Code: miscellaneous, for the interface association
+    0x02,                   // Subclass code: common class
+    0x01,                   // Protocol code: interface association descriptor
     USB_EP0_BUFF_SIZE,          // Max packet size for EP0, see usb_config.h
     MY_VID,                 // Vendor ID
     MY_PID,                 // Product ID: Keyboard fw demo
-    0x0001,                 // Device release number in BCD format
+    0x0002,                 // Device release number in BCD format
     0x01,                   // Manufacturer string index
     0x02,                   // Product string index
     0x00,                   // Device serial number string index
@@ -58,11 +59,11 @@ const uint8_t configDescriptor1[]={
     /* Configuration Descriptor */
     0x09,//sizeof(USB_CFG_DSC),    // Size of this descriptor in bytes
     USB_DESCRIPTOR_CONFIGURATION,                // CONFIGURATION descriptor type
-    DESC_CONFIG_WORD(0x0029),   // Total length of data for this cfg
-    1,                      // Number of interfaces in this cfg
+    DESC_CONFIG_WORD(0x006B),   // Total length of data for this cfg
+    3,                      // Number of interfaces in this cfg
     1,                      // Index value of this configuration
     0,                      // Configuration string index
-    _DEFAULT | _SELF,               // Attributes, see usb_device.h
+    _DEFAULT | _SELF | _RWU,        // Attributes, see usb_device.h
     50,                     // Max power consumption (2X mA)
 
     /* Interface Descriptor */
@@ -83,14 +84,14 @@ const uint8_t configDescriptor1[]={
     0x00,                   // Country Code (0x00 for Not supported)
     HID_NUM_OF_DSC,         // Number of class descriptors, see usbcfg.h
     DSC_RPT,                // Report descriptor type
-    DESC_CONFIG_WORD(63),   //sizeof(hid_rpt01),      // Size of the report descriptor
+    DESC_CONFIG_WORD(HID_RPT01_SIZE),   //sizeof(hid_rpt01),      // Size of the report descriptor
     
     /* Endpoint Descriptor */
     0x07,/*sizeof(USB_EP_DSC)*/
     USB_DESCRIPTOR_ENDPOINT,    //Endpoint Descriptor
     HID_EP | _EP_IN,            //EndpointAddress
     _INTERRUPT,                       //Attributes
-    DESC_CONFIG_WORD(8),        //size
+    DESC_CONFIG_WORD(HID_INT_IN_EP_SIZE),   //size
     0x01,                        //Interval
 
     /* Endpoint Descriptor */
@@ -98,9 +99,87 @@ const uint8_t configDescriptor1[]={
     USB_DESCRIPTOR_ENDPOINT,    //Endpoint Descriptor
     HID_EP | _EP_OUT,            //EndpointAddress
     _INTERRUPT,                       //Attributes
-    DESC_CONFIG_WORD(8),        //size
-    0x01                        //Interval
+    DESC_CONFIG_WORD(HID_INT_OUT_EP_SIZE),  //size
+    0x01,                       //Interval
+
+    /* Interface Association Descriptor: the CDC control port */
+    0x08,                   // Size of this descriptor in bytes
+    0x0B,                   // INTERFACE ASSOCIATION descriptor type
+    CDC_COMM_INTF_ID,       // First interface of the function
+    2,                      // Number of interfaces of the function
+    COMM_INTF,              // Class code
+    ABSTRACT_CONTROL_MODEL, // Subclass code
+    V25TER,                 // Protocol code
+    0,                      // Function string index
 
+    /* Interface Descriptor */
+    0x09,//sizeof(USB_INTF_DSC),   // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE,               // INTERFACE descriptor type
+    CDC_COMM_INTF_ID,       // Interface Number
+    0,                      // Alternate Setting Number
+    1,                      // Number of endpoints in this intf
+    COMM_INTF,              // Class code
+    ABSTRACT_CONTROL_MODEL, // Subclass code
+    V25TER,                 // Protocol code
+    0,                      // Interface string index
+
+    /* CDC Class-Specific Descriptors */
+    sizeof(USB_CDC_HEADER_FN_DSC),
+    CS_INTERFACE,
+    DSC_FN_HEADER,
+    0x10,0x01,
+
+    sizeof(USB_CDC_ACM_FN_DSC),
+    CS_INTERFACE,
+    DSC_FN_ACM,
+    USB_CDC_ACM_FN_DSC_VAL,
+
+    sizeof(USB_CDC_UNION_FN_DSC),
+    CS_INTERFACE,
+    DSC_FN_UNION,
+    CDC_COMM_INTF_ID,
+    CDC_DATA_INTF_ID,
+
+    sizeof(USB_CDC_CALL_MGT_FN_DSC),
+    CS_INTERFACE,
+    DSC_FN_CALL_MGT,
+    0x00,
+    CDC_DATA_INTF_ID,
+
+    /* Endpoint Descriptor */
+    0x07,/*sizeof(USB_EP_DSC)*/
+    USB_DESCRIPTOR_ENDPOINT,    //Endpoint Descriptor
+    CDC_COMM_EP | _EP_IN,       //EndpointAddress
+    _INTERRUPT,                       //Attributes
+    DESC_CONFIG_WORD(CDC_COMM_IN_EP_SIZE),  //size
+    0x02,                       //Interval
+
+    /* Interface Descriptor */
+    0x09,//sizeof(USB_INTF_DSC),   // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE,               // INTERFACE descriptor type
+    CDC_DATA_INTF_ID,       // Interface Number
+    0,                      // Alternate Setting Number
+    2,                      // Number of endpoints in this intf
+    DATA_INTF,              // Class code
+    0,                      // Subclass code
+    NO_PROTOCOL,            // Protocol code
+    0,                      // Interface string index
+
+    /* Endpoint Descriptor */
+    0x07,/*sizeof(USB_EP_DSC)*/
+    USB_DESCRIPTOR_ENDPOINT,    //Endpoint Descriptor
+    CDC_DATA_EP | _EP_OUT,      //EndpointAddress
+    _BULK,                       //Attributes
+    DESC_CONFIG_WORD(CDC_DATA_OUT_EP_SIZE), //size
+    0x00,                       //Interval
+
+    /* Endpoint Descriptor */
+    0x07,/*sizeof(USB_EP_DSC)*/
+    USB_DESCRIPTOR_ENDPOINT,    //Endpoint Descriptor
+    CDC_DATA_EP | _EP_IN,       //EndpointAddress
+    _BULK,                       //Attributes
+    DESC_CONFIG_WORD(CDC_DATA_IN_EP_SIZE),  //size
+    0x00                        //Interval
 };
 
 //Language code string descriptor
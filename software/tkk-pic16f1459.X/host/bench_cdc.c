@@ -0,0 +1,131 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Sustained throughput of the CDC data port over a simulated second.  In
+ * the device-to-host direction the application keeps the driver's
+ * transmit path full from the main loop and the host counts the bytes it
+ * receives on the bulk IN endpoint.  bench_cdc writes with putUSBUSART(),
+ * 255 bytes a transfer; bench_cdc_fifo is built with CDC_TX_FIFO_SIZE and
+ * keeps the transmit FIFO full with CDCTxWrite().  In the host-to-device
+ * direction the host keeps its queue for the bulk OUT endpoint full of
+ * packets the control port parses and does not answer, and counts those
+ * the device takes, to a packet.  The host moves at most 19 maximum size
+ * bulk packets a frame each way, 1216000 bytes/s.  Prints one line per
+ * direction and main loop pass cost. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "usb.h"
+#include "usb_device_cdc.h"
+
+#include "sim.h"
+
+static uint8_t data[255];
+static uint8_t junk[CDC_DATA_OUT_EP_SIZE];
+static uint32_t received;
+static uint32_t sent;
+
+static void CountIn(uint8_t ep, const uint8_t *packet, uint8_t len)
+{
+    if(ep == CDC_DATA_EP)
+    {
+        received += len;
+    }
+}
+
+/* Runs after the keyboard's own CDCTxService() call each pass. */
+static void Stream(void)
+{
+#if defined(CDC_TX_FIFO_SIZE)
+    CDCTxWrite(data, CDCTxAvailable());
+#else
+    if(USBUSARTIsTxTrfReady() == true)
+    {
+        putUSBUSART(data, sizeof(data));
+    }
+#endif
+}
+
+/* Refills the host's OUT queue after each pass. */
+static void Sink(void)
+{
+    while(SIM_HostOut(CDC_DATA_EP, junk, sizeof(junk)) == true)
+    {
+        sent += sizeof(junk);
+    }
+}
+
+static void BenchIn(uint16_t loopCycles)
+{
+    SIM_SetLoopHook(Stream);
+    SIM_SetLoopCycles(loopCycles);
+    SIM_RunMs(100);
+    received = 0;
+    SIM_RunMs(1000);
+    printf("cdc_throughput api=%s direction=in loop_cycles=%u unit=bytes_per_s rate=%u\n",
+#if defined(CDC_TX_FIFO_SIZE)
+           "fifo",
+#else
+           "put",
+#endif
+           loopCycles, received);
+    SIM_SetLoopHook(NULL);
+    SIM_RunMs(10);
+}
+
+static void BenchOut(uint16_t loopCycles)
+{
+    SIM_SetLoopHook(Sink);
+    SIM_SetLoopCycles(loopCycles);
+    SIM_RunMs(100);
+    sent = 0;
+    SIM_RunMs(1000);
+    printf("cdc_throughput direction=out loop_cycles=%u unit=bytes_per_s rate=%u\n",
+           loopCycles, sent);
+    SIM_SetLoopHook(NULL);
+    SIM_RunMs(10);
+}
+
+int main(void)
+{
+    uint16_t i;
+
+    for(i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)i;
+    }
+    memset(junk, 'x', sizeof(junk));
+
+    SIM_PowerOn();
+    SIM_Configure();
+    SIM_SetInHandler(CountIn);
+
+    BenchIn(300);
+    BenchIn(SIM_LOOP_CYCLES);
+    BenchIn(2400);
+    BenchOut(300);
+    BenchOut(SIM_LOOP_CYCLES);
+    BenchOut(2400);
+    return 0;
+}
@@ -0,0 +1,220 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Time BUTTON_UpdateStates() takes per scan tick on the host, for each
+ * debounce algorithm with the keys idle, held, and typing with bounce.
+ * The direct build has 3 keys; the matrix build (bench_debounce_matrix)
+ * is run with 8 keys, one lane, and 16 keys, two lanes.  The tick
+ * handler and the matrix scan run as in SYS_InterruptHigh(), outside
+ * the timed call.  Prints one line per case, in the units of clock.h. */
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "buttons.h"
+#include "matrix.h"
+#include "tick.h"
+
+#include "sim.h"
+#include "clock.h"
+
+#define TICKS       (1UL << 18)
+#define RUNS        5
+
+typedef enum
+{
+    PATTERN_IDLE,
+    PATTERN_HELD,
+    PATTERN_TYPING
+} PATTERN;
+
+static const char *patternName[] = { "idle", "held", "typing" };
+
+static uint8_t keyCount;
+static uint16_t tick;
+
+/* Closed keys on this tick, key k in bit k.  While typing each key goes
+ * down or up every 40ms, staggered, and chatters on every other tick for
+ * the first millisecond after. */
+static uint16_t Keys(PATTERN pattern)
+{
+    uint16_t all = (uint16_t)((1UL << keyCount) - 1);
+    uint16_t closed = 0;
+    uint16_t ms = tick / 4;
+    uint16_t phase;
+    uint8_t k;
+
+    if(pattern == PATTERN_IDLE)
+    {
+        return 0;
+    }
+    if(pattern == PATTERN_HELD)
+    {
+        return all;
+    }
+
+    for(k = 0; k < keyCount; k++)
+    {
+        phase = (uint16_t)((ms + (7 * k)) % 80);
+        if(phase >= 40)
+        {
+            closed |= (uint16_t)(1 << k);
+        }
+        if(((phase % 40) == 0) && ((tick & 1) != 0))
+        {
+            closed ^= (uint16_t)(1 << k);
+        }
+    }
+    return closed;
+}
+
+/* Drives the key pins as the keys would on this tick. */
+static void Drive(uint16_t closed)
+{
+#if defined(MATRIX_SCAN_ENABLE)
+    uint8_t row;
+
+    //the scan drives one row low at a time through TRISC; the columns of
+    //its closed keys read low on RB4-RB7
+    for(row = 0; row < MATRIX_ROWS; row++)
+    {
+        if((TRISC & (1 << row)) == 0)
+        {
+            break;
+        }
+    }
+    PORTB = (uint8_t)~(((closed >> (row * MATRIX_COLS)) & 0x0F) << 4) & 0xF0;
+#else
+    static const uint8_t pin[] = { SIM_KEY_S1, SIM_KEY_S2, SIM_KEY_S3 };
+    uint8_t port = 0xF0;
+    uint8_t k;
+
+    for(k = 0; k < keyCount; k++)
+    {
+        if((closed & (1 << k)) != 0)
+        {
+            port &= (uint8_t)~pin[k];
+        }
+    }
+    PORTB = port;
+#endif
+}
+
+/* Stands in for BUTTON_UpdateStates() to time the timing itself. */
+static void __attribute__((noinline)) Empty(void)
+{
+    __asm__ volatile("");
+}
+
+/* Times TICKS ticks of one call into cost[]. */
+static void Run(PATTERN pattern, void (*update)(void), uint32_t *cost)
+{
+    BUTTON_EVENT event;
+    uint64_t start;
+    uint32_t i;
+
+    for(i = 0; i < TICKS; i++, tick++)
+    {
+        Drive(Keys(pattern));
+        TICK_InterruptHandler();
+        #if defined(MATRIX_SCAN_ENABLE)
+        MATRIX_ScanRow();
+        #endif
+
+        start = Clock();
+        update();
+        cost[i] = (uint32_t)(Clock() - start);
+
+        while(BUTTON_GetEvent(&event) == true)
+        {
+        }
+    }
+}
+
+static uint32_t cost[TICKS];
+
+/* Cost of a tick, less the cost of timing: the best of RUNS runs. */
+static void Measure(PATTERN pattern, double *mean, uint32_t *p99)
+{
+    uint32_t overhead;
+    uint32_t runP99;
+    double runMean;
+    uint8_t run;
+
+    *mean = 1e9;
+    *p99 = UINT32_MAX;
+    for(run = 0; run < RUNS; run++)
+    {
+        //the median of timing an empty call is the cost of timing
+        Run(pattern, Empty, cost);
+        ClockSummarize(cost, TICKS, 0, &runMean, &runP99);
+        overhead = cost[TICKS / 2];
+
+        Run(pattern, BUTTON_UpdateStates, cost);
+        ClockSummarize(cost, TICKS, overhead, &runMean, &runP99);
+        if(runMean < *mean)
+        {
+            *mean = runMean;
+        }
+        if(runP99 < *p99)
+        {
+            *p99 = runP99;
+        }
+    }
+}
+
+static void Bench(uint8_t keys)
+{
+    static const char *modeName[] = { "state_machine", "eager" };
+    BUTTON_DEBOUNCE_MODE mode;
+    PATTERN pattern;
+    double mean;
+    uint32_t p99;
+
+    keyCount = keys;
+    for(pattern = PATTERN_IDLE; pattern <= PATTERN_TYPING; pattern++)
+    {
+        for(mode = BUTTON_DEBOUNCE_STATE_MACHINE; mode <= BUTTON_DEBOUNCE_EAGER; mode++)
+        {
+            BUTTON_SetDebounceMode(mode);
+            Measure(pattern, &mean, &p99);
+            printf("debounce_cost keys=%u pattern=%s mode=%s unit=%s mean=%.1f p99=%u\n",
+                   keys, patternName[pattern], modeName[mode], CLOCK_UNIT, mean, p99);
+        }
+    }
+}
+
+int main(void)
+{
+    SIM_PowerOn();
+    //the benchmark plays the interrupt itself
+    INTCONbits.GIE = 0;
+
+#if defined(MATRIX_SCAN_ENABLE)
+    Bench(8);
+    Bench(16);
+#else
+    Bench(3);
+#endif
+    return 0;
+}
@@ -0,0 +1,134 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Time APP_KeyboardTasks() takes per main loop pass on the host, with
+ * the keys idle and while typing on S2 and S3.  Each timed call is the
+ * first pass after the sim has played the peripherals and interrupts,
+ * so it finds whatever work they left.  Prints one line per case, in the
+ * units of clock.h. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "app_device_keyboard.h"
+
+#include "sim.h"
+#include "clock.h"
+
+#define PASSES      (1UL << 17)
+#define RUNS        3
+
+typedef enum
+{
+    PATTERN_IDLE,
+    PATTERN_TYPING
+} PATTERN;
+
+static const char *patternName[] = { "idle", "typing" };
+
+static uint32_t cost[PASSES];
+
+/* Stands in for APP_KeyboardTasks() to time the timing itself. */
+static void __attribute__((noinline)) Empty(void)
+{
+    __asm__ volatile("");
+}
+
+/* Times PASSES passes of one call into cost[].  While typing S2 and S3
+ * change every 20ms in turn, with bounce. */
+static void Run(PATTERN pattern, void (*task)(void))
+{
+    uint32_t passesPerChange = (20 * SIM_CYCLES_PER_MS) / SIM_LOOP_CYCLES;
+    uint8_t closed = 0;
+    uint64_t start;
+    uint32_t i;
+
+    for(i = 0; i < PASSES; i++)
+    {
+        if((pattern == PATTERN_TYPING) && ((i % passesPerChange) == 0))
+        {
+            closed ^= ((i / passesPerChange) & 1) ? SIM_KEY_S3 : SIM_KEY_S2;
+            SIM_Bounce(SIM_GetCycles(), SIM_KEY_S2 | SIM_KEY_S3, closed, 3,
+                       SIM_CYCLES_PER_MS / 20);
+        }
+
+        start = Clock();
+        task();
+        cost[i] = (uint32_t)(Clock() - start);
+
+        SIM_Run(1);
+    }
+
+    SIM_SetKeys(0);
+    SIM_RunMs(300);
+}
+
+static void Bench(PATTERN pattern)
+{
+    uint32_t overhead;
+    uint32_t runP99;
+    uint32_t p99 = UINT32_MAX;
+    double runMean;
+    double mean = 1e9;
+    uint8_t run;
+
+    for(run = 0; run < RUNS; run++)
+    {
+        //the median of timing an empty call is the cost of timing
+        Run(pattern, Empty);
+        ClockSummarize(cost, PASSES, 0, &runMean, &runP99);
+        overhead = cost[PASSES / 2];
+
+        Run(pattern, APP_KeyboardTasks);
+        ClockSummarize(cost, PASSES, overhead, &runMean, &runP99);
+        if(runMean < mean)
+        {
+            mean = runMean;
+        }
+        if(runP99 < p99)
+        {
+            p99 = runP99;
+        }
+    }
+
+    printf("loop_cost pattern=%s unit=%s mean=%.1f p99=%u\n",
+           patternName[pattern], CLOCK_UNIT, mean, p99);
+}
+
+int main(void)
+{
+    uint8_t page[8];
+
+    SIM_PowerOn();
+    SIM_Configure();
+
+    //S2 is in chords; turn them off so typing is not held back
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_CHORD;
+    SIM_SetFeaturePage(page);
+    SIM_RunMs(100);
+
+    Bench(PATTERN_IDLE);
+    Bench(PATTERN_TYPING);
+    return 0;
+}
@@ -0,0 +1,48 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* The checks the host test programs are written with. */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+static unsigned int checkFailures;
+
+#define CHECK(condition)                                                \
+    do                                                                  \
+    {                                                                   \
+        if(!(condition))                                                \
+        {                                                               \
+            checkFailures++;                                            \
+            fprintf(stderr, "%s:%d: check failed: %s\n",                \
+                    __FILE__, __LINE__, #condition);                    \
+        }                                                               \
+    } while(0)
+
+/* Prints the result line of a test program and gives its exit status. */
+#define CHECK_DONE(name)                                                \
+    (printf("%s: %s\n", (name), (checkFailures == 0) ? "pass" : "FAIL"), \
+     (checkFailures == 0) ? 0 : 1)
+
+#endif //CHECK_H
@@ -0,0 +1,80 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* The host clock the benchmark programs time single calls with: the time
+ * stamp counter where there is one (unit "tsc"), nanoseconds otherwise
+ * (unit "ns").  Neither is a PIC cycle; compare figures of one run. */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CLOCK_UNIT  "tsc"
+#else
+#define CLOCK_UNIT  "ns"
+#endif
+
+static uint64_t Clock(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+#endif
+}
+
+static int ClockCompare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Sorts count timed calls and gives their cost less overhead, the cost
+ * of timing nothing: the mean of the cheapest 99%, which leaves out the
+ * host's own interrupts, and the 99th percentile. */
+static void ClockSummarize(uint32_t *cost, uint32_t count, uint32_t overhead,
+                           double *mean, uint32_t *p99)
+{
+    uint32_t kept = (count / 100) * 99;
+    uint64_t sum = 0;
+    uint32_t i;
+
+    qsort(cost, count, sizeof(cost[0]), ClockCompare);
+    for(i = 0; i < kept; i++)
+    {
+        cost[i] = (cost[i] > overhead) ? cost[i] - overhead : 0;
+        sum += cost[i];
+    }
+    *mean = (double)sum / kept;
+    *p99 = cost[kept - 1];
+}
+
+#endif //CLOCK_H
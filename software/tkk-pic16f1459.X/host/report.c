@@ -0,0 +1,150 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+#include <string.h>
+
+#include "usb_config.h"
+
+#include "sim.h"
+#include "report.h"
+
+/* Report ID 1: the ID, the modifier bits, then the key bitmap; usage n
+ * is bit (n & 7) of bitmap byte (n >> 3). */
+#define REPORT_ID_KEYBOARD      1
+#define REPORT_BITMAP_OFFSET    2
+#define REPORT_TEXT_SIZE        4096
+
+static bool down[256];
+static uint16_t presses[256];
+static uint64_t pressCycle[256];
+static uint32_t reportCount;
+static char text[REPORT_TEXT_SIZE];
+static uint16_t textLength;
+
+/* Characters of usages 0x1E-0x38 on a US layout, unshifted and shifted;
+ * 0 for a usage with none. */
+static const char keyChar[][2] =
+{
+    {'1', '!'}, {'2', '@'}, {'3', '#'}, {'4', '$'}, {'5', '%'},
+    {'6', '^'}, {'7', '&'}, {'8', '*'}, {'9', '('}, {'0', ')'},
+    {'\n', '\n'}, {0, 0}, {0, 0}, {'\t', '\t'}, {' ', ' '},
+    {'-', '_'}, {'=', '+'}, {'[', '{'}, {']', '}'}, {'\\', '|'},
+    {0, 0}, {';', ':'}, {'\'', '"'}, {'`', '~'}, {',', '<'},
+    {'.', '>'}, {'/', '?'}
+};
+
+static void REPORT_Type(uint8_t usage)
+{
+    bool shift = down[REPORT_USAGE_LEFT_SHIFT] || down[REPORT_USAGE_LEFT_SHIFT + 4];
+    char c = 0;
+
+    if((usage >= 0x04) && (usage <= 0x1D))
+    {
+        c = (char)((shift ? 'A' : 'a') + (usage - 0x04));
+    }
+    else if((usage >= 0x1E) && (usage <= 0x38))
+    {
+        c = keyChar[usage - 0x1E][shift ? 1 : 0];
+    }
+
+    if((c != 0) && (textLength < (REPORT_TEXT_SIZE - 1)))
+    {
+        text[textLength++] = c;
+        text[textLength] = '\0';
+    }
+}
+
+static void REPORT_In(uint8_t ep, const uint8_t *data, uint8_t len)
+{
+    uint16_t usage;
+    bool now;
+
+    if((ep != HID_EP) || (len < REPORT_BITMAP_OFFSET) ||
+       (data[0] != REPORT_ID_KEYBOARD))
+    {
+        return;
+    }
+
+    reportCount++;
+
+    //modifiers first, so a shifted key types its shifted character
+    for(usage = 0xE0; usage <= 0xE7; usage++)
+    {
+        now = ((data[1] >> (usage - 0xE0)) & 1) ? true : false;
+        if(now && !down[usage])
+        {
+            presses[usage]++;
+            pressCycle[usage] = SIM_GetCycles();
+        }
+        down[usage] = now;
+    }
+
+    for(usage = 0; usage < (uint16_t)((len - REPORT_BITMAP_OFFSET) * 8); usage++)
+    {
+        now = ((data[REPORT_BITMAP_OFFSET + (usage >> 3)] >> (usage & 7)) & 1) ? true : false;
+        if(now && !down[usage])
+        {
+            presses[usage]++;
+            pressCycle[usage] = SIM_GetCycles();
+            REPORT_Type((uint8_t)usage);
+        }
+        down[usage] = now;
+    }
+}
+
+void REPORT_Attach(void)
+{
+    SIM_SetInHandler(REPORT_In);
+}
+
+void REPORT_Clear(void)
+{
+    memset(presses, 0, sizeof(presses));
+    reportCount = 0;
+    textLength = 0;
+    text[0] = '\0';
+}
+
+uint32_t REPORT_GetCount(void)
+{
+    return reportCount;
+}
+
+bool REPORT_IsDown(uint8_t usage)
+{
+    return down[usage];
+}
+
+uint16_t REPORT_GetPresses(uint8_t usage)
+{
+    return presses[usage];
+}
+
+uint64_t REPORT_GetPressCycle(uint8_t usage)
+{
+    return pressCycle[usage];
+}
+
+const char *REPORT_GetText(void)
+{
+    return text;
+}
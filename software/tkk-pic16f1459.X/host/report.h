@@ -0,0 +1,136 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* The host's view of the keyboard: decodes the report protocol
+ * keyboard reports the simulated host receives on the HID endpoint. */
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Usages 0xE0-0xE7 are the modifier bits of the report. */
+#define REPORT_USAGE_LEFT_CONTROL   0xE0
+#define REPORT_USAGE_LEFT_SHIFT     0xE1
+
+/*********************************************************************
+* Function: void REPORT_Attach(void);
+*
+* Overview: Decodes the keyboard reports the host receives from now on.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void REPORT_Attach(void);
+
+/*********************************************************************
+* Function: void REPORT_Clear(void);
+*
+* Overview: Clears the report and press counts and the typed text.  The
+*           keys held down stay down.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void REPORT_Clear(void);
+
+/*********************************************************************
+* Function: uint32_t REPORT_GetCount(void);
+*
+* Overview: Keyboard reports received since REPORT_Clear().
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: report count
+*
+********************************************************************/
+uint32_t REPORT_GetCount(void);
+
+/*********************************************************************
+* Function: bool REPORT_IsDown(uint8_t usage);
+*
+* Overview: Whether the last keyboard report holds a usage down.
+*
+* PreCondition: None
+*
+* Input: uint8_t usage - keyboard usage, or 0xE0-0xE7 for a modifier
+*
+* Output: true if down
+*
+********************************************************************/
+bool REPORT_IsDown(uint8_t usage);
+
+/*********************************************************************
+* Function: uint16_t REPORT_GetPresses(uint8_t usage);
+*
+* Overview: Times a usage went down since REPORT_Clear().
+*
+* PreCondition: None
+*
+* Input: uint8_t usage - keyboard usage, or 0xE0-0xE7 for a modifier
+*
+* Output: press count
+*
+********************************************************************/
+uint16_t REPORT_GetPresses(uint8_t usage);
+
+/*********************************************************************
+* Function: uint64_t REPORT_GetPressCycle(uint8_t usage);
+*
+* Overview: Cycle the host received the last press of a usage at.
+*
+* PreCondition: REPORT_GetPresses(usage) != 0
+*
+* Input: uint8_t usage - keyboard usage, or 0xE0-0xE7 for a modifier
+*
+* Output: cycle count
+*
+********************************************************************/
+uint64_t REPORT_GetPressCycle(uint8_t usage);
+
+/*********************************************************************
+* Function: const char *REPORT_GetText(void);
+*
+* Overview: Text the presses since REPORT_Clear() type on a US layout.
+*           Keys with no character are left out.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: the text
+*
+********************************************************************/
+const char *REPORT_GetText(void);
+
+#endif //REPORT_H
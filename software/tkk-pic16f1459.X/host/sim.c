@@ -0,0 +1,1026 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* The special function registers of xc.h, the peripherals behind them,
+ * and the device layer of the USB stack (usb_device.c, which the host
+ * build leaves out) over a simulated USB module and host. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "system.h"
+#include "usb.h"
+#include "usb_device_hid.h"
+#include "usb_device_cdc.h"
+
+#include "app_device_keyboard.h"
+#include "app_device_cdc_control.h"
+#include "app_settings.h"
+
+#include "sim.h"
+
+void SYS_InterruptHigh(void);
+bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size);
+
+/*** Special Function Registers *************************************/
+volatile INTCONbits_t INTCONbits;
+volatile PIE1bits_t PIE1bits;
+volatile PIR1bits_t PIR1bits;
+volatile PIE2bits_t PIE2bits;
+volatile PIR2bits_t PIR2bits;
+volatile OPTION_REGbits_t OPTION_REGbits;
+volatile OSCCONbits_t OSCCONbits;
+volatile ACTCONbits_t ACTCONbits;
+volatile PORTBbits_t PORTBbits;
+volatile TRISBbits_t TRISBbits;
+volatile LATBbits_t LATBbits;
+volatile ANSELBbits_t ANSELBbits;
+volatile WPUBbits_t WPUBbits;
+volatile IOCBPbits_t IOCBPbits;
+volatile IOCBNbits_t IOCBNbits;
+volatile IOCBFbits_t IOCBFbits;
+volatile PORTCbits_t PORTCbits;
+volatile TRISCbits_t TRISCbits;
+volatile LATCbits_t LATCbits;
+volatile ANSELCbits_t ANSELCbits;
+volatile T1CONbits_t T1CONbits;
+volatile T2CONbits_t T2CONbits;
+volatile PMCON1bits_t PMCON1bits;
+volatile UCONbits_t UCONbits;
+volatile UIRbits_t UIRbits;
+volatile UIEbits_t UIEbits;
+volatile uint16_t TMR1;
+volatile uint8_t TMR2;
+volatile uint8_t PR2;
+volatile uint8_t PMCON2;
+volatile uint8_t PMADRL;
+volatile uint8_t PMADRH;
+volatile uint8_t PMDATL;
+volatile uint8_t PMDATH;
+volatile uint8_t UEIR;
+volatile uint8_t UEIE;
+volatile uint8_t USTAT;
+volatile uint8_t UADDR;
+volatile uint8_t UCFG;
+volatile uint8_t UEP[8];
+
+/*** USB Device Layer State *****************************************/
+/* What usb_device.c defines and the class drivers and the application
+ * use. */
+volatile CTRL_TRF_SETUP SetupPkt;
+volatile uint8_t CtrlTrfData[USB_EP0_BUFF_SIZE];
+USB_VOLATILE IN_PIPE inPipes[1];
+USB_VOLATILE OUT_PIPE outPipes[1];
+USB_VOLATILE bool RemoteWakeup;
+USB_VOLATILE bool USBBusIsSuspended;
+USB_VOLATILE USB_DEVICE_STATE USBDeviceState;
+USB_VOLATILE uint8_t USBActiveConfiguration;
+
+#define SIM_EP_COUNT            (USB_MAX_EP_NUMBER + 1)
+#define SIM_BD(ep, dir, pp)     ((4 * (ep)) + (2 * (dir)) + (pp))
+#define SIM_NEXT_PING_PONG      sizeof(BDT_ENTRY)
+
+/* Aligned so that flipping the entry-size bit of a pointer moves it
+ * between the even and odd buffer descriptors of an endpoint, as the
+ * stack's USB_NEXT_PING_PONG does on the hardware BDT. */
+static volatile BDT_ENTRY BDT[SIM_EP_COUNT * 4] __attribute__((aligned(256)));
+volatile BDT_ENTRY *pBDTEntryIn[SIM_EP_COUNT];
+volatile BDT_ENTRY *pBDTEntryOut[SIM_EP_COUNT];
+
+/*** Simulation State ***********************************************/
+#define SIM_NEVER               UINT64_MAX
+#define SIM_PIN_EVENTS          256
+#define SIM_BUFFERS             32
+#define SIM_OUT_QUEUE           8
+#define SIM_USTAT_FIFO          4
+/* Full speed fits 19 maximum size bulk packets in a frame. */
+#define SIM_BULK_SLOTS          19
+
+typedef struct
+{
+    uint64_t cycle;
+    uint8_t mask;
+    uint8_t closed;
+} SIM_PIN_EVENT;
+
+typedef struct
+{
+    uint8_t type;
+    uint8_t interval;
+    uint16_t maxPacket;
+} SIM_ENDPOINT;
+
+typedef struct
+{
+    uint8_t len;
+    uint8_t data[64];
+} SIM_PACKET;
+
+static uint64_t now;
+static uint16_t loopCycles = SIM_LOOP_CYCLES;
+static uint32_t loopCount;
+static SIM_LOOP_HOOK loopHook;
+
+static uint8_t keysClosed;
+static SIM_PIN_EVENT pinEvent[SIM_PIN_EVENTS];
+static uint16_t pinEventCount;
+
+/* Timer2 as last left by the simulation; a differing TMR2 or T2CON is
+ * a firmware write, which clears the pre- and postscaler. */
+static uint8_t t2Tmr;
+static uint8_t t2Con;
+static uint8_t t2Prescale;
+static uint8_t t2Postscale;
+
+/* Every buffer the firmware has armed with USBTransferOnePacket(), so a
+ * buffer address written straight into a BDT entry can be mapped back
+ * from the 15 bits the hardware keeps. */
+static uint8_t *knownBuffer[SIM_BUFFERS];
+static uint8_t knownBufferCount;
+
+static SIM_ENDPOINT endpoint[SIM_EP_COUNT][2];
+static uint8_t siePingPong[SIM_EP_COUNT][2];
+static SIM_PACKET outQueue[SIM_EP_COUNT][SIM_OUT_QUEUE];
+static uint8_t outHead[SIM_EP_COUNT];
+static uint8_t outCount[SIM_EP_COUNT];
+static uint8_t ustatFifo[SIM_USTAT_FIFO];
+static uint8_t ustatCount;
+
+static bool usbRunning;
+static bool busSuspended;
+static bool resumeDriven;
+static uint64_t frameStart;
+static uint64_t sofCycle;
+static uint32_t frameNumber;
+static uint8_t usbSlot;
+static SIM_IN_HANDLER inHandler;
+static uint32_t inCount[SIM_EP_COUNT];
+static uint16_t remoteWakeups;
+static uint16_t errors;
+
+static void SIM_Error(const char *what, uint8_t ep, uint16_t len)
+{
+    errors++;
+    fprintf(stderr, "sim: %s on endpoint %u (%u bytes) at cycle %llu\n",
+            what, ep, len, (unsigned long long)now);
+}
+
+/*********************************************************************
+* Interrupts
+********************************************************************/
+static void SIM_UsbFlag(void)
+{
+    if((UIR & UIE) != 0)
+    {
+        PIR2bits.USBIF = 1;
+    }
+}
+
+static bool SIM_InterruptPending(void)
+{
+    INTCONbits.IOCIF = (IOCBF != 0) ? 1 : 0;
+
+    if(INTCONbits.GIE == 0)
+    {
+        return false;
+    }
+
+    if(INTCONbits.IOCIE && INTCONbits.IOCIF)
+    {
+        return true;
+    }
+
+    return INTCONbits.PEIE &&
+           ((PIE1bits.TMR2IE && PIR1bits.TMR2IF) ||
+            (PIE2bits.USBIE && PIR2bits.USBIF));
+}
+
+/* Runs the interrupt vector until no enabled flag is left set.  The
+ * vector runs with GIE clear, as the hardware does. */
+static void SIM_Interrupts(void)
+{
+    uint8_t passes = 0;
+
+    while(SIM_InterruptPending() == true)
+    {
+        if(++passes > 16)
+        {
+            fprintf(stderr, "sim: interrupt flag never cleared\n");
+            exit(1);
+        }
+
+        INTCONbits.GIE = 0;
+        SYS_InterruptHigh();
+        INTCONbits.GIE = 1;
+    }
+}
+
+/*********************************************************************
+* Key pins
+********************************************************************/
+static void SIM_Pins(uint8_t closed)
+{
+    uint8_t old = PORTB;
+
+    keysClosed = closed & SIM_KEY_ALL;
+    //the contacts pull the pins low against the weak pull-ups
+    PORTB = (uint8_t)(~keysClosed & 0xF0);
+    IOCBF |= (uint8_t)(((PORTB & ~old & IOCBP) | (~PORTB & old & IOCBN)) &
+                       0xF0);
+}
+
+void SIM_SetKeys(uint8_t closed)
+{
+    SIM_Pins(closed);
+    SIM_Interrupts();
+}
+
+void SIM_ScheduleKeys(uint64_t cycle, uint8_t mask, uint8_t closed)
+{
+    uint16_t i;
+
+    if(pinEventCount == SIM_PIN_EVENTS)
+    {
+        fprintf(stderr, "sim: too many pin events\n");
+        exit(1);
+    }
+
+    //keep the queue in time order, and in scheduling order at one time
+    i = pinEventCount++;
+    while((i > 0) && (pinEvent[i - 1].cycle > cycle))
+    {
+        pinEvent[i] = pinEvent[i - 1];
+        i--;
+    }
+
+    pinEvent[i].cycle = cycle;
+    pinEvent[i].mask = mask;
+    pinEvent[i].closed = closed;
+}
+
+void SIM_Bounce(uint64_t cycle, uint8_t mask, uint8_t closed,
+                uint8_t bounces, uint32_t spacing)
+{
+    uint8_t i;
+
+    SIM_ScheduleKeys(cycle, mask, closed);
+    for(i = 0; i < bounces; i++)
+    {
+        cycle += spacing;
+        SIM_ScheduleKeys(cycle, mask, (uint8_t)~closed);
+        cycle += spacing;
+        SIM_ScheduleKeys(cycle, mask, closed);
+    }
+}
+
+static void SIM_PinEvents(void)
+{
+    uint16_t i;
+
+    while((pinEventCount > 0) && (pinEvent[0].cycle <= now))
+    {
+        SIM_Pins((uint8_t)((keysClosed & ~pinEvent[0].mask) |
+                           (pinEvent[0].closed & pinEvent[0].mask)));
+
+        pinEventCount--;
+        for(i = 0; i < pinEventCount; i++)
+        {
+            pinEvent[i] = pinEvent[i + 1];
+        }
+    }
+}
+
+/*********************************************************************
+* Timers
+********************************************************************/
+static void SIM_Timer2Writes(void)
+{
+    if((TMR2 != t2Tmr) || (T2CON != t2Con))
+    {
+        t2Prescale = 0;
+        t2Postscale = 0;
+    }
+}
+
+static uint8_t SIM_Timer2Prescaler(void)
+{
+    static const uint8_t prescaler[] = { 1, 4, 16, 64 };
+
+    return prescaler[T2CONbits.T2CKPS];
+}
+
+/* Increments of TMR2 from its value to the next period match. */
+static uint16_t SIM_Timer2ToMatch(void)
+{
+    if(TMR2 <= PR2)
+    {
+        return (uint16_t)(PR2 - TMR2 + 1);
+    }
+
+    return (uint16_t)(256 - TMR2 + PR2 + 1);
+}
+
+static uint64_t SIM_Timer2Next(void)
+{
+    uint64_t increments;
+
+    SIM_Timer2Writes();
+    if(T2CONbits.TMR2ON == 0)
+    {
+        return SIM_NEVER;
+    }
+
+    increments = SIM_Timer2ToMatch() +
+                 (uint64_t)(T2CONbits.T2OUTPS - t2Postscale) * (PR2 + 1u);
+    return now + (increments * SIM_Timer2Prescaler()) - t2Prescale;
+}
+
+static void SIM_Timers(uint32_t cycles)
+{
+    uint32_t increments;
+    uint16_t toMatch;
+
+    if(T1CONbits.TMR1ON)
+    {
+        TMR1 = (uint16_t)(TMR1 + cycles);
+    }
+
+    SIM_Timer2Writes();
+    if(T2CONbits.TMR2ON)
+    {
+        increments = (t2Prescale + cycles) / SIM_Timer2Prescaler();
+        t2Prescale = (uint8_t)((t2Prescale + cycles) % SIM_Timer2Prescaler());
+
+        while(increments > 0)
+        {
+            toMatch = SIM_Timer2ToMatch();
+            if(increments < toMatch)
+            {
+                TMR2 = (uint8_t)(TMR2 + increments);
+                break;
+            }
+
+            increments -= toMatch;
+            TMR2 = 0;
+            if(++t2Postscale > T2CONbits.T2OUTPS)
+            {
+                t2Postscale = 0;
+                PIR1bits.TMR2IF = 1;
+            }
+        }
+    }
+
+    t2Tmr = TMR2;
+    t2Con = T2CON;
+}
+
+/*********************************************************************
+* USB module and host
+********************************************************************/
+static void SIM_ParseEndpoints(void)
+{
+    const uint8_t *descriptor = configDescriptor1;
+    uint16_t total = (uint16_t)(descriptor[2] | (descriptor[3] << 8));
+    uint16_t i;
+    uint8_t ep;
+    uint8_t dir;
+
+    for(i = 0; i < total; i = (uint16_t)(i + descriptor[i]))
+    {
+        if(descriptor[i + 1] == USB_DESCRIPTOR_ENDPOINT)
+        {
+            ep = descriptor[i + 2] & 0x0F;
+            dir = (descriptor[i + 2] & 0x80) ? IN_TO_HOST : OUT_FROM_HOST;
+            endpoint[ep][dir].type = descriptor[i + 3] & 0x03;
+            endpoint[ep][dir].maxPacket =
+                (uint16_t)(descriptor[i + 4] | (descriptor[i + 5] << 8));
+            endpoint[ep][dir].interval = descriptor[i + 6];
+        }
+    }
+}
+
+static uint8_t *SIM_Buffer(volatile BDT_ENTRY *bd)
+{
+    uint8_t i;
+
+    for(i = 0; i < knownBufferCount; i++)
+    {
+        if(ConvertToPhysicalAddress(knownBuffer[i]) == bd->ADR)
+        {
+            return knownBuffer[i];
+        }
+    }
+
+    fprintf(stderr, "sim: BDT entry points at an unknown buffer\n");
+    exit(1);
+}
+
+static void SIM_RememberBuffer(uint8_t *data)
+{
+    uint8_t i;
+
+    for(i = 0; i < knownBufferCount; i++)
+    {
+        if(knownBuffer[i] == data)
+        {
+            return;
+        }
+        if(ConvertToPhysicalAddress(knownBuffer[i]) ==
+           ConvertToPhysicalAddress(data))
+        {
+            fprintf(stderr, "sim: two buffers share a BDT address\n");
+            exit(1);
+        }
+    }
+
+    if(knownBufferCount == SIM_BUFFERS)
+    {
+        fprintf(stderr, "sim: too many USB buffers\n");
+        exit(1);
+    }
+    knownBuffer[knownBufferCount++] = data;
+}
+
+/* One transaction on an endpoint: data moves only if the buffer
+ * descriptor the SIE is on belongs to it, otherwise the host is NAKed. */
+static bool SIM_Transaction(uint8_t ep, uint8_t dir)
+{
+    volatile BDT_ENTRY *bd;
+    uint8_t *buffer;
+    SIM_PACKET *packet;
+    uint8_t pp = siePingPong[ep][dir];
+    USTAT_FIELDS stat;
+
+    if((ustatCount == SIM_USTAT_FIFO) ||
+       ((UEP[ep] & ((dir == IN_TO_HOST) ? USB_IN_ENABLED : USB_OUT_ENABLED)) == 0))
+    {
+        return false;
+    }
+
+    bd = &BDT[SIM_BD(ep, dir, pp)];
+    if(bd->STAT.UOWN == 0)
+    {
+        return false;
+    }
+
+    buffer = SIM_Buffer(bd);
+    if(dir == IN_TO_HOST)
+    {
+        if(bd->CNT > endpoint[ep][dir].maxPacket)
+        {
+            SIM_Error("IN packet over wMaxPacketSize", ep, bd->CNT);
+        }
+        inCount[ep]++;
+        if(inHandler != NULL)
+        {
+            inHandler(ep, buffer, bd->CNT);
+        }
+    }
+    else
+    {
+        if(outCount[ep] == 0)
+        {
+            return false;
+        }
+
+        packet = &outQueue[ep][outHead[ep]];
+        if(packet->len > endpoint[ep][dir].maxPacket)
+        {
+            SIM_Error("OUT packet over wMaxPacketSize", ep, packet->len);
+        }
+        if(packet->len > bd->CNT)
+        {
+            SIM_Error("OUT packet over the armed buffer", ep, packet->len);
+        }
+        memcpy(buffer, packet->data, (packet->len < bd->CNT) ? packet->len : bd->CNT);
+        bd->CNT = packet->len;
+        outHead[ep] = (uint8_t)((outHead[ep] + 1) % SIM_OUT_QUEUE);
+        outCount[ep]--;
+    }
+
+    bd->STAT.UOWN = 0;
+    siePingPong[ep][dir] ^= 1;
+
+    stat.Val = 0;
+    stat.endpoint_number = ep;
+    stat.direction = dir;
+    stat.ping_pong = pp;
+    ustatFifo[ustatCount++] = stat.Val;
+    UIRbits.TRNIF = 1;
+    SIM_UsbFlag();
+    return true;
+}
+
+static uint64_t SIM_UsbNext(void)
+{
+    if(usbRunning == false)
+    {
+        return SIM_NEVER;
+    }
+
+    return frameStart + ((uint64_t)usbSlot * SIM_CYCLES_PER_MS) / SIM_BULK_SLOTS;
+}
+
+static void SIM_UsbSlot(void)
+{
+    uint8_t ep;
+    uint8_t dir;
+
+    if(busSuspended == true)
+    {
+        //a remote wakeup is RESUME driven for 1-15ms, then released
+        if(UCONbits.RESUME)
+        {
+            resumeDriven = true;
+        }
+        else if(resumeDriven == true)
+        {
+            resumeDriven = false;
+            remoteWakeups++;
+            busSuspended = false;
+            UIRbits.ACTVIF = 1;
+            SIM_UsbFlag();
+        }
+    }
+    else if(usbSlot == 0)
+    {
+        frameNumber++;
+        sofCycle = now;
+        UIRbits.SOFIF = 1;
+        SIM_UsbFlag();
+
+        for(ep = 1; ep < SIM_EP_COUNT; ep++)
+        {
+            for(dir = OUT_FROM_HOST; dir <= IN_TO_HOST; dir++)
+            {
+                if((endpoint[ep][dir].type == USB_TRANSFER_TYPE_INTERRUPT) &&
+                   ((frameNumber % endpoint[ep][dir].interval) == 0))
+                {
+                    SIM_Transaction(ep, dir);
+                }
+            }
+        }
+    }
+
+    if(busSuspended == false)
+    {
+        for(ep = 1; ep < SIM_EP_COUNT; ep++)
+        {
+            for(dir = OUT_FROM_HOST; dir <= IN_TO_HOST; dir++)
+            {
+                if(endpoint[ep][dir].type == USB_TRANSFER_TYPE_BULK)
+                {
+                    SIM_Transaction(ep, dir);
+                }
+            }
+        }
+    }
+
+    if(++usbSlot == SIM_BULK_SLOTS)
+    {
+        usbSlot = 0;
+        frameStart += SIM_CYCLES_PER_MS;
+    }
+}
+
+/*********************************************************************
+* USB device layer
+********************************************************************/
+void USBDeviceInit(void)
+{
+    memset((void *)BDT, 0, sizeof(BDT));
+    memset((void *)UEP, 0, sizeof(UEP));
+    UIR = 0;
+    UIE = 0;
+    USBDeviceState = DETACHED_STATE;
+    USBActiveConfiguration = 0;
+    USBBusIsSuspended = false;
+    RemoteWakeup = false;
+}
+
+void USBDeviceAttach(void)
+{
+    UCON = 0;
+    UIE = 0;
+    SetConfigurationOptions();
+    USBEnableInterrupts();
+    UCONbits.USBEN = 1;
+    USBDeviceState = POWERED_STATE;
+}
+
+void USBEnableEndpoint(uint8_t ep, uint8_t options)
+{
+    if(options & USB_OUT_ENABLED)
+    {
+        BDT[SIM_BD(ep, OUT_FROM_HOST, 0)].STAT.Val = 0;
+        BDT[SIM_BD(ep, OUT_FROM_HOST, 1)].STAT.Val = _DTSMASK;
+        pBDTEntryOut[ep] = &BDT[SIM_BD(ep, OUT_FROM_HOST, 0)];
+        siePingPong[ep][OUT_FROM_HOST] = 0;
+    }
+    if(options & USB_IN_ENABLED)
+    {
+        BDT[SIM_BD(ep, IN_TO_HOST, 0)].STAT.Val = 0;
+        BDT[SIM_BD(ep, IN_TO_HOST, 1)].STAT.Val = _DTSMASK;
+        pBDTEntryIn[ep] = &BDT[SIM_BD(ep, IN_TO_HOST, 0)];
+        siePingPong[ep][IN_TO_HOST] = 0;
+    }
+
+    UEP[ep] = options;
+}
+
+USB_HANDLE USBTransferOnePacket(uint8_t ep, uint8_t dir, uint8_t *data,
+                                uint8_t len)
+{
+    volatile BDT_ENTRY *handle;
+
+    handle = (dir == IN_TO_HOST) ? pBDTEntryIn[ep] : pBDTEntryOut[ep];
+    if((handle == NULL) || (handle->STAT.UOWN != 0))
+    {
+        return NULL;
+    }
+
+    SIM_RememberBuffer(data);
+    handle->ADR = ConvertToPhysicalAddress(data);
+    handle->CNT = len;
+    handle->STAT.Val &= _DTSMASK;
+    handle->STAT.Val |= _DTSEN;
+    handle->STAT.Val |= _USIE;
+
+    if(dir == IN_TO_HOST)
+    {
+        pBDTEntryIn[ep] = (volatile BDT_ENTRY *)
+            ((uintptr_t)pBDTEntryIn[ep] ^ SIM_NEXT_PING_PONG);
+    }
+    else
+    {
+        pBDTEntryOut[ep] = (volatile BDT_ENTRY *)
+            ((uintptr_t)pBDTEntryOut[ep] ^ SIM_NEXT_PING_PONG);
+    }
+
+    return (USB_HANDLE)handle;
+}
+
+void USBDeviceTasks(void)
+{
+    uint8_t i;
+
+    //in the interrupt mode the vector only services the module while its
+    //interrupt is enabled; the firmware masks it to keep this out
+    #if defined(USB_INTERRUPT)
+    if(PIE2bits.USBIE == 0)
+    {
+        errors++;
+        fprintf(stderr, "sim: USB serviced with its interrupt masked at cycle %llu\n",
+                (unsigned long long)now);
+    }
+    #endif
+
+    if(UIRbits.ACTVIF && UIEbits.ACTVIE)
+    {
+        UIRbits.ACTVIF = 0;
+        USBBusIsSuspended = false;
+        USER_USB_CALLBACK_EVENT_HANDLER(EVENT_RESUME, 0, 0);
+        UCONbits.SUSPND = 0;
+        UIEbits.ACTVIE = 0;
+    }
+
+    if(UCONbits.SUSPND == 1)
+    {
+        PIR2bits.USBIF = 0;
+        return;
+    }
+
+    if(UIRbits.IDLEIF && UIEbits.IDLEIE)
+    {
+        UIEbits.ACTVIE = 1;
+        UIRbits.IDLEIF = 0;
+        UCONbits.SUSPND = 1;
+        USBBusIsSuspended = true;
+        USER_USB_CALLBACK_EVENT_HANDLER(EVENT_SUSPEND, 0, 0);
+    }
+
+    if(UIRbits.SOFIF)
+    {
+        if(UIEbits.SOFIE)
+        {
+            USER_USB_CALLBACK_EVENT_HANDLER(EVENT_SOF, 0, 1);
+        }
+        UIRbits.SOFIF = 0;
+    }
+
+    if(UIEbits.TRNIE)
+    {
+        while(ustatCount > 0)
+        {
+            USTAT = ustatFifo[0];
+            ustatCount--;
+            for(i = 0; i < ustatCount; i++)
+            {
+                ustatFifo[i] = ustatFifo[i + 1];
+            }
+
+            USER_USB_CALLBACK_EVENT_HANDLER(EVENT_TRANSFER, (uint8_t *)&USTAT, 0);
+        }
+        UIRbits.TRNIF = 0;
+    }
+
+    PIR2bits.USBIF = 0;
+}
+
+/*********************************************************************
+* Simulation control
+********************************************************************/
+static void SIM_Advance(uint32_t cycles)
+{
+    uint64_t end = now + cycles;
+    uint64_t next;
+    uint64_t event;
+
+    while(now < end)
+    {
+        next = end;
+        event = SIM_Timer2Next();
+        if(event < next)
+        {
+            next = event;
+        }
+        if((pinEventCount > 0) && (pinEvent[0].cycle < next))
+        {
+            next = (pinEvent[0].cycle > now) ? pinEvent[0].cycle : now;
+        }
+        event = SIM_UsbNext();
+        if(event < next)
+        {
+            next = event;
+        }
+
+        SIM_Timers((uint32_t)(next - now));
+        now = next;
+
+        SIM_PinEvents();
+        if(SIM_UsbNext() <= now)
+        {
+            SIM_UsbSlot();
+        }
+        SIM_Interrupts();
+    }
+}
+
+void SIM_PowerOn(void)
+{
+    TRISB = 0xF0;
+    ANSELB = 0x30;
+    WPUB = 0xF0;
+    TRISC = 0xFF;
+    ANSELC = 0xCF;
+    PR2 = 0xFF;
+    OPTION_REG = 0xFF;
+    SIM_Pins(0);
+    t2Tmr = TMR2;
+    t2Con = T2CON;
+
+    SIM_ParseEndpoints();
+
+    SYSTEM_Initialize(SYSTEM_STATE_USB_START);
+    USBDeviceInit();
+    USBDeviceAttach();
+}
+
+void SIM_Configure(void)
+{
+    uint8_t configuration = 1;
+    uint8_t ep;
+    bool gie = INTCONbits.GIE;
+
+    //as USBStdSetCfgHandler(): free the endpoints, then let the
+    //application enable its own before the state changes
+    for(ep = 1; ep < SIM_EP_COUNT; ep++)
+    {
+        memset((void *)&BDT[SIM_BD(ep, 0, 0)], 0, 4 * sizeof(BDT_ENTRY));
+        UEP[ep] = 0;
+        pBDTEntryIn[ep] = NULL;
+        pBDTEntryOut[ep] = NULL;
+        outCount[ep] = 0;
+    }
+    USBActiveConfiguration = configuration;
+
+    INTCONbits.GIE = 0;
+    USER_USB_CALLBACK_EVENT_HANDLER(EVENT_CONFIGURED, &configuration, 1);
+    INTCONbits.GIE = gie;
+    USBDeviceState = CONFIGURED_STATE;
+
+    if(usbRunning == false)
+    {
+        usbRunning = true;
+        frameStart = now;
+        usbSlot = 0;
+    }
+}
+
+void SIM_Run(uint32_t cycles)
+{
+    uint64_t end = now + cycles;
+
+    while(now < end)
+    {
+        APP_KeyboardTasks();
+        APP_DeviceCDCControlTasks();
+        APP_SettingsTasks();
+        if(loopHook != NULL)
+        {
+            loopHook();
+        }
+        loopCount++;
+
+        SIM_Advance(loopCycles);
+    }
+}
+
+uint64_t SIM_GetCycles(void)
+{
+    return now;
+}
+
+uint64_t SIM_GetSofCycle(void)
+{
+    return sofCycle;
+}
+
+uint32_t SIM_GetLoopCount(void)
+{
+    return loopCount;
+}
+
+void SIM_SetLoopCycles(uint16_t cycles)
+{
+    loopCycles = (cycles > 0) ? cycles : 1;
+}
+
+void SIM_SetLoopHook(SIM_LOOP_HOOK hook)
+{
+    loopHook = hook;
+}
+
+void SIM_SetInHandler(SIM_IN_HANDLER handler)
+{
+    inHandler = handler;
+}
+
+uint32_t SIM_GetInCount(uint8_t ep)
+{
+    return inCount[ep];
+}
+
+bool SIM_HostOut(uint8_t ep, const uint8_t *data, uint8_t len)
+{
+    SIM_PACKET *packet;
+
+    if((outCount[ep] == SIM_OUT_QUEUE) || (len > sizeof(packet->data)))
+    {
+        return false;
+    }
+
+    packet = &outQueue[ep][(outHead[ep] + outCount[ep]) % SIM_OUT_QUEUE];
+    packet->len = len;
+    memcpy(packet->data, data, len);
+    outCount[ep]++;
+    return true;
+}
+
+uint8_t SIM_GetArmed(uint8_t ep, uint8_t dir)
+{
+    return (uint8_t)(BDT[SIM_BD(ep, dir, 0)].STAT.UOWN +
+                     BDT[SIM_BD(ep, dir, 1)].STAT.UOWN);
+}
+
+int SIM_ControlRequest(uint8_t requestType, uint8_t request, uint16_t value,
+                       uint16_t index, uint8_t *data, uint16_t length)
+{
+    uint8_t setup[8];
+    uint16_t count;
+    int result = -1;
+    bool gie = INTCONbits.GIE;
+
+    setup[0] = requestType;
+    setup[1] = request;
+    setup[2] = (uint8_t)value;
+    setup[3] = (uint8_t)(value >> 8);
+    setup[4] = (uint8_t)index;
+    setup[5] = (uint8_t)(index >> 8);
+    setup[6] = (uint8_t)length;
+    setup[7] = (uint8_t)(length >> 8);
+    memcpy((void *)&SetupPkt, setup, sizeof(setup));
+
+    //the remote wakeup feature is the one standard request handled here
+    if((requestType == 0x00) && (value == USB_FEATURE_DEVICE_REMOTE_WAKEUP) &&
+       ((request == USB_REQUEST_SET_FEATURE) || (request == USB_REQUEST_CLEAR_FEATURE)))
+    {
+        RemoteWakeup = (request == USB_REQUEST_SET_FEATURE) ? true : false;
+        return 0;
+    }
+
+    inPipes[0].info.Val = 0;
+    outPipes[0].info.Val = 0;
+
+    INTCONbits.GIE = 0;
+    USER_USB_CALLBACK_EVENT_HANDLER(EVENT_EP0_REQUEST, 0, 0);
+
+    if(inPipes[0].info.bits.busy)
+    {
+        count = (inPipes[0].wCount.Val < length) ? inPipes[0].wCount.Val : length;
+        if(inPipes[0].info.bits.ctrl_trf_mem == USB_EP0_RAM)
+        {
+            memcpy(data, (const void *)inPipes[0].pSrc.bRam, count);
+        }
+        else
+        {
+            memcpy(data, inPipes[0].pSrc.bRom, count);
+        }
+        result = count;
+    }
+    else if(outPipes[0].info.bits.busy)
+    {
+        count = (outPipes[0].wCount.Val < length) ? outPipes[0].wCount.Val : length;
+        memcpy((void *)outPipes[0].pDst.bRam, data, count);
+        if(outPipes[0].pFunc != NULL)
+        {
+            outPipes[0].pFunc();
+        }
+        result = count;
+    }
+
+    INTCONbits.GIE = gie;
+    inPipes[0].info.Val = 0;
+    outPipes[0].info.Val = 0;
+    return result;
+}
+
+void SIM_GetFeaturePage(uint8_t *page)
+{
+    bool gie = INTCONbits.GIE;
+
+    memset(&page[1], 0, 7);
+    INTCONbits.GIE = 0;
+    APP_KeyboardGetFeaturePage(page);
+    INTCONbits.GIE = gie;
+}
+
+bool SIM_SetFeaturePage(const uint8_t *page)
+{
+    uint8_t report[9];
+
+    report[0] = 4;  //feature report ID
+    memcpy(&report[1], page, 8);
+    return SIM_ControlRequest(0x21, SET_REPORT, 0x0300 | report[0],
+                              HID_INTF_ID, report, sizeof(report)) == sizeof(report);
+}
+
+void SIM_Suspend(bool suspend)
+{
+    busSuspended = suspend;
+    if(suspend == true)
+    {
+        UIRbits.IDLEIF = 1;
+    }
+    else
+    {
+        UIRbits.ACTVIF = 1;
+    }
+    SIM_UsbFlag();
+    SIM_Interrupts();
+}
+
+bool SIM_IsSuspended(void)
+{
+    return busSuspended;
+}
+
+uint16_t SIM_GetRemoteWakeups(void)
+{
+    return remoteWakeups;
+}
+
+uint16_t SIM_GetErrors(void)
+{
+    return errors;
+}
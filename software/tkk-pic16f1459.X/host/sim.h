@@ -0,0 +1,398 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Host simulation of the parts of the PIC16F1459 the keyboard firmware
+ * uses: the key pins with interrupt-on-change, Timer1, Timer2, the
+ * interrupt vector, and the USB module with a host that polls the
+ * endpoints the configuration descriptor lists.  The firmware runs in
+ * zero time; each main loop pass is charged a fixed number of
+ * instruction cycles, and the peripherals and interrupts are played
+ * between passes.  The firmware is linked once per program, so a test
+ * runs its cases one after another on the same device. */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*** Simulation Definitions *****************************************/
+/* Instruction clock, Fosc/4 with the 48MHz system clock. */
+#define SIM_CYCLES_PER_SECOND   12000000UL
+#define SIM_CYCLES_PER_MS       (SIM_CYCLES_PER_SECOND / 1000)
+
+/* Cycles charged for a main loop pass until SIM_SetLoopCycles(). */
+#define SIM_LOOP_CYCLES         600
+
+/* Key pins on PORTB, as closed-key masks for SIM_SetKeys(). */
+#define SIM_KEY_S1              0x40    // RB6
+#define SIM_KEY_S2              0x20    // RB5
+#define SIM_KEY_S3              0x10    // RB4
+#define SIM_KEY_ALL             (SIM_KEY_S1 | SIM_KEY_S2 | SIM_KEY_S3)
+
+/* Called with every packet the host receives from an IN endpoint. */
+typedef void (*SIM_IN_HANDLER)(uint8_t ep, const uint8_t *data, uint8_t len);
+
+/* Called after every main loop pass, in main loop context. */
+typedef void (*SIM_LOOP_HOOK)(void);
+
+/*********************************************************************
+* Function: void SIM_PowerOn(void);
+*
+* Overview: Sets the registers to their power-on values and runs the
+*           start of main(): system initialization and USB attach.
+*
+* PreCondition: Called once, before anything else.
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void SIM_PowerOn(void);
+
+/*********************************************************************
+* Function: void SIM_Configure(void);
+*
+* Overview: Plays the host's SET_CONFIGURATION(1) and starts the frame
+*           clock.  The endpoints are then polled at their intervals.
+*
+* PreCondition: SIM_PowerOn()
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void SIM_Configure(void);
+
+/*********************************************************************
+* Function: void SIM_Run(uint32_t cycles);
+*
+* Overview: Runs the main loop for at least the given number of
+*           instruction cycles, playing the peripherals between passes.
+*
+* PreCondition: SIM_PowerOn()
+*
+* Input: uint32_t cycles - instruction cycles to run
+*
+* Output: None
+*
+********************************************************************/
+void SIM_Run(uint32_t cycles);
+#define SIM_RunMs(ms)       SIM_Run((uint32_t)(ms) * SIM_CYCLES_PER_MS)
+
+/*********************************************************************
+* Function: uint64_t SIM_GetCycles(void);
+*
+* Overview: Instruction cycles since power on.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: cycle count
+*
+********************************************************************/
+uint64_t SIM_GetCycles(void);
+
+/*********************************************************************
+* Function: uint64_t SIM_GetSofCycle(void);
+*
+* Overview: Cycle the host sent the last start-of-frame at.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: cycle count, 0 before the first frame
+*
+********************************************************************/
+uint64_t SIM_GetSofCycle(void);
+
+/*********************************************************************
+* Function: uint32_t SIM_GetLoopCount(void);
+*
+* Overview: Main loop passes since power on.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: pass count
+*
+********************************************************************/
+uint32_t SIM_GetLoopCount(void);
+
+/*********************************************************************
+* Function: void SIM_SetLoopCycles(uint16_t cycles);
+*
+* Overview: Sets the cycles charged for each main loop pass.
+*
+* PreCondition: None
+*
+* Input: uint16_t cycles - cycles per pass, at least 1
+*
+* Output: None
+*
+********************************************************************/
+void SIM_SetLoopCycles(uint16_t cycles);
+
+/*********************************************************************
+* Function: void SIM_SetLoopHook(SIM_LOOP_HOOK hook);
+*
+* Overview: Sets a function to run after every main loop pass, for
+*           application code a test adds to the loop.
+*
+* PreCondition: None
+*
+* Input: SIM_LOOP_HOOK hook - the function, or NULL for none
+*
+* Output: None
+*
+********************************************************************/
+void SIM_SetLoopHook(SIM_LOOP_HOOK hook);
+
+/*********************************************************************
+* Function: void SIM_SetKeys(uint8_t closed);
+*
+* Overview: Sets the key contacts now, cleanly.
+*
+* PreCondition: SIM_PowerOn()
+*
+* Input: uint8_t closed - SIM_KEY_ mask of the closed contacts
+*
+* Output: None
+*
+********************************************************************/
+void SIM_SetKeys(uint8_t closed);
+
+/*********************************************************************
+* Function: void SIM_ScheduleKeys(uint64_t cycle, uint8_t mask,
+*                                 uint8_t closed);
+*
+* Overview: Sets the contacts in mask at the given cycle; the others
+*           keep their state.
+*
+* PreCondition: None
+*
+* Input: uint64_t cycle - cycle the change happens at
+*        uint8_t mask - SIM_KEY_ mask of the contacts that change
+*        uint8_t closed - SIM_KEY_ mask of the contacts closed after it
+*
+* Output: None
+*
+********************************************************************/
+void SIM_ScheduleKeys(uint64_t cycle, uint8_t mask, uint8_t closed);
+
+/*********************************************************************
+* Function: void SIM_Bounce(uint64_t cycle, uint8_t mask, uint8_t closed,
+*                           uint8_t bounces, uint32_t spacing);
+*
+* Overview: Schedules a bouncing change: the contacts in mask go to
+*           their new state at the given cycle, chatter back and forth
+*           the given number of times, and settle in the new state.
+*
+* PreCondition: None
+*
+* Input: uint64_t cycle - cycle of the first edge
+*        uint8_t mask - SIM_KEY_ mask of the contacts that change
+*        uint8_t closed - SIM_KEY_ mask of the contacts closed after it
+*        uint8_t bounces - times the contacts return to the old state
+*        uint32_t spacing - cycles between edges
+*
+* Output: None
+*
+********************************************************************/
+void SIM_Bounce(uint64_t cycle, uint8_t mask, uint8_t closed,
+                uint8_t bounces, uint32_t spacing);
+
+/*********************************************************************
+* Function: void SIM_SetInHandler(SIM_IN_HANDLER handler);
+*
+* Overview: Sets the function the host passes every IN packet to.
+*
+* PreCondition: None
+*
+* Input: SIM_IN_HANDLER handler - the function, or NULL for none
+*
+* Output: None
+*
+********************************************************************/
+void SIM_SetInHandler(SIM_IN_HANDLER handler);
+
+/*********************************************************************
+* Function: uint32_t SIM_GetInCount(uint8_t ep);
+*
+* Overview: Packets the host has received from an IN endpoint.
+*
+* PreCondition: None
+*
+* Input: uint8_t ep - endpoint number
+*
+* Output: packet count
+*
+********************************************************************/
+uint32_t SIM_GetInCount(uint8_t ep);
+
+/*********************************************************************
+* Function: bool SIM_HostOut(uint8_t ep, const uint8_t *data, uint8_t len);
+*
+* Overview: Queues a packet for the host to send to an OUT endpoint.
+*           It is sent at the endpoint's next poll the device accepts.
+*
+* PreCondition: None
+*
+* Input: uint8_t ep - endpoint number
+*        const uint8_t *data - packet
+*        uint8_t len - packet length, up to 64
+*
+* Output: false if the host's queue for the endpoint is full
+*
+********************************************************************/
+bool SIM_HostOut(uint8_t ep, const uint8_t *data, uint8_t len);
+
+/*********************************************************************
+* Function: uint8_t SIM_GetArmed(uint8_t ep, uint8_t dir);
+*
+* Overview: Buffer descriptors of an endpoint the firmware has handed to
+*           the USB module.
+*
+* PreCondition: None
+*
+* Input: uint8_t ep - endpoint number
+*        uint8_t dir - OUT_FROM_HOST or IN_TO_HOST
+*
+* Output: 0, 1 or 2
+*
+********************************************************************/
+uint8_t SIM_GetArmed(uint8_t ep, uint8_t dir);
+
+/*********************************************************************
+* Function: int SIM_ControlRequest(uint8_t requestType, uint8_t request,
+*                uint16_t value, uint16_t index, uint8_t *data,
+*                uint16_t length);
+*
+* Overview: Plays a control transfer on endpoint 0 from the USB
+*           interrupt.  A request with a data stage to the device sends
+*           data; one from the device fills it.
+*
+* PreCondition: SIM_PowerOn()
+*
+* Input: the setup packet fields and the data stage buffer
+*
+* Output: bytes in the data stage, or -1 if the request stalled
+*
+********************************************************************/
+int SIM_ControlRequest(uint8_t requestType, uint8_t request, uint16_t value,
+                       uint16_t index, uint8_t *data, uint16_t length);
+
+/*********************************************************************
+* Function: void SIM_GetFeaturePage(uint8_t *page);
+*
+* Overview: Reads a page of the 8 byte feature report as GET_REPORT
+*           does, without changing the page later requests read.
+*
+* PreCondition: SIM_Configure()
+*
+* Input: uint8_t *page - 8 byte buffer, the page number first
+*
+* Output: None
+*
+********************************************************************/
+void SIM_GetFeaturePage(uint8_t *page);
+
+/*********************************************************************
+* Function: bool SIM_SetFeaturePage(const uint8_t *page);
+*
+* Overview: Sends an 8 byte feature report with SET_REPORT.
+*
+* PreCondition: SIM_Configure()
+*
+* Input: const uint8_t *page - the report, page number first
+*
+* Output: false if the request stalled
+*
+********************************************************************/
+bool SIM_SetFeaturePage(const uint8_t *page);
+
+/*********************************************************************
+* Function: void SIM_Suspend(bool suspend);
+*
+* Overview: Suspends the bus, or resumes it from the host.
+*
+* PreCondition: SIM_Configure()
+*
+* Input: bool suspend - true to suspend, false to resume
+*
+* Output: None
+*
+********************************************************************/
+void SIM_Suspend(bool suspend);
+
+/*********************************************************************
+* Function: bool SIM_IsSuspended(void);
+*
+* Overview: Whether the bus is suspended.  Ends when the host or the
+*           device resumes it.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: true while suspended
+*
+********************************************************************/
+bool SIM_IsSuspended(void);
+
+/*********************************************************************
+* Function: uint16_t SIM_GetRemoteWakeups(void);
+*
+* Overview: Remote wakeup signals the device has driven on the bus.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: signal count
+*
+********************************************************************/
+uint16_t SIM_GetRemoteWakeups(void);
+
+/*********************************************************************
+* Function: uint16_t SIM_GetErrors(void);
+*
+* Overview: Protocol errors the host has seen: packets longer than the
+*           endpoint's wMaxPacketSize or than the buffer the device
+*           armed.  Also counts USBDeviceTasks() run while the USB
+*           interrupt is masked.  Each is also reported on stderr.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: error count
+*
+********************************************************************/
+uint16_t SIM_GetErrors(void);
+
+#endif //SIM_H
@@ -0,0 +1,330 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* The CDC data port's bulk IN path with both ping-pong buffers: one
+ * CDCTxService() call queues two packets, a transfer that ends on a full
+ * packet is closed with a zero length packet, and USBUSARTIsTxTrfReady()
+ * turns true only once the whole transfer has been copied out.  The OUT
+ * path keeps both buffers armed and loses no packet while the control
+ * port answers.  The USB interrupt is masked only inside a driver call,
+ * and an interrupt taken meanwhile leaves the USB module alone. */
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "usb.h"
+#include "usb_device_cdc.h"
+#include "app_device_keyboard.h"
+
+#include "sim.h"
+#include "check.h"
+
+#define PACKETS_MAX     16
+
+/* One GET answer of the control port: 8 bytes in hex, CR LF. */
+#define ANSWER_LENGTH   (3 * APP_FEATURE_REPORT_SIZE + 1)
+
+void SYS_InterruptHigh(void);
+
+static uint8_t sent[255];
+static uint8_t received[255 + CDC_DATA_IN_EP_SIZE];
+static uint16_t receivedCount;
+static uint8_t packetLength[PACKETS_MAX];
+static uint8_t packetCount;
+
+static void CountIn(uint8_t ep, const uint8_t *data, uint8_t len)
+{
+    if(ep != CDC_DATA_EP)
+    {
+        return;
+    }
+
+    if(packetCount < PACKETS_MAX)
+    {
+        packetLength[packetCount] = len;
+    }
+    packetCount++;
+    if(receivedCount + len <= sizeof(received))
+    {
+        memcpy(&received[receivedCount], data, len);
+    }
+    receivedCount += len;
+}
+
+static void Clear(void)
+{
+    receivedCount = 0;
+    packetCount = 0;
+}
+
+/* Runs a pass at a time until the driver is ready for the next transfer;
+ * by then all of this one has been received or is in the IN buffers. */
+static void RunUntilReady(uint16_t length)
+{
+    uint16_t passes;
+
+    for(passes = 0; (USBUSARTIsTxTrfReady() == false) && (passes < 1000); passes++)
+    {
+        SIM_Run(1);
+    }
+    CHECK(USBUSARTIsTxTrfReady() == true);
+    CHECK(receivedCount + (SIM_GetArmed(CDC_DATA_EP, IN_TO_HOST) *
+                           CDC_DATA_IN_EP_SIZE) >= length);
+}
+
+/* 200 bytes: two packets queued by the first service call, then 64 and 8. */
+static void TestTwoInFlight(void)
+{
+    Clear();
+    CHECK(USBUSARTIsTxTrfReady() == true);
+    CHECK(SIM_GetArmed(CDC_DATA_EP, IN_TO_HOST) == 0);
+
+    putUSBUSART(sent, 200);
+    CHECK(USBUSARTIsTxTrfReady() == false);
+    CDCTxService();
+    CHECK(SIM_GetArmed(CDC_DATA_EP, IN_TO_HOST) == 2);
+    CHECK(cdc_trf_state == CDC_TX_BUSY);
+
+    RunUntilReady(200);
+    SIM_RunMs(2);
+    CHECK(receivedCount == 200);
+    CHECK(memcmp(received, sent, 200) == 0);
+    CHECK(packetCount == 4);
+    CHECK(packetLength[0] == 64);
+    CHECK(packetLength[1] == 64);
+    CHECK(packetLength[2] == 64);
+    CHECK(packetLength[3] == 8);
+    CHECK(SIM_GetArmed(CDC_DATA_EP, IN_TO_HOST) == 0);
+}
+
+/* 128 bytes: both full packets in one call, then the zero length packet
+ * before the driver is ready again. */
+static void TestZeroLengthPacket(void)
+{
+    Clear();
+    putUSBUSART(sent, 128);
+    CDCTxService();
+    CHECK(SIM_GetArmed(CDC_DATA_EP, IN_TO_HOST) == 2);
+    CHECK(cdc_trf_state == CDC_TX_BUSY_ZLP);
+
+    RunUntilReady(128);
+    SIM_RunMs(2);
+    CHECK(receivedCount == 128);
+    CHECK(memcmp(received, sent, 128) == 0);
+    CHECK(packetCount == 3);
+    CHECK(packetLength[0] == 64);
+    CHECK(packetLength[1] == 64);
+    CHECK(packetLength[2] == 0);
+}
+
+/* A transfer that fits one packet leaves the other buffer idle, so the
+ * same service call makes the driver ready while the packet is still on
+ * its way. */
+static void TestShortTransfer(void)
+{
+    Clear();
+    putUSBUSART(sent, 10);
+    CDCTxService();
+    CHECK(SIM_GetArmed(CDC_DATA_EP, IN_TO_HOST) == 1);
+    CHECK(USBUSARTIsTxTrfReady() == true);
+    CHECK(receivedCount == 0);
+
+    SIM_RunMs(2);
+    CHECK(receivedCount == 10);
+    CHECK(packetCount == 1);
+}
+
+/* Transfers back to back, each started as soon as the driver is ready,
+ * arrive whole and in order. */
+static void TestBackToBack(void)
+{
+    uint8_t i;
+
+    Clear();
+    for(i = 0; i < 3; i++)
+    {
+        putUSBUSART(&sent[i * 50], 50);
+        RunUntilReady((uint16_t)((i + 1) * 50));
+    }
+    SIM_RunMs(2);
+    CHECK(receivedCount == 150);
+    CHECK(memcmp(received, sent, 150) == 0);
+}
+
+/* Sends one line or part of one per packet and lets the control port
+ * answer. */
+static void Request(const char *packet1, const char *packet2)
+{
+    Clear();
+    CHECK(SIM_HostOut(CDC_DATA_EP, (const uint8_t *)packet1, (uint8_t)strlen(packet1)) == true);
+    if(packet2 != NULL)
+    {
+        CHECK(SIM_HostOut(CDC_DATA_EP, (const uint8_t *)packet2, (uint8_t)strlen(packet2)) == true);
+    }
+    SIM_RunMs(10);
+}
+
+static bool IsAnswer(uint16_t at, const char *page)
+{
+    return (memcmp(&received[at], page, 3) == 0) &&
+           (memcmp(&received[at + ANSWER_LENGTH - 2], "\r\n", 2) == 0);
+}
+
+static void TestReceive(void)
+{
+    static const uint8_t nothing[1];
+    uint8_t i;
+
+    //both OUT buffers wait for the host
+    CHECK(SIM_GetArmed(CDC_DATA_EP, OUT_FROM_HOST) == 2);
+
+    Request("03\r\n", NULL);
+    CHECK(receivedCount == ANSWER_LENGTH);
+    CHECK(IsAnswer(0, "03 "));
+
+    //a line split over two packets
+    Request("0", "3\r\n");
+    CHECK(receivedCount == ANSWER_LENGTH);
+    CHECK(IsAnswer(0, "03 "));
+
+    //two lines in one packet, answered in turn
+    Request("00\r\n03\r\n", NULL);
+    CHECK(receivedCount == 2 * ANSWER_LENGTH);
+    CHECK(IsAnswer(0, "00 "));
+    CHECK(IsAnswer(ANSWER_LENGTH, "03 "));
+
+    Request("zz\r\n", NULL);
+    CHECK(receivedCount == 3);
+    CHECK(memcmp(received, "?\r\n", 3) == 0);
+
+    //a zero length packet is released, never handed out
+    Clear();
+    CHECK(SIM_HostOut(CDC_DATA_EP, nothing, 0) == true);
+    CHECK(SIM_HostOut(CDC_DATA_EP, (const uint8_t *)"03\r\n", 4) == true);
+    SIM_RunMs(10);
+    CHECK(receivedCount == ANSWER_LENGTH);
+
+    //a full host queue while answers are pending: every line is answered
+    Clear();
+    for(i = 0; i < 8; i++)
+    {
+        CHECK(SIM_HostOut(CDC_DATA_EP, (const uint8_t *)"03\r\n", 4) == true);
+    }
+    SIM_RunMs(20);
+    CHECK(receivedCount == 8 * ANSWER_LENGTH);
+    for(i = 0; i < 8; i++)
+    {
+        CHECK(IsAnswer((uint16_t)(i * ANSWER_LENGTH), "03 "));
+    }
+    CHECK(SIM_GetArmed(CDC_DATA_EP, OUT_FROM_HOST) == 2);
+}
+
+static uint32_t openPasses;
+
+/* Keeps both directions busy, and checks no masked window is left open at
+ * the end of a pass, where the sim takes interrupts. */
+static void Busy(void)
+{
+    if(USBUSARTIsTxTrfReady() == true)
+    {
+        putUSBUSART(sent, 100);
+    }
+    SIM_HostOut(CDC_DATA_EP, (const uint8_t *)"03\r\n", 4);
+
+    if((PIE2bits.USBIE == 0) || (T1CONbits.TMR1ON == 1))
+    {
+        openPasses++;
+    }
+}
+
+/* The sim runs the firmware in zero time, so each masked window reads 0
+ * cycles on Timer1 unless it stays open across a pass. */
+static void TestMaskedWindow(void)
+{
+    uint8_t page[8];
+
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_STATUS;
+    page[1] = APP_FEATURE_CLEAR_STATS;
+    CHECK(SIM_SetFeaturePage(page) == true);
+
+    SIM_SetLoopHook(Busy);
+    SIM_RunMs(100);
+    SIM_SetLoopHook(NULL);
+    SIM_RunMs(20);
+    CHECK(openPasses == 0);
+    CHECK(SIM_GetInCount(CDC_DATA_EP) != 0);
+
+    page[0] = APP_FEATURE_PAGE_LOOP;
+    SIM_GetFeaturePage(page);
+    CHECK((page[5] | (page[6] << 8)) == 0);
+    CHECK(CDCGetMaskedCycles() == 0);
+}
+
+/* A scan tick taken while the driver has the USB interrupt masked runs,
+ * and leaves the USB module's flags for when it is unmasked. */
+static void TestInterruptWhileMasked(void)
+{
+    USBMaskInterrupts();
+    UIRbits.SOFIF = 1;
+    PIR2bits.USBIF = 1;
+    PIR1bits.TMR2IF = 1;
+
+    INTCONbits.GIE = 0;
+    SYS_InterruptHigh();
+    INTCONbits.GIE = 1;
+    CHECK(PIR1bits.TMR2IF == 0);
+    CHECK(UIRbits.SOFIF == 1);
+    CHECK(PIR2bits.USBIF == 1);
+    CHECK(SIM_GetErrors() == 0);
+
+    USBUnmaskInterrupts();
+    SIM_RunMs(2);
+    CHECK(UIRbits.SOFIF == 0);
+}
+
+int main(void)
+{
+    uint16_t i;
+
+    for(i = 0; i < sizeof(sent); i++)
+    {
+        sent[i] = (uint8_t)(i * 7);
+    }
+
+    SIM_PowerOn();
+    SIM_Configure();
+    SIM_SetInHandler(CountIn);
+    SIM_RunMs(10);
+
+    TestTwoInFlight();
+    TestZeroLengthPacket();
+    TestShortTransfer();
+    TestBackToBack();
+    TestReceive();
+    TestMaskedWindow();
+    TestInterruptWhileMasked();
+
+    CHECK(SIM_GetErrors() == 0);
+    return CHECK_DONE("test_cdc");
+}
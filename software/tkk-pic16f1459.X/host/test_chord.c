@@ -0,0 +1,216 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Chords of the three key board, S1 S2 d, S2 S3 e, S1 S3 f and all three
+ * Escape, with eager debounce so the hold back is most of the latency:
+ * a chord pressed, a key released inside the window, the last key of the
+ * only chord left cutting the window short, and the window passing.  A
+ * press is never held back longer than the chord window, by the host's
+ * clock or by the longest delay on APP_FEATURE_PAGE_CHORD. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "buttons.h"
+#include "app_device_keyboard.h"
+#include "app_chord.h"
+
+#include "sim.h"
+#include "report.h"
+#include "check.h"
+
+#define USAGE_A         0x04
+#define USAGE_B         0x05
+#define USAGE_C         0x06
+#define USAGE_D         0x07
+#define USAGE_E         0x08
+#define USAGE_F         0x09
+#define USAGE_ESCAPE    0x29
+
+/* Eager debounce reports a press within a tick, a poll and a pass. */
+#define LATENCY_MAX     (2 * SIM_CYCLES_PER_MS)
+
+static uint8_t window = APP_CHORD_WINDOW_DEFAULT;
+
+static void SetWindow(uint8_t ms)
+{
+    uint8_t page[8];
+
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_CHORD;
+    page[1] = ms;
+    CHECK(SIM_SetFeaturePage(page) == true);
+    window = ms;
+}
+
+static uint8_t GetLongestDelay(void)
+{
+    uint8_t page[8];
+
+    page[0] = APP_FEATURE_PAGE_CHORD;
+    SIM_GetFeaturePage(page);
+    return page[3];
+}
+
+static void ReleaseAll(void)
+{
+    SIM_SetKeys(0);
+    SIM_RunMs(100);
+}
+
+/* No key's own usage is pressed while its chord is. */
+static void CheckNoKeys(void)
+{
+    CHECK(REPORT_GetPresses(USAGE_A) == 0);
+    CHECK(REPORT_GetPresses(USAGE_B) == 0);
+    CHECK(REPORT_GetPresses(USAGE_C) == 0);
+}
+
+/* Two keys that are also part of the three key chord wait out the window
+ * from the first press, then press their chord. */
+static void TestChordPress(uint8_t first, uint8_t second, uint8_t usage)
+{
+    uint64_t start;
+
+    REPORT_Clear();
+    start = SIM_GetCycles();
+    SIM_ScheduleKeys(start, first, first);
+    SIM_ScheduleKeys(start + 10 * SIM_CYCLES_PER_MS, second, second);
+    SIM_RunMs(window + 20);
+    CHECK(REPORT_IsDown(usage) == true);
+    CHECK(REPORT_GetPresses(usage) == 1);
+    CHECK(REPORT_GetPressCycle(usage) >= start + (window - 1) * SIM_CYCLES_PER_MS);
+    CHECK(REPORT_GetPressCycle(usage) <= start + window * SIM_CYCLES_PER_MS + LATENCY_MAX);
+    CheckNoKeys();
+
+    //the first key up releases the chord
+    SIM_ScheduleKeys(SIM_GetCycles(), first, 0);
+    SIM_RunMs(20);
+    CHECK(REPORT_IsDown(usage) == false);
+    ReleaseAll();
+    CHECK(REPORT_GetPresses(usage) == 1);
+    CheckNoKeys();
+}
+
+/* A key released inside the window is pressed then, not at its end.  The
+ * release is an event once the release lockout has passed. */
+static void TestReleaseInWindow(void)
+{
+    uint64_t start;
+    uint64_t released;
+
+    REPORT_Clear();
+    start = SIM_GetCycles();
+    released = start + (5 + BUTTON_RELEASE_LOCKOUT_DEFAULT) * SIM_CYCLES_PER_MS;
+    SIM_ScheduleKeys(start, SIM_KEY_S2, SIM_KEY_S2);
+    SIM_ScheduleKeys(start + 5 * SIM_CYCLES_PER_MS, SIM_KEY_S2, 0);
+    SIM_RunMs(window + 20);
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+    CHECK(REPORT_GetPressCycle(USAGE_B) >= released - SIM_CYCLES_PER_MS);
+    CHECK(REPORT_GetPressCycle(USAGE_B) <= released + LATENCY_MAX);
+    CHECK(REPORT_IsDown(USAGE_B) == false);
+}
+
+/* Every key is in a chord on this board, so no key outside the chords can
+ * cut the window short; the key that leaves a single chord possible does.
+ * S1 and S3 could be f or Escape; S2 makes it Escape at once. */
+static void TestCutShort(void)
+{
+    uint64_t start;
+    uint64_t last;
+
+    REPORT_Clear();
+    start = SIM_GetCycles();
+    last = start + 15 * SIM_CYCLES_PER_MS;
+    SIM_ScheduleKeys(start, SIM_KEY_S1, SIM_KEY_S1);
+    SIM_ScheduleKeys(start + 5 * SIM_CYCLES_PER_MS, SIM_KEY_S3, SIM_KEY_S3);
+    SIM_ScheduleKeys(last, SIM_KEY_S2, SIM_KEY_S2);
+    SIM_RunMs(window + 20);
+    CHECK(REPORT_IsDown(USAGE_ESCAPE) == true);
+    CHECK(REPORT_GetPressCycle(USAGE_ESCAPE) >= last);
+    CHECK(REPORT_GetPressCycle(USAGE_ESCAPE) <= last + LATENCY_MAX);
+    CHECK(REPORT_GetPresses(USAGE_F) == 0);
+    CheckNoKeys();
+    ReleaseAll();
+    CHECK(REPORT_IsDown(USAGE_ESCAPE) == false);
+}
+
+/* A key held alone is pressed once the window has passed. */
+static void TestWindowExpiry(void)
+{
+    uint64_t start;
+
+    REPORT_Clear();
+    start = SIM_GetCycles();
+    SIM_ScheduleKeys(start, SIM_KEY_S2, SIM_KEY_S2);
+    SIM_RunMs(window + 20);
+    CHECK(REPORT_IsDown(USAGE_B) == true);
+    CHECK(REPORT_GetPressCycle(USAGE_B) >= start + (window - 1) * SIM_CYCLES_PER_MS);
+    CHECK(REPORT_GetPressCycle(USAGE_B) <= start + window * SIM_CYCLES_PER_MS + LATENCY_MAX);
+    ReleaseAll();
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+}
+
+static void TestAll(void)
+{
+    uint8_t page[8];
+
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_STATUS;
+    page[1] = APP_FEATURE_CLEAR_STATS;
+    CHECK(SIM_SetFeaturePage(page) == true);
+
+    TestChordPress(SIM_KEY_S1, SIM_KEY_S2, USAGE_D);
+    TestChordPress(SIM_KEY_S2, SIM_KEY_S3, USAGE_E);
+    TestChordPress(SIM_KEY_S3, SIM_KEY_S1, USAGE_F);
+    TestReleaseInWindow();
+    TestCutShort();
+    TestWindowExpiry();
+
+    //the window was waited out, and never exceeded
+    CHECK(GetLongestDelay() >= window - 1);
+    CHECK(GetLongestDelay() <= window);
+}
+
+int main(void)
+{
+    uint8_t page[8];
+
+    SIM_PowerOn();
+    REPORT_Attach();
+    SIM_Configure();
+
+    page[0] = APP_FEATURE_PAGE_SETTINGS;
+    SIM_GetFeaturePage(page);
+    page[1] = BUTTON_DEBOUNCE_EAGER;
+    page[5] = 0;
+    CHECK(SIM_SetFeaturePage(page) == true);
+    SIM_RunMs(100);
+
+    TestAll();
+    SetWindow(20);
+    TestAll();
+    SetWindow(APP_CHORD_WINDOW_DEFAULT);
+
+    CHECK(SIM_GetErrors() == 0);
+    return CHECK_DONE("test_chord");
+}
@@ -0,0 +1,239 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Edge-to-report latency of the two debounce algorithms, and their
+ * press and release rules: BUTTON_DEBOUNCE_EAGER presses on the first
+ * sample and releases once the contact has read open for the release
+ * lockout; BUTTON_DEBOUNCE_STATE_MACHINE (the vertical counter) needs
+ * two samples in a row for either.  Both count every raw edge of a
+ * bounce in the key statistics.  Prints one latency line per mode. */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "buttons.h"
+#include "app_device_keyboard.h"
+
+#include "sim.h"
+#include "report.h"
+#include "check.h"
+
+#define USAGE_B     0x05
+#define TRIALS      64
+#define CYCLES_PER_US   (SIM_CYCLES_PER_SECOND / 1000000UL)
+
+static uint32_t seed = 1;
+
+/* Start of the next trial: a pseudo-random phase against the tick, the
+ * frame and the state machine's sample period, so the trials sample the
+ * whole latency range. */
+static uint64_t NextStart(void)
+{
+    seed = (seed * 1103515245UL) + 12345UL;
+    return SIM_GetCycles() +
+           ((seed >> 8) % (2 * BUTTON_SAMPLE_PERIOD_DEFAULT * SIM_CYCLES_PER_MS));
+}
+
+static int CompareLatency(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void SetDebounceMode(BUTTON_DEBOUNCE_MODE mode)
+{
+    uint8_t page[8];
+
+    page[0] = APP_FEATURE_PAGE_SETTINGS;
+    SIM_GetFeaturePage(page);
+    page[1] = (uint8_t)mode;
+    page[5] = 0;
+    CHECK(SIM_SetFeaturePage(page) == true);
+    SIM_RunMs(50);
+}
+
+/* Runs until the host sees 'b' in the given state; returns the cycle it
+ * did, to a loop pass. */
+static uint64_t RunUntil(bool down, uint16_t limitMs)
+{
+    uint64_t end = SIM_GetCycles() + (uint64_t)limitMs * SIM_CYCLES_PER_MS;
+
+    while((REPORT_IsDown(USAGE_B) != down) && (SIM_GetCycles() < end))
+    {
+        SIM_Run(1);
+    }
+    return SIM_GetCycles();
+}
+
+/* Times TRIALS bounced presses of S2 from the first edge to the report
+ * and prints the worst and the median in microseconds. */
+static void MeasureLatency(const char *name, uint32_t *best, uint32_t *worst)
+{
+    uint32_t latency[TRIALS];
+    uint64_t start;
+    uint16_t i;
+
+    for(i = 0; i < TRIALS; i++)
+    {
+        REPORT_Clear();
+        start = NextStart();
+        SIM_Bounce(start, SIM_KEY_S2, SIM_KEY_S2, 3, 30 * CYCLES_PER_US);
+        RunUntil(true, 50);
+        CHECK(REPORT_GetPresses(USAGE_B) == 1);
+        latency[i] = (uint32_t)((REPORT_GetPressCycle(USAGE_B) - start) / CYCLES_PER_US);
+
+        SIM_Bounce(SIM_GetCycles() + 5 * SIM_CYCLES_PER_MS, SIM_KEY_S2, 0, 3,
+                   30 * CYCLES_PER_US);
+        SIM_RunMs(60);
+        CHECK(REPORT_IsDown(USAGE_B) == false);
+    }
+
+    qsort(latency, TRIALS, sizeof(latency[0]), CompareLatency);
+    printf("debounce_latency mode=%s min_us=%u typical_us=%u worst_us=%u\n",
+           name, latency[0], latency[TRIALS / 2], latency[TRIALS - 1]);
+    *best = latency[0];
+    *worst = latency[TRIALS - 1];
+}
+
+/* A press and a release of S2 with three bounces each, 100us apart, are
+ * fourteen raw edges and twelve bounces, whichever mode debounces them. */
+static void TestEdgeCounts(void)
+{
+    uint8_t page[8];
+
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_STATUS;
+    page[1] = APP_FEATURE_CLEAR_STATS;
+    CHECK(SIM_SetFeaturePage(page) == true);
+
+    SIM_Bounce(SIM_GetCycles(), SIM_KEY_S2, SIM_KEY_S2, 3, 100 * CYCLES_PER_US);
+    SIM_RunMs(50);
+    SIM_Bounce(SIM_GetCycles(), SIM_KEY_S2, 0, 3, 100 * CYCLES_PER_US);
+    SIM_RunMs(60);
+
+    page[0] = APP_FEATURE_PAGE_KEY_STATS + BUTTON_S2;
+    SIM_GetFeaturePage(page);
+    CHECK((page[1] | (page[2] << 8)) == 1);
+    CHECK((page[3] | (page[4] << 8)) == 14);
+    CHECK((page[5] | (page[6] << 8)) == 12);
+    CHECK(page[7] <= 1);
+}
+
+static void TestEager(void)
+{
+    uint32_t best;
+    uint32_t worst;
+    uint64_t open;
+    uint64_t released;
+
+    SetDebounceMode(BUTTON_DEBOUNCE_EAGER);
+
+    //the press is reported from the first closed sample: within a tick
+    //(250us at 4kHz), the next poll of the 1ms endpoint and a loop pass
+    MeasureLatency("eager", &best, &worst);
+    CHECK(worst <= 250 + 1000 + 100);
+
+    //a contact closed for less than a tick is still a press, from the
+    //edge the interrupt-on-change captured
+    REPORT_Clear();
+    SIM_ScheduleKeys(SIM_GetCycles() + 100, SIM_KEY_S2, SIM_KEY_S2);
+    SIM_ScheduleKeys(SIM_GetCycles() + 100 + 50 * CYCLES_PER_US, SIM_KEY_S2, 0);
+    SIM_RunMs(30);
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+    CHECK(REPORT_IsDown(USAGE_B) == false);
+
+    //release bounce inside the lockout is not a second press, and the
+    //release follows the last open edge by the lockout
+    REPORT_Clear();
+    SIM_SetKeys(SIM_KEY_S2);
+    SIM_RunMs(20);
+    SIM_Bounce(SIM_GetCycles(), SIM_KEY_S2, 0, 3, SIM_CYCLES_PER_MS);
+    open = SIM_GetCycles() + 6 * SIM_CYCLES_PER_MS;
+    released = RunUntil(false, 50);
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+    CHECK(released >= open + (BUTTON_RELEASE_LOCKOUT_DEFAULT - 1) * SIM_CYCLES_PER_MS);
+    CHECK(released <= open + (BUTTON_RELEASE_LOCKOUT_DEFAULT + 2) * SIM_CYCLES_PER_MS);
+    SIM_RunMs(20);
+
+    TestEdgeCounts();
+}
+
+static void TestStateMachine(void)
+{
+    uint32_t best;
+    uint32_t worst;
+    uint64_t open;
+    uint64_t released;
+
+    SetDebounceMode(BUTTON_DEBOUNCE_STATE_MACHINE);
+
+    //a press needs two samples one period apart: one to two periods
+    MeasureLatency("state_machine", &best, &worst);
+    CHECK(best >= (BUTTON_SAMPLE_PERIOD_DEFAULT - 1) * 1000);
+    CHECK(worst <= (2 * BUTTON_SAMPLE_PERIOD_DEFAULT + 2) * 1000);
+
+    //a contact closed for less than a period is at most one sample
+    REPORT_Clear();
+    SIM_ScheduleKeys(SIM_GetCycles(), SIM_KEY_S2, SIM_KEY_S2);
+    SIM_ScheduleKeys(SIM_GetCycles() + 3 * SIM_CYCLES_PER_MS, SIM_KEY_S2, 0);
+    SIM_RunMs(50);
+    CHECK(REPORT_GetPresses(USAGE_B) == 0);
+
+    //the release needs two open samples as well
+    REPORT_Clear();
+    SIM_SetKeys(SIM_KEY_S2);
+    SIM_RunMs(40);
+    CHECK(REPORT_IsDown(USAGE_B) == true);
+    open = SIM_GetCycles();
+    SIM_SetKeys(0);
+    released = RunUntil(false, 50);
+    CHECK(released >= open + (BUTTON_SAMPLE_PERIOD_DEFAULT - 1) * SIM_CYCLES_PER_MS);
+    CHECK(released <= open + (2 * BUTTON_SAMPLE_PERIOD_DEFAULT + 2) * SIM_CYCLES_PER_MS);
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+    SIM_RunMs(20);
+
+    TestEdgeCounts();
+}
+
+int main(void)
+{
+    uint8_t page[8];
+
+    SIM_PowerOn();
+    REPORT_Attach();
+    SIM_Configure();
+
+    //S2 is in chords; turn them off so it is never held back
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_CHORD;
+    CHECK(SIM_SetFeaturePage(page) == true);
+    SIM_RunMs(100);
+
+    TestEager();
+    TestStateMachine();
+
+    CHECK(SIM_GetErrors() == 0);
+    return CHECK_DONE("test_debounce");
+}
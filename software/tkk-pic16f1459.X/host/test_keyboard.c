@@ -0,0 +1,141 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Bouncing key waveforms in, keyboard reports and the LEDs out, on the
+ * three key board's default keymap. */
+
+#include <xc.h>
+#include <stdint.h>
+
+#include "app_chord.h"
+
+#include "sim.h"
+#include "report.h"
+#include "check.h"
+
+#define USAGE_A     0x04
+#define USAGE_B     0x05
+#define LED_D2_PIN  0x80    // RC7, Caps Lock
+
+/* A contact change with five bounces 50us apart. */
+static void Bounce(uint8_t mask, uint8_t closed)
+{
+    SIM_Bounce(SIM_GetCycles(), mask, closed, 5, SIM_CYCLES_PER_MS / 20);
+}
+
+static void TestBouncedPress(void)
+{
+    uint32_t reports;
+
+    REPORT_Clear();
+    //S2 is in chords, so it can be held back for the chord window
+    Bounce(SIM_KEY_S2, SIM_KEY_S2);
+    SIM_RunMs(APP_CHORD_WINDOW_DEFAULT + 20);
+    CHECK(REPORT_IsDown(USAGE_B) == true);
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+    reports = REPORT_GetCount();
+    CHECK(reports >= 1);
+
+    Bounce(SIM_KEY_S2, 0);
+    SIM_RunMs(20);
+    CHECK(REPORT_IsDown(USAGE_B) == false);
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+    CHECK(REPORT_GetCount() > reports);
+}
+
+static void TestTapAndHold(void)
+{
+    //a tap of the dual-role key types its tap usage only
+    REPORT_Clear();
+    Bounce(SIM_KEY_S1, SIM_KEY_S1);
+    SIM_RunMs(50);
+    Bounce(SIM_KEY_S1, 0);
+    SIM_RunMs(50);
+    CHECK(REPORT_GetPresses(USAGE_A) == 1);
+    CHECK(REPORT_GetPresses(REPORT_USAGE_LEFT_SHIFT) == 0);
+    CHECK(REPORT_IsDown(USAGE_A) == false);
+
+    //past the double tap window, holding it gives its hold usage
+    SIM_RunMs(300);
+    REPORT_Clear();
+    Bounce(SIM_KEY_S1, SIM_KEY_S1);
+    SIM_RunMs(400);
+    CHECK(REPORT_IsDown(REPORT_USAGE_LEFT_SHIFT) == true);
+    Bounce(SIM_KEY_S1, 0);
+    SIM_RunMs(50);
+    CHECK(REPORT_IsDown(REPORT_USAGE_LEFT_SHIFT) == false);
+    CHECK(REPORT_GetPresses(USAGE_A) == 0);
+    SIM_RunMs(300);
+}
+
+static void TestCapsLockLed(void)
+{
+    static const uint8_t capsOn[] = { 1, 0x02 };
+    static const uint8_t capsOff[] = { 1, 0x00 };
+
+    CHECK(SIM_HostOut(1, capsOn, sizeof(capsOn)) == true);
+    SIM_RunMs(5);
+    CHECK((LATC & LED_D2_PIN) != 0);
+
+    CHECK(SIM_HostOut(1, capsOff, sizeof(capsOff)) == true);
+    SIM_RunMs(5);
+    CHECK((LATC & LED_D2_PIN) == 0);
+}
+
+/* The OUT endpoint takes the 2 byte LED report, and says so in its
+ * wMaxPacketSize: a longer packet is over both that and the buffer the
+ * firmware arms.  Run last, as it leaves errors counted. */
+static void TestOversizeOut(void)
+{
+    static const uint8_t oversize[8] = { 1, 0x00 };
+    static const uint8_t capsOff[] = { 1, 0x00 };
+
+    CHECK(SIM_HostOut(1, oversize, sizeof(oversize)) == true);
+    SIM_RunMs(5);
+    CHECK(SIM_GetErrors() == 2);
+
+    CHECK(SIM_HostOut(1, capsOff, sizeof(capsOff)) == true);
+    SIM_RunMs(5);
+    CHECK(SIM_GetErrors() == 2);
+}
+
+int main(void)
+{
+    SIM_PowerOn();
+    REPORT_Attach();
+    SIM_RunMs(10);
+    SIM_Configure();
+    SIM_RunMs(100);
+
+    //the LED pins are outputs, the key pins inputs
+    CHECK((TRISC & 0xC0) == 0);
+    CHECK((TRISB & SIM_KEY_ALL) == SIM_KEY_ALL);
+    CHECK(REPORT_GetPresses(USAGE_A) == 0);
+
+    TestBouncedPress();
+    TestTapAndHold();
+    TestCapsLockLed();
+
+    CHECK(SIM_GetErrors() == 0);
+    TestOversizeOut();
+    return CHECK_DONE("test_keyboard");
+}
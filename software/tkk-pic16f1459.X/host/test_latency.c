@@ -0,0 +1,216 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Runs the press-to-host pipeline end to end: bounced presses of S2 at
+ * random phases against the scan tick and the frames, the endpoint
+ * polled at its bInterval, and the host timing each press from its
+ * first edge to the IN packet carrying it.  Checks that the latency the
+ * device reports on APP_FEATURE_PAGE_LATENCY matches, to the
+ * millisecond, for both debounce modes, and that the main loop rate on
+ * APP_FEATURE_PAGE_LOOP is the one the sim runs the loop at.  Prints one
+ * line per mode and source, the report rate and the loop rates. */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "buttons.h"
+#include "app_device_keyboard.h"
+
+#include "sim.h"
+#include "report.h"
+#include "check.h"
+
+#define USAGE_B         0x05
+#define TRIALS          200
+#define CYCLES_PER_US   (SIM_CYCLES_PER_SECOND / 1000000UL)
+
+/* Percentiles as the device reads them off its histogram, which reads
+ * 15 for anything of 15ms or more. */
+#define DEVICE_LATENCY_CAP  15
+
+static uint32_t seed = 1;
+static uint32_t latency[TRIALS];
+
+static uint32_t Random(uint32_t range)
+{
+    seed = (seed * 1103515245UL) + 12345UL;
+    return (seed >> 8) % range;
+}
+
+static int CompareLatency(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* The smallest latency at or below which percent of the sorted samples
+ * fall, the rank the device uses. */
+static uint32_t Percentile(const uint32_t *sorted, uint16_t count, uint8_t percent)
+{
+    uint16_t rank = (uint16_t)((((uint32_t)count * percent) + 99) / 100);
+
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+static uint8_t Capped(uint32_t ms)
+{
+    return (ms < DEVICE_LATENCY_CAP) ? (uint8_t)ms : DEVICE_LATENCY_CAP;
+}
+
+/* Device and host agree to within the millisecond tick each side of the
+ * press time and the take time rounds to. */
+static bool Agrees(uint8_t device, uint32_t hostMs)
+{
+    return (device + 1 >= hostMs) && (device <= hostMs + 1);
+}
+
+static void SetPage(uint8_t number, uint8_t index, uint8_t value)
+{
+    uint8_t page[8];
+
+    page[0] = number;
+    SIM_GetFeaturePage(page);
+    page[index] = value;
+    CHECK(SIM_SetFeaturePage(page) == true);
+}
+
+static void ClearStats(void)
+{
+    uint8_t page[8];
+
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_STATUS;
+    page[1] = APP_FEATURE_CLEAR_STATS;
+    CHECK(SIM_SetFeaturePage(page) == true);
+}
+
+static void RunMode(const char *name, BUTTON_DEBOUNCE_MODE mode)
+{
+    uint8_t page[8];
+    uint64_t start;
+    uint64_t end;
+    uint16_t i;
+    uint32_t min;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t max;
+
+    SetPage(APP_FEATURE_PAGE_SETTINGS, 1, (uint8_t)mode);
+    SIM_RunMs(50);
+    ClearStats();
+
+    for(i = 0; i < TRIALS; i++)
+    {
+        REPORT_Clear();
+        start = SIM_GetCycles() + Random(20 * SIM_CYCLES_PER_MS);
+        SIM_Bounce(start, SIM_KEY_S2, SIM_KEY_S2, 3, 30 * CYCLES_PER_US);
+        end = start + 50 * SIM_CYCLES_PER_MS;
+        while((REPORT_IsDown(USAGE_B) == false) && (SIM_GetCycles() < end))
+        {
+            SIM_Run(1);
+        }
+        CHECK(REPORT_GetPresses(USAGE_B) == 1);
+        latency[i] = (uint32_t)((REPORT_GetPressCycle(USAGE_B) - start) / CYCLES_PER_US);
+
+        SIM_Bounce(SIM_GetCycles() + 5 * SIM_CYCLES_PER_MS, SIM_KEY_S2, 0, 3,
+                   30 * CYCLES_PER_US);
+        SIM_RunMs(60);
+        CHECK(REPORT_IsDown(USAGE_B) == false);
+    }
+
+    qsort(latency, TRIALS, sizeof(latency[0]), CompareLatency);
+    min = latency[0];
+    p50 = Percentile(latency, TRIALS, 50);
+    p99 = Percentile(latency, TRIALS, 99);
+    max = latency[TRIALS - 1];
+    printf("press_latency mode=%s source=host unit=us min=%u p50=%u p99=%u max=%u count=%u\n",
+           name, min, p50, p99, max, TRIALS);
+
+    page[0] = APP_FEATURE_PAGE_LATENCY;
+    SIM_GetFeaturePage(page);
+    printf("press_latency mode=%s source=device unit=ms min=%u p50=%u p99=%u max=%u count=%u\n",
+           name, page[1], page[2], page[3], page[4], page[5] | (page[6] << 8));
+
+    CHECK((page[5] | (page[6] << 8)) == TRIALS);
+    CHECK(Agrees(page[1], min / 1000));
+    CHECK(Agrees(page[2], Capped(p50 / 1000)));
+    CHECK(Agrees(page[3], Capped(p99 / 1000)));
+    CHECK(Agrees(page[4], max / 1000));
+}
+
+/* The loop rate is counted over one-second windows, so one pass either
+ * side of the window is the only slack. */
+static void RunLoopRate(uint16_t loopCycles)
+{
+    uint8_t page[8];
+    uint32_t expected = SIM_CYCLES_PER_SECOND / loopCycles;
+    uint32_t rate;
+
+    SIM_SetLoopCycles(loopCycles);
+    SIM_RunMs(2100);
+
+    page[0] = APP_FEATURE_PAGE_LOOP;
+    SIM_GetFeaturePage(page);
+    rate = (uint32_t)page[1] | ((uint32_t)page[2] << 8) |
+           ((uint32_t)page[3] << 16) | ((uint32_t)page[4] << 24);
+    printf("loop_rate loop_cycles=%u source=device unit=per_s rate=%u expected=%u\n",
+           loopCycles, rate, expected);
+    CHECK((rate + 2 >= expected) && (rate <= expected + 2));
+
+    SIM_SetLoopCycles(SIM_LOOP_CYCLES);
+}
+
+int main(void)
+{
+    uint8_t page[8];
+
+    SIM_PowerOn();
+    REPORT_Attach();
+    SIM_Configure();
+
+    //S2 is in chords; turn them off so it is never held back
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_CHORD;
+    CHECK(SIM_SetFeaturePage(page) == true);
+    SIM_RunMs(100);
+
+    RunMode("eager", BUTTON_DEBOUNCE_EAGER);
+    RunMode("state_machine", BUTTON_DEBOUNCE_STATE_MACHINE);
+
+    //two reports a trial, press and release, in the last second
+    page[0] = APP_FEATURE_PAGE_STATUS;
+    SIM_GetFeaturePage(page);
+    printf("report_rate source=device unit=per_s reports=%u\n",
+           page[5] | (page[6] << 8));
+    CHECK((page[5] | (page[6] << 8)) >= 2 * (1000 / 85));
+    CHECK((page[5] | (page[6] << 8)) <= 2 * (1000 / 65) + 2);
+
+    RunLoopRate(SIM_LOOP_CYCLES / 2);
+    RunLoopRate(SIM_LOOP_CYCLES);
+    RunLoopRate(SIM_LOOP_CYCLES * 4);
+
+    CHECK(SIM_GetErrors() == 0);
+    return CHECK_DONE("test_latency");
+}
@@ -0,0 +1,102 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Macro 0 started through APP_FEATURE_PAGE_MACRO: the host must read
+ * back exactly its text, and the typing rate the device reports on the
+ * page must match the one the host times from the SET_REPORT to the
+ * last report.  Prints one rate line per source. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "app_device_keyboard.h"
+#include "app_macro.h"
+
+#include "sim.h"
+#include "report.h"
+#include "check.h"
+
+#define MACRO_TEXT  "Hello from the tiny keyboard!\n"
+
+static void GetMacroPage(uint8_t *page)
+{
+    page[0] = APP_FEATURE_PAGE_MACRO;
+    SIM_GetFeaturePage(page);
+}
+
+int main(void)
+{
+    uint8_t page[8];
+    uint64_t start;
+    uint64_t end;
+    uint32_t reports;
+    uint32_t hostRate;
+    uint16_t deviceRate;
+    uint16_t typed;
+
+    SIM_PowerOn();
+    REPORT_Attach();
+    SIM_Configure();
+    SIM_RunMs(100);
+
+    REPORT_Clear();
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_MACRO;
+    page[1] = 0;
+    start = SIM_GetCycles();
+    CHECK(SIM_SetFeaturePage(page) == true);
+
+    //the macro plays until the page reads no macro playing, and its last
+    //report is the release of the last character
+    end = start + SIM_CYCLES_PER_SECOND;
+    do
+    {
+        reports = REPORT_GetCount();
+        SIM_Run(1);
+        if(REPORT_GetCount() != reports)
+        {
+            end = SIM_GetCycles();
+        }
+        GetMacroPage(page);
+    } while((page[1] != APP_MACRO_NONE) && (SIM_GetCycles() < start + SIM_CYCLES_PER_SECOND));
+    SIM_RunMs(50);
+
+    CHECK(strcmp(REPORT_GetText(), MACRO_TEXT) == 0);
+
+    GetMacroPage(page);
+    typed = (uint16_t)(page[2] | (page[3] << 8));
+    deviceRate = (uint16_t)(page[4] | (page[5] << 8));
+    hostRate = (uint32_t)(((uint64_t)strlen(MACRO_TEXT) * SIM_CYCLES_PER_SECOND) /
+                          (end - start));
+    printf("macro_rate source=host unit=chars_per_s rate=%u chars=%u\n",
+           hostRate, (unsigned int)strlen(MACRO_TEXT));
+    printf("macro_rate source=device unit=chars_per_s rate=%u chars=%u\n",
+           deviceRate, typed);
+
+    //a character is a press and a release, one report a frame each
+    CHECK(typed == strlen(MACRO_TEXT));
+    CHECK(hostRate >= 450);
+    CHECK((deviceRate * 20 >= hostRate * 19) && (deviceRate * 19 <= hostRate * 20));
+
+    CHECK(SIM_GetErrors() == 0);
+    return CHECK_DONE("test_macro");
+}
@@ -0,0 +1,216 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* The millisecond tick's phase against the USB frames, at the default
+ * 4kHz scan tick and at 1kHz, and a remote wakeup from S1 while the bus
+ * is suspended, signalled from the main loop with the USB interrupt
+ * left enabled. */
+
+#include <xc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "usb.h"
+#include "tick.h"
+#include "app_device_keyboard.h"
+
+#include "sim.h"
+#include "report.h"
+#include "check.h"
+
+#define USAGE_A     0x04
+
+/* Cycles from the last SOF to each millisecond tick, as the main loop
+ * sees it, since the last Watch(). */
+static uint16_t lastMs;
+static uint32_t phaseMin;
+static uint32_t phaseMax;
+
+/* Cycles the RESUME bit was set and cleared at, and main loop passes
+ * that ended with the USB interrupt masked. */
+static uint64_t resumeOn;
+static uint64_t resumeOff;
+static uint32_t maskedPasses;
+
+static void Hook(void)
+{
+    uint16_t ms = TICK_Get();
+    uint32_t phase;
+
+    if(ms != lastMs)
+    {
+        lastMs = ms;
+        phase = (uint32_t)((SIM_GetCycles() - SIM_GetSofCycle()) % SIM_CYCLES_PER_MS);
+        if(phase < phaseMin)
+        {
+            phaseMin = phase;
+        }
+        if(phase > phaseMax)
+        {
+            phaseMax = phase;
+        }
+    }
+
+    if((UCONbits.RESUME == 1) && (resumeOn == 0))
+    {
+        resumeOn = SIM_GetCycles();
+    }
+    if((UCONbits.RESUME == 0) && (resumeOn != 0) && (resumeOff == 0))
+    {
+        resumeOff = SIM_GetCycles();
+    }
+    if(PIE2bits.USBIE == 0)
+    {
+        maskedPasses++;
+    }
+}
+
+static void Watch(void)
+{
+    lastMs = TICK_Get();
+    phaseMin = UINT32_MAX;
+    phaseMax = 0;
+}
+
+/* Runs until just after an SOF. */
+static void RunToSof(void)
+{
+    uint64_t sof = SIM_GetSofCycle();
+
+    while(SIM_GetSofCycle() == sof)
+    {
+        SIM_Run(1);
+    }
+}
+
+static void SetScanRate(uint8_t rateKHz)
+{
+    uint8_t page[8];
+
+    page[0] = APP_FEATURE_PAGE_SETTINGS;
+    SIM_GetFeaturePage(page);
+    page[2] = rateKHz;
+    page[5] = 0;
+    CHECK(SIM_SetFeaturePage(page) == true);
+}
+
+static void TestPhase4kHz(void)
+{
+    //the millisecond tick falls within one 250us tick after the SOF, seen
+    //up to a loop pass later
+    SIM_RunMs(20);
+    Watch();
+    SIM_RunMs(50);
+    CHECK(phaseMax < (SIM_CYCLES_PER_MS / 4) + SIM_LOOP_CYCLES);
+}
+
+static void TestPhase1kHz(void)
+{
+    SetScanRate(1);
+    SIM_RunMs(20);
+
+    //restart the tick just after an SOF, as if it had started there: a
+    //full millisecond later is just after the next SOF, out of phase
+    RunToSof();
+    TICK_SetRate(1000);
+
+    //from the next SOF on, the millisecond tick falls 5/6ms after it
+    SIM_RunMs(2);
+    Watch();
+    SIM_RunMs(50);
+    CHECK(phaseMin >= (SIM_CYCLES_PER_MS * 5) / 6 - SIM_LOOP_CYCLES);
+    CHECK(phaseMax <= (SIM_CYCLES_PER_MS * 5) / 6 + SIM_LOOP_CYCLES);
+}
+
+static void TestRateKept(void)
+{
+    uint8_t page[8];
+    uint16_t start;
+
+    //a settings change that leaves the rate alone doesn't restart the
+    //tick, which would drop the millisecond it was counting
+    RunToSof();
+    start = TICK_Get();
+    SIM_Run(SIM_CYCLES_PER_MS / 3);
+    page[0] = APP_FEATURE_PAGE_TYPEMATIC;
+    SIM_GetFeaturePage(page);
+    page[6] = 0;
+    CHECK(SIM_SetFeaturePage(page) == true);
+    SetScanRate(1);
+    SIM_Run((SIM_CYCLES_PER_MS * 50) - (SIM_CYCLES_PER_MS / 3));
+    CHECK((uint16_t)(TICK_Get() - start) == 50);
+}
+
+static void TestRemoteWakeup(void)
+{
+    uint64_t pressed;
+
+    CHECK(SIM_ControlRequest(0x00, USB_REQUEST_SET_FEATURE,
+                             USB_FEATURE_DEVICE_REMOTE_WAKEUP, 0, NULL, 0) == 0);
+
+    SIM_Suspend(true);
+    SIM_RunMs(20);
+    CHECK(SIM_GetRemoteWakeups() == 0);
+
+    //S1 wakes the host: resume is driven for 1-15ms after the bus has
+    //been idle for 5ms, and the USB interrupt is never masked for it
+    REPORT_Clear();
+    resumeOn = 0;
+    resumeOff = 0;
+    maskedPasses = 0;
+    pressed = SIM_GetCycles();
+    SIM_SetKeys(SIM_KEY_S1);
+    SIM_RunMs(30);
+    CHECK(SIM_GetRemoteWakeups() == 1);
+    CHECK(SIM_IsSuspended() == false);
+    CHECK(resumeOn >= pressed + 4 * SIM_CYCLES_PER_MS);
+    CHECK(resumeOff >= resumeOn + 1 * SIM_CYCLES_PER_MS);
+    CHECK(resumeOff <= resumeOn + 15 * SIM_CYCLES_PER_MS);
+    CHECK(maskedPasses == 0);
+
+    //the key that woke the host still types
+    SIM_SetKeys(0);
+    SIM_RunMs(50);
+    CHECK(REPORT_GetPresses(USAGE_A) == 1);
+
+    //and the 1kHz tick is back in phase with the frames
+    Watch();
+    SIM_RunMs(50);
+    CHECK(phaseMin >= (SIM_CYCLES_PER_MS * 5) / 6 - SIM_LOOP_CYCLES);
+    CHECK(phaseMax <= (SIM_CYCLES_PER_MS * 5) / 6 + SIM_LOOP_CYCLES);
+}
+
+int main(void)
+{
+    SIM_PowerOn();
+    REPORT_Attach();
+    SIM_Configure();
+    SIM_SetLoopHook(Hook);
+
+    TestPhase4kHz();
+    TestPhase1kHz();
+    TestRateKept();
+    TestRemoteWakeup();
+
+    CHECK(SIM_GetErrors() == 0);
+    return CHECK_DONE("test_resume");
+}
@@ -0,0 +1,139 @@
+/********************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PIC(R) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PIC Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ *******************************************************************/
+
+/* Typematic repeat of S2 (KEYMAP_REPEAT 'b') with the host idle rate at
+ * 0: the repeats come as a release and a press in consecutive reports,
+ * and turning typematic off between the two still sends the press, so
+ * the held key is not left released. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "usb.h"
+#include "usb_device_hid.h"
+#include "app_device_keyboard.h"
+#include "app_settings.h"
+#include "app_typematic.h"
+
+#include "sim.h"
+#include "report.h"
+#include "check.h"
+
+#define USAGE_B     0x05
+
+static bool watching;
+static bool turnedOff;
+static uint8_t armed;
+
+static void SetTypematic(uint8_t on)
+{
+    uint8_t page[8];
+
+    page[0] = APP_FEATURE_PAGE_TYPEMATIC;
+    SIM_GetFeaturePage(page);
+    page[1] = on;
+    page[6] = 0;
+    CHECK(SIM_SetFeaturePage(page) == true);
+}
+
+/* Once watching, the first report the firmware arms is the release of the
+ * first repeat: turn typematic off before the next pass arms the press. */
+static void TurnOffAfterRelease(void)
+{
+    uint8_t now = SIM_GetArmed(HID_EP, IN_TO_HOST);
+
+    if((watching == true) && (turnedOff == false) && (now > armed))
+    {
+        SetTypematic(0);
+        turnedOff = true;
+    }
+    armed = now;
+}
+
+/* Holding S2 past the delay repeats it. */
+static void TestRepeat(void)
+{
+    REPORT_Clear();
+    SIM_SetKeys(SIM_KEY_S2);
+    SIM_RunMs(APP_TYPEMATIC_DELAY_DEFAULT * APP_TYPEMATIC_DELAY_UNIT_MS + 250);
+    CHECK(REPORT_GetPresses(USAGE_B) >= 3);
+    CHECK(REPORT_IsDown(USAGE_B) == true);
+    SIM_SetKeys(0);
+    SIM_RunMs(50);
+    CHECK(REPORT_IsDown(USAGE_B) == false);
+}
+
+/* Typematic turned off between a repeat's release and its press. */
+static void TestOffMidRepeat(void)
+{
+    uint32_t presses;
+
+    REPORT_Clear();
+    SIM_SetKeys(SIM_KEY_S2);
+    SIM_RunMs(APP_TYPEMATIC_DELAY_DEFAULT * APP_TYPEMATIC_DELAY_UNIT_MS / 2);
+    CHECK(REPORT_GetPresses(USAGE_B) == 1);
+
+    SIM_SetLoopHook(TurnOffAfterRelease);
+    watching = true;
+    SIM_RunMs(APP_TYPEMATIC_DELAY_DEFAULT * APP_TYPEMATIC_DELAY_UNIT_MS);
+    SIM_SetLoopHook(NULL);
+    watching = false;
+    CHECK(turnedOff == true);
+
+    //the press followed the release, and no repeat after it
+    CHECK(REPORT_GetPresses(USAGE_B) == 2);
+    CHECK(REPORT_IsDown(USAGE_B) == true);
+    presses = REPORT_GetPresses(USAGE_B);
+    SIM_RunMs(500);
+    CHECK(REPORT_GetPresses(USAGE_B) == presses);
+    CHECK(REPORT_IsDown(USAGE_B) == true);
+
+    SIM_SetKeys(0);
+    SIM_RunMs(50);
+    CHECK(REPORT_IsDown(USAGE_B) == false);
+    SetTypematic(APP_SETTINGS_TYPEMATIC_ON);
+}
+
+int main(void)
+{
+    uint8_t page[8];
+
+    SIM_PowerOn();
+    REPORT_Attach();
+    SIM_Configure();
+
+    //the firmware repeats keys only while the host does not
+    CHECK(SIM_ControlRequest(0x21, SET_IDLE, 0x0000, HID_INTF_ID, NULL, 0) == 0);
+
+    //S2 is in chords; turn them off so it is never held back
+    memset(page, 0, sizeof(page));
+    page[0] = APP_FEATURE_PAGE_CHORD;
+    CHECK(SIM_SetFeaturePage(page) == true);
+    SIM_RunMs(100);
+
+    TestRepeat();
+    TestOffMidRepeat();
+    TestRepeat();
+
+    CHECK(SIM_GetErrors() == 0);
+    return CHECK_DONE("test_typematic");
+}
@@ -0,0 +1,156 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+/* Stand-in for the XC8 device header in the host build.  The special
+ * function registers the firmware touches are plain variables, defined
+ * in sim.c, with the bit layout of the PIC16F1459 data sheet; sim.c
+ * plays the peripherals behind them.  Registers not listed here are not
+ * used by the modules the host build compiles. */
+
+#ifndef HOST_XC_H
+#define HOST_XC_H
+
+#include <stdint.h>
+
+/* Compiler keywords and builtins. */
+#define interrupt
+#define NOP()
+#define CLRWDT()
+#define ei()    (INTCONbits.GIE = 1)
+#define di()    (INTCONbits.GIE = 0)
+
+#define HOST_SFR(name, fields)                                      \
+    typedef union { uint8_t Val; struct fields; } name##bits_t;     \
+    extern volatile name##bits_t name##bits;
+#define HOST_SFR_BYTE(name) (name##bits.Val)
+
+/*** Core and interrupts ********************************************/
+HOST_SFR(INTCON, { unsigned IOCIF:1; unsigned INTF:1; unsigned TMR0IF:1;
+    unsigned IOCIE:1; unsigned INTE:1; unsigned TMR0IE:1; unsigned PEIE:1;
+    unsigned GIE:1; })
+HOST_SFR(PIE1, { unsigned TMR1IE:1; unsigned TMR2IE:1; unsigned :6; })
+HOST_SFR(PIR1, { unsigned TMR1IF:1; unsigned TMR2IF:1; unsigned :6; })
+HOST_SFR(PIE2, { unsigned :2; unsigned USBIE:1; unsigned :5; })
+HOST_SFR(PIR2, { unsigned :2; unsigned USBIF:1; unsigned :5; })
+HOST_SFR(OPTION_REG, { unsigned PS:3; unsigned PSA:1; unsigned TMR0SE:1;
+    unsigned TMR0CS:1; unsigned INTEDG:1; unsigned nWPUEN:1; })
+HOST_SFR(OSCCON, { unsigned SCS:2; unsigned :1; unsigned IRCF:4;
+    unsigned SPLLMULT:1; })
+HOST_SFR(ACTCON, { unsigned :1; unsigned ACTUD:1; unsigned :1;
+    unsigned ACTORS:1; unsigned ACTLOCK:1; unsigned ACTSRC:1;
+    unsigned :1; unsigned ACTEN:1; })
+#define INTCON      HOST_SFR_BYTE(INTCON)
+#define OPTION_REG  HOST_SFR_BYTE(OPTION_REG)
+#define OSCCON      HOST_SFR_BYTE(OSCCON)
+#define ACTCON      HOST_SFR_BYTE(ACTCON)
+
+/*** I/O ports ******************************************************/
+HOST_SFR(PORTB, { unsigned :4; unsigned RB4:1; unsigned RB5:1;
+    unsigned RB6:1; unsigned RB7:1; })
+HOST_SFR(TRISB, { unsigned :4; unsigned TRISB4:1; unsigned TRISB5:1;
+    unsigned TRISB6:1; unsigned TRISB7:1; })
+HOST_SFR(LATB, { unsigned :4; unsigned LATB4:1; unsigned LATB5:1;
+    unsigned LATB6:1; unsigned LATB7:1; })
+HOST_SFR(ANSELB, { unsigned :4; unsigned ANSB4:1; unsigned ANSB5:1;
+    unsigned :2; })
+HOST_SFR(WPUB, { unsigned :4; unsigned WPUB4:1; unsigned WPUB5:1;
+    unsigned WPUB6:1; unsigned WPUB7:1; })
+HOST_SFR(IOCBP, { unsigned :4; unsigned IOCBP4:1; unsigned IOCBP5:1;
+    unsigned IOCBP6:1; unsigned IOCBP7:1; })
+HOST_SFR(IOCBN, { unsigned :4; unsigned IOCBN4:1; unsigned IOCBN5:1;
+    unsigned IOCBN6:1; unsigned IOCBN7:1; })
+HOST_SFR(IOCBF, { unsigned :4; unsigned IOCBF4:1; unsigned IOCBF5:1;
+    unsigned IOCBF6:1; unsigned IOCBF7:1; })
+HOST_SFR(PORTC, { unsigned RC0:1; unsigned RC1:1; unsigned RC2:1;
+    unsigned RC3:1; unsigned RC4:1; unsigned RC5:1; unsigned RC6:1;
+    unsigned RC7:1; })
+HOST_SFR(TRISC, { unsigned TRISC0:1; unsigned TRISC1:1; unsigned TRISC2:1;
+    unsigned TRISC3:1; unsigned TRISC4:1; unsigned TRISC5:1;
+    unsigned TRISC6:1; unsigned TRISC7:1; })
+HOST_SFR(LATC, { unsigned LATC0:1; unsigned LATC1:1; unsigned LATC2:1;
+    unsigned LATC3:1; unsigned LATC4:1; unsigned LATC5:1; unsigned LATC6:1;
+    unsigned LATC7:1; })
+HOST_SFR(ANSELC, { unsigned ANSC0:1; unsigned ANSC1:1; unsigned ANSC2:1;
+    unsigned ANSC3:1; unsigned :2; unsigned ANSC6:1; unsigned ANSC7:1; })
+#define PORTB       HOST_SFR_BYTE(PORTB)
+#define TRISB       HOST_SFR_BYTE(TRISB)
+#define LATB        HOST_SFR_BYTE(LATB)
+#define ANSELB      HOST_SFR_BYTE(ANSELB)
+#define WPUB        HOST_SFR_BYTE(WPUB)
+#define IOCBP       HOST_SFR_BYTE(IOCBP)
+#define IOCBN       HOST_SFR_BYTE(IOCBN)
+#define IOCBF       HOST_SFR_BYTE(IOCBF)
+#define PORTC       HOST_SFR_BYTE(PORTC)
+#define TRISC       HOST_SFR_BYTE(TRISC)
+#define LATC        HOST_SFR_BYTE(LATC)
+#define ANSELC      HOST_SFR_BYTE(ANSELC)
+
+/*** Timers *********************************************************/
+HOST_SFR(T1CON, { unsigned TMR1ON:1; unsigned :1; unsigned nT1SYNC:1;
+    unsigned T1OSCEN:1; unsigned T1CKPS:2; unsigned TMR1CS:2; })
+HOST_SFR(T2CON, { unsigned T2CKPS:2; unsigned TMR2ON:1; unsigned T2OUTPS:4;
+    unsigned :1; })
+extern volatile uint16_t TMR1;
+extern volatile uint8_t TMR2;
+extern volatile uint8_t PR2;
+#define TMR1L       (((volatile uint8_t *)&TMR1)[0])
+#define TMR1H       (((volatile uint8_t *)&TMR1)[1])
+#define T1CON       HOST_SFR_BYTE(T1CON)
+#define T2CON       HOST_SFR_BYTE(T2CON)
+
+/*** Program memory *************************************************/
+HOST_SFR(PMCON1, { unsigned RD:1; unsigned WR:1; unsigned WREN:1;
+    unsigned WRERR:1; unsigned FREE:1; unsigned LWLO:1; unsigned CFGS:1;
+    unsigned :1; })
+extern volatile uint8_t PMCON2;
+extern volatile uint8_t PMADRL;
+extern volatile uint8_t PMADRH;
+extern volatile uint8_t PMDATL;
+extern volatile uint8_t PMDATH;
+#define PMCON1      HOST_SFR_BYTE(PMCON1)
+
+/*** USB module *****************************************************/
+HOST_SFR(UCON, { unsigned :1; unsigned SUSPND:1; unsigned RESUME:1;
+    unsigned USBEN:1; unsigned PKTDIS:1; unsigned SE0:1; unsigned PPBRST:1;
+    unsigned :1; })
+HOST_SFR(UIR, { unsigned URSTIF:1; unsigned UERRIF:1; unsigned ACTVIF:1;
+    unsigned TRNIF:1; unsigned IDLEIF:1; unsigned STALLIF:1;
+    unsigned SOFIF:1; unsigned :1; })
+HOST_SFR(UIE, { unsigned URSTIE:1; unsigned UERRIE:1; unsigned ACTVIE:1;
+    unsigned TRNIE:1; unsigned IDLEIE:1; unsigned STALLIE:1;
+    unsigned SOFIE:1; unsigned :1; })
+extern volatile uint8_t UEIR;
+extern volatile uint8_t UEIE;
+extern volatile uint8_t USTAT;
+extern volatile uint8_t UADDR;
+extern volatile uint8_t UCFG;
+extern volatile uint8_t UEP[8];
+#define UEP0        UEP[0]
+#define UEP1        UEP[1]
+#define UEP2        UEP[2]
+#define UEP3        UEP[3]
+#define UEP4        UEP[4]
+#define UEP5        UEP[5]
+#define UEP6        UEP[6]
+#define UEP7        UEP[7]
+#define UCON        HOST_SFR_BYTE(UCON)
+#define UIR         HOST_SFR_BYTE(UIR)
+#define UIE         HOST_SFR_BYTE(UIE)
+
+#endif //HOST_XC_H
@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=bsp/buttons.c bsp/leds.c demo_src/usb_descriptors.c demo_src/usb_events.c usb/usb_device.c usb/usb_device_hid.c demo_src/app_device_keyboard.c demo_src/app_led_usb_status.c demo_src/main.c system.c
+SOURCEFILES_QUOTED_IF_SPACED=bsp/buttons.c bsp/leds.c demo_src/usb_descriptors.c demo_src/usb_events.c usb/usb_device.c usb/usb_device_hid.c demo_src/app_device_keyboard.c demo_src/app_led_usb_status.c demo_src/main.c system.c bsp/tick.c bsp/matrix.c bsp/hef.c demo_src/app_settings.c demo_src/app_keymap.c demo_src/app_macro.c demo_src/app_tap_hold.c demo_src/app_typematic.c demo_src/app_chord.c usb/usb_device_cdc.c demo_src/app_device_cdc_control.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/bsp/buttons.p1 ${OBJECTDIR}/bsp/leds.p1 ${OBJECTDIR}/demo_src/usb_descriptors.p1 ${OBJECTDIR}/demo_src/usb_events.p1 ${OBJECTDIR}/usb/usb_device.p1 ${OBJECTDIR}/usb/usb_device_hid.p1 ${OBJECTDIR}/demo_src/app_device_keyboard.p1 ${OBJECTDIR}/demo_src/app_led_usb_status.p1 ${OBJECTDIR}/demo_src/main.p1 ${OBJECTDIR}/system.p1
-POSSIBLE_DEPFILES=${OBJECTDIR}/bsp/buttons.p1.d ${OBJECTDIR}/bsp/leds.p1.d ${OBJECTDIR}/demo_src/usb_descriptors.p1.d ${OBJECTDIR}/demo_src/usb_events.p1.d ${OBJECTDIR}/usb/usb_device.p1.d ${OBJECTDIR}/usb/usb_device_hid.p1.d ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d ${OBJECTDIR}/demo_src/main.p1.d ${OBJECTDIR}/system.p1.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/bsp/buttons.p1 ${OBJECTDIR}/bsp/leds.p1 ${OBJECTDIR}/demo_src/usb_descriptors.p1 ${OBJECTDIR}/demo_src/usb_events.p1 ${OBJECTDIR}/usb/usb_device.p1 ${OBJECTDIR}/usb/usb_device_hid.p1 ${OBJECTDIR}/demo_src/app_device_keyboard.p1 ${OBJECTDIR}/demo_src/app_led_usb_status.p1 ${OBJECTDIR}/demo_src/main.p1 ${OBJECTDIR}/system.p1 ${OBJECTDIR}/bsp/tick.p1 ${OBJECTDIR}/bsp/matrix.p1 ${OBJECTDIR}/bsp/hef.p1 ${OBJECTDIR}/demo_src/app_settings.p1 ${OBJECTDIR}/demo_src/app_keymap.p1 ${OBJECTDIR}/demo_src/app_macro.p1 ${OBJECTDIR}/demo_src/app_tap_hold.p1 ${OBJECTDIR}/demo_src/app_typematic.p1 ${OBJECTDIR}/demo_src/app_chord.p1 ${OBJECTDIR}/usb/usb_device_cdc.p1 ${OBJECTDIR}/demo_src/app_device_cdc_control.p1
+POSSIBLE_DEPFILES=${OBJECTDIR}/bsp/buttons.p1.d ${OBJECTDIR}/bsp/leds.p1.d ${OBJECTDIR}/demo_src/usb_descriptors.p1.d ${OBJECTDIR}/demo_src/usb_events.p1.d ${OBJECTDIR}/usb/usb_device.p1.d ${OBJECTDIR}/usb/usb_device_hid.p1.d ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d ${OBJECTDIR}/demo_src/main.p1.d ${OBJECTDIR}/system.p1.d ${OBJECTDIR}/bsp/tick.p1.d ${OBJECTDIR}/bsp/matrix.p1.d ${OBJECTDIR}/bsp/hef.p1.d ${OBJECTDIR}/demo_src/app_settings.p1.d ${OBJECTDIR}/demo_src/app_keymap.p1.d ${OBJECTDIR}/demo_src/app_macro.p1.d ${OBJECTDIR}/demo_src/app_tap_hold.p1.d ${OBJECTDIR}/demo_src/app_typematic.p1.d ${OBJECTDIR}/demo_src/app_chord.p1.d ${OBJECTDIR}/usb/usb_device_cdc.p1.d ${OBJECTDIR}/demo_src/app_device_cdc_control.p1.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/bsp/buttons.p1 ${OBJECTDIR}/bsp/leds.p1 ${OBJECTDIR}/demo_src/usb_descriptors.p1 ${OBJECTDIR}/demo_src/usb_events.p1 ${OBJECTDIR}/usb/usb_device.p1 ${OBJECTDIR}/usb/usb_device_hid.p1 ${OBJECTDIR}/demo_src/app_device_keyboard.p1 ${OBJECTDIR}/demo_src/app_led_usb_status.p1 ${OBJECTDIR}/demo_src/main.p1 ${OBJECTDIR}/system.p1
+OBJECTFILES=${OBJECTDIR}/bsp/buttons.p1 ${OBJECTDIR}/bsp/leds.p1 ${OBJECTDIR}/demo_src/usb_descriptors.p1 ${OBJECTDIR}/demo_src/usb_events.p1 ${OBJECTDIR}/usb/usb_device.p1 ${OBJECTDIR}/usb/usb_device_hid.p1 ${OBJECTDIR}/demo_src/app_device_keyboard.p1 ${OBJECTDIR}/demo_src/app_led_usb_status.p1 ${OBJECTDIR}/demo_src/main.p1 ${OBJECTDIR}/system.p1 ${OBJECTDIR}/bsp/tick.p1 ${OBJECTDIR}/bsp/matrix.p1 ${OBJECTDIR}/bsp/hef.p1 ${OBJECTDIR}/demo_src/app_settings.p1 ${OBJECTDIR}/demo_src/app_keymap.p1 ${OBJECTDIR}/demo_src/app_macro.p1 ${OBJECTDIR}/demo_src/app_tap_hold.p1 ${OBJECTDIR}/demo_src/app_typematic.p1 ${OBJECTDIR}/demo_src/app_chord.p1 ${OBJECTDIR}/usb/usb_device_cdc.p1 ${OBJECTDIR}/demo_src/app_device_cdc_control.p1
 
 # Source Files
-SOURCEFILES=bsp/buttons.c bsp/leds.c demo_src/usb_descriptors.c demo_src/usb_events.c usb/usb_device.c usb/usb_device_hid.c demo_src/app_device_keyboard.c demo_src/app_led_usb_status.c demo_src/main.c system.c
+SOURCEFILES=bsp/buttons.c bsp/leds.c demo_src/usb_descriptors.c demo_src/usb_events.c usb/usb_device.c usb/usb_device_hid.c demo_src/app_device_keyboard.c demo_src/app_led_usb_status.c demo_src/main.c system.c bsp/tick.c bsp/matrix.c bsp/hef.c demo_src/app_settings.c demo_src/app_keymap.c demo_src/app_macro.c demo_src/app_tap_hold.c demo_src/app_typematic.c demo_src/app_chord.c usb/usb_device_cdc.c demo_src/app_device_cdc_control.c
 
 
 CFLAGS=
@@ -97,7 +97,7 @@ ${OBJECTDIR}/bsp/buttons.p1: bsp/buttons.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/bsp" 
 	@${RM} ${OBJECTDIR}/bsp/buttons.p1.d 
 	@${RM} ${OBJECTDIR}/bsp/buttons.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/buttons.p1  bsp/buttons.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/buttons.p1  bsp/buttons.c 
 	@-${MV} ${OBJECTDIR}/bsp/buttons.d ${OBJECTDIR}/bsp/buttons.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/bsp/buttons.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -105,7 +105,7 @@ ${OBJECTDIR}/bsp/leds.p1: bsp/leds.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/bsp" 
 	@${RM} ${OBJECTDIR}/bsp/leds.p1.d 
 	@${RM} ${OBJECTDIR}/bsp/leds.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/leds.p1  bsp/leds.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/leds.p1  bsp/leds.c 
 	@-${MV} ${OBJECTDIR}/bsp/leds.d ${OBJECTDIR}/bsp/leds.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/bsp/leds.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -113,7 +113,7 @@ ${OBJECTDIR}/demo_src/usb_descriptors.p1: demo_src/usb_descriptors.c  nbproject/
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/usb_descriptors.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/usb_descriptors.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_descriptors.p1  demo_src/usb_descriptors.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_descriptors.p1  demo_src/usb_descriptors.c 
 	@-${MV} ${OBJECTDIR}/demo_src/usb_descriptors.d ${OBJECTDIR}/demo_src/usb_descriptors.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/usb_descriptors.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -121,7 +121,7 @@ ${OBJECTDIR}/demo_src/usb_events.p1: demo_src/usb_events.c  nbproject/Makefile-$
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/usb_events.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/usb_events.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_events.p1  demo_src/usb_events.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_events.p1  demo_src/usb_events.c 
 	@-${MV} ${OBJECTDIR}/demo_src/usb_events.d ${OBJECTDIR}/demo_src/usb_events.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/usb_events.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -129,7 +129,7 @@ ${OBJECTDIR}/usb/usb_device.p1: usb/usb_device.c  nbproject/Makefile-${CND_CONF}
 	@${MKDIR} "${OBJECTDIR}/usb" 
 	@${RM} ${OBJECTDIR}/usb/usb_device.p1.d 
 	@${RM} ${OBJECTDIR}/usb/usb_device.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device.p1  usb/usb_device.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device.p1  usb/usb_device.c 
 	@-${MV} ${OBJECTDIR}/usb/usb_device.d ${OBJECTDIR}/usb/usb_device.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/usb/usb_device.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -137,7 +137,7 @@ ${OBJECTDIR}/usb/usb_device_hid.p1: usb/usb_device_hid.c  nbproject/Makefile-${C
 	@${MKDIR} "${OBJECTDIR}/usb" 
 	@${RM} ${OBJECTDIR}/usb/usb_device_hid.p1.d 
 	@${RM} ${OBJECTDIR}/usb/usb_device_hid.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device_hid.p1  usb/usb_device_hid.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device_hid.p1  usb/usb_device_hid.c 
 	@-${MV} ${OBJECTDIR}/usb/usb_device_hid.d ${OBJECTDIR}/usb/usb_device_hid.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/usb/usb_device_hid.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -145,7 +145,7 @@ ${OBJECTDIR}/demo_src/app_device_keyboard.p1: demo_src/app_device_keyboard.c  nb
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/app_device_keyboard.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_device_keyboard.p1  demo_src/app_device_keyboard.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_device_keyboard.p1  demo_src/app_device_keyboard.c 
 	@-${MV} ${OBJECTDIR}/demo_src/app_device_keyboard.d ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -153,7 +153,7 @@ ${OBJECTDIR}/demo_src/app_led_usb_status.p1: demo_src/app_led_usb_status.c  nbpr
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/app_led_usb_status.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_led_usb_status.p1  demo_src/app_led_usb_status.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_led_usb_status.p1  demo_src/app_led_usb_status.c 
 	@-${MV} ${OBJECTDIR}/demo_src/app_led_usb_status.d ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -161,7 +161,7 @@ ${OBJECTDIR}/demo_src/main.p1: demo_src/main.c  nbproject/Makefile-${CND_CONF}.m
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/main.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/main.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/main.p1  demo_src/main.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/main.p1  demo_src/main.c 
 	@-${MV} ${OBJECTDIR}/demo_src/main.d ${OBJECTDIR}/demo_src/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -169,16 +169,104 @@ ${OBJECTDIR}/system.p1: system.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
 	@${RM} ${OBJECTDIR}/system.p1.d 
 	@${RM} ${OBJECTDIR}/system.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/system.p1  system.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/system.p1  system.c 
 	@-${MV} ${OBJECTDIR}/system.d ${OBJECTDIR}/system.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/system.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/demo_src/app_device_cdc_control.p1: demo_src/app_device_cdc_control.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_device_cdc_control.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_device_cdc_control.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_device_cdc_control.p1  demo_src/app_device_cdc_control.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_device_cdc_control.d ${OBJECTDIR}/demo_src/app_device_cdc_control.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_device_cdc_control.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/usb/usb_device_cdc.p1: usb/usb_device_cdc.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/usb" 
+	@${RM} ${OBJECTDIR}/usb/usb_device_cdc.p1.d 
+	@${RM} ${OBJECTDIR}/usb/usb_device_cdc.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device_cdc.p1  usb/usb_device_cdc.c 
+	@-${MV} ${OBJECTDIR}/usb/usb_device_cdc.d ${OBJECTDIR}/usb/usb_device_cdc.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/usb/usb_device_cdc.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_chord.p1: demo_src/app_chord.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_chord.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_chord.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_chord.p1  demo_src/app_chord.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_chord.d ${OBJECTDIR}/demo_src/app_chord.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_chord.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_typematic.p1: demo_src/app_typematic.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_typematic.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_typematic.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_typematic.p1  demo_src/app_typematic.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_typematic.d ${OBJECTDIR}/demo_src/app_typematic.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_typematic.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_tap_hold.p1: demo_src/app_tap_hold.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_tap_hold.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_tap_hold.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_tap_hold.p1  demo_src/app_tap_hold.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_tap_hold.d ${OBJECTDIR}/demo_src/app_tap_hold.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_tap_hold.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_macro.p1: demo_src/app_macro.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_macro.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_macro.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_macro.p1  demo_src/app_macro.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_macro.d ${OBJECTDIR}/demo_src/app_macro.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_macro.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_keymap.p1: demo_src/app_keymap.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_keymap.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_keymap.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_keymap.p1  demo_src/app_keymap.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_keymap.d ${OBJECTDIR}/demo_src/app_keymap.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_keymap.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_settings.p1: demo_src/app_settings.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_settings.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_settings.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_settings.p1  demo_src/app_settings.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_settings.d ${OBJECTDIR}/demo_src/app_settings.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_settings.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/bsp/hef.p1: bsp/hef.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/bsp" 
+	@${RM} ${OBJECTDIR}/bsp/hef.p1.d 
+	@${RM} ${OBJECTDIR}/bsp/hef.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/hef.p1  bsp/hef.c 
+	@-${MV} ${OBJECTDIR}/bsp/hef.d ${OBJECTDIR}/bsp/hef.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/bsp/hef.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/bsp/matrix.p1: bsp/matrix.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/bsp" 
+	@${RM} ${OBJECTDIR}/bsp/matrix.p1.d 
+	@${RM} ${OBJECTDIR}/bsp/matrix.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/matrix.p1  bsp/matrix.c 
+	@-${MV} ${OBJECTDIR}/bsp/matrix.d ${OBJECTDIR}/bsp/matrix.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/bsp/matrix.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/bsp/tick.p1: bsp/tick.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/bsp" 
+	@${RM} ${OBJECTDIR}/bsp/tick.p1.d 
+	@${RM} ${OBJECTDIR}/bsp/tick.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/tick.p1  bsp/tick.c 
+	@-${MV} ${OBJECTDIR}/bsp/tick.d ${OBJECTDIR}/bsp/tick.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/bsp/tick.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 else
 ${OBJECTDIR}/bsp/buttons.p1: bsp/buttons.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/bsp" 
 	@${RM} ${OBJECTDIR}/bsp/buttons.p1.d 
 	@${RM} ${OBJECTDIR}/bsp/buttons.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/buttons.p1  bsp/buttons.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/buttons.p1  bsp/buttons.c 
 	@-${MV} ${OBJECTDIR}/bsp/buttons.d ${OBJECTDIR}/bsp/buttons.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/bsp/buttons.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -186,7 +274,7 @@ ${OBJECTDIR}/bsp/leds.p1: bsp/leds.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/bsp" 
 	@${RM} ${OBJECTDIR}/bsp/leds.p1.d 
 	@${RM} ${OBJECTDIR}/bsp/leds.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/leds.p1  bsp/leds.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/leds.p1  bsp/leds.c 
 	@-${MV} ${OBJECTDIR}/bsp/leds.d ${OBJECTDIR}/bsp/leds.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/bsp/leds.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -194,7 +282,7 @@ ${OBJECTDIR}/demo_src/usb_descriptors.p1: demo_src/usb_descriptors.c  nbproject/
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/usb_descriptors.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/usb_descriptors.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_descriptors.p1  demo_src/usb_descriptors.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_descriptors.p1  demo_src/usb_descriptors.c 
 	@-${MV} ${OBJECTDIR}/demo_src/usb_descriptors.d ${OBJECTDIR}/demo_src/usb_descriptors.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/usb_descriptors.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -202,7 +290,7 @@ ${OBJECTDIR}/demo_src/usb_events.p1: demo_src/usb_events.c  nbproject/Makefile-$
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/usb_events.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/usb_events.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_events.p1  demo_src/usb_events.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/usb_events.p1  demo_src/usb_events.c 
 	@-${MV} ${OBJECTDIR}/demo_src/usb_events.d ${OBJECTDIR}/demo_src/usb_events.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/usb_events.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -210,7 +298,7 @@ ${OBJECTDIR}/usb/usb_device.p1: usb/usb_device.c  nbproject/Makefile-${CND_CONF}
 	@${MKDIR} "${OBJECTDIR}/usb" 
 	@${RM} ${OBJECTDIR}/usb/usb_device.p1.d 
 	@${RM} ${OBJECTDIR}/usb/usb_device.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device.p1  usb/usb_device.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device.p1  usb/usb_device.c 
 	@-${MV} ${OBJECTDIR}/usb/usb_device.d ${OBJECTDIR}/usb/usb_device.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/usb/usb_device.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -218,7 +306,7 @@ ${OBJECTDIR}/usb/usb_device_hid.p1: usb/usb_device_hid.c  nbproject/Makefile-${C
 	@${MKDIR} "${OBJECTDIR}/usb" 
 	@${RM} ${OBJECTDIR}/usb/usb_device_hid.p1.d 
 	@${RM} ${OBJECTDIR}/usb/usb_device_hid.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device_hid.p1  usb/usb_device_hid.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device_hid.p1  usb/usb_device_hid.c 
 	@-${MV} ${OBJECTDIR}/usb/usb_device_hid.d ${OBJECTDIR}/usb/usb_device_hid.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/usb/usb_device_hid.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -226,7 +314,7 @@ ${OBJECTDIR}/demo_src/app_device_keyboard.p1: demo_src/app_device_keyboard.c  nb
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/app_device_keyboard.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_device_keyboard.p1  demo_src/app_device_keyboard.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_device_keyboard.p1  demo_src/app_device_keyboard.c 
 	@-${MV} ${OBJECTDIR}/demo_src/app_device_keyboard.d ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_device_keyboard.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -234,7 +322,7 @@ ${OBJECTDIR}/demo_src/app_led_usb_status.p1: demo_src/app_led_usb_status.c  nbpr
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/app_led_usb_status.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_led_usb_status.p1  demo_src/app_led_usb_status.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_led_usb_status.p1  demo_src/app_led_usb_status.c 
 	@-${MV} ${OBJECTDIR}/demo_src/app_led_usb_status.d ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_led_usb_status.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -242,7 +330,7 @@ ${OBJECTDIR}/demo_src/main.p1: demo_src/main.c  nbproject/Makefile-${CND_CONF}.m
 	@${MKDIR} "${OBJECTDIR}/demo_src" 
 	@${RM} ${OBJECTDIR}/demo_src/main.p1.d 
 	@${RM} ${OBJECTDIR}/demo_src/main.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/main.p1  demo_src/main.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/main.p1  demo_src/main.c 
 	@-${MV} ${OBJECTDIR}/demo_src/main.d ${OBJECTDIR}/demo_src/main.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/demo_src/main.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
@@ -250,10 +338,98 @@ ${OBJECTDIR}/system.p1: system.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
 	@${RM} ${OBJECTDIR}/system.p1.d 
 	@${RM} ${OBJECTDIR}/system.p1 
-	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/system.p1  system.c 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/system.p1  system.c 
 	@-${MV} ${OBJECTDIR}/system.d ${OBJECTDIR}/system.p1.d 
 	@${FIXDEPS} ${OBJECTDIR}/system.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
 	
+${OBJECTDIR}/demo_src/app_device_cdc_control.p1: demo_src/app_device_cdc_control.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_device_cdc_control.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_device_cdc_control.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_device_cdc_control.p1  demo_src/app_device_cdc_control.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_device_cdc_control.d ${OBJECTDIR}/demo_src/app_device_cdc_control.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_device_cdc_control.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/usb/usb_device_cdc.p1: usb/usb_device_cdc.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/usb" 
+	@${RM} ${OBJECTDIR}/usb/usb_device_cdc.p1.d 
+	@${RM} ${OBJECTDIR}/usb/usb_device_cdc.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/usb/usb_device_cdc.p1  usb/usb_device_cdc.c 
+	@-${MV} ${OBJECTDIR}/usb/usb_device_cdc.d ${OBJECTDIR}/usb/usb_device_cdc.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/usb/usb_device_cdc.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_chord.p1: demo_src/app_chord.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_chord.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_chord.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_chord.p1  demo_src/app_chord.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_chord.d ${OBJECTDIR}/demo_src/app_chord.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_chord.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_typematic.p1: demo_src/app_typematic.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_typematic.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_typematic.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_typematic.p1  demo_src/app_typematic.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_typematic.d ${OBJECTDIR}/demo_src/app_typematic.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_typematic.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_tap_hold.p1: demo_src/app_tap_hold.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_tap_hold.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_tap_hold.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_tap_hold.p1  demo_src/app_tap_hold.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_tap_hold.d ${OBJECTDIR}/demo_src/app_tap_hold.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_tap_hold.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_macro.p1: demo_src/app_macro.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_macro.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_macro.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_macro.p1  demo_src/app_macro.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_macro.d ${OBJECTDIR}/demo_src/app_macro.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_macro.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_keymap.p1: demo_src/app_keymap.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_keymap.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_keymap.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_keymap.p1  demo_src/app_keymap.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_keymap.d ${OBJECTDIR}/demo_src/app_keymap.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_keymap.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/demo_src/app_settings.p1: demo_src/app_settings.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/demo_src" 
+	@${RM} ${OBJECTDIR}/demo_src/app_settings.p1.d 
+	@${RM} ${OBJECTDIR}/demo_src/app_settings.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/demo_src/app_settings.p1  demo_src/app_settings.c 
+	@-${MV} ${OBJECTDIR}/demo_src/app_settings.d ${OBJECTDIR}/demo_src/app_settings.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/demo_src/app_settings.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/bsp/hef.p1: bsp/hef.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/bsp" 
+	@${RM} ${OBJECTDIR}/bsp/hef.p1.d 
+	@${RM} ${OBJECTDIR}/bsp/hef.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/hef.p1  bsp/hef.c 
+	@-${MV} ${OBJECTDIR}/bsp/hef.d ${OBJECTDIR}/bsp/hef.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/bsp/hef.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/bsp/matrix.p1: bsp/matrix.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/bsp" 
+	@${RM} ${OBJECTDIR}/bsp/matrix.p1.d 
+	@${RM} ${OBJECTDIR}/bsp/matrix.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/matrix.p1  bsp/matrix.c 
+	@-${MV} ${OBJECTDIR}/bsp/matrix.d ${OBJECTDIR}/bsp/matrix.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/bsp/matrix.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
+${OBJECTDIR}/bsp/tick.p1: bsp/tick.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/bsp" 
+	@${RM} ${OBJECTDIR}/bsp/tick.p1.d 
+	@${RM} ${OBJECTDIR}/bsp/tick.p1 
+	${MP_CC} --pass1 $(MP_EXTRA_CC_PRE) --chip=$(MP_PROCESSOR_OPTION) -Q -G  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib $(COMPARISON_BUILD)  --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"    -o${OBJECTDIR}/bsp/tick.p1  bsp/tick.c 
+	@-${MV} ${OBJECTDIR}/bsp/tick.d ${OBJECTDIR}/bsp/tick.p1.d 
+	@${FIXDEPS} ${OBJECTDIR}/bsp/tick.p1.d $(SILENT) -rsi ${MP_CC_DIR}../  
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -267,13 +443,13 @@ endif
 ifeq ($(TYPE_IMAGE), DEBUG_RUN)
 dist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk    
 	@${MKDIR} dist/${CND_CONF}/${IMAGE_TYPE} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) --chip=$(MP_PROCESSOR_OPTION) -G -mdist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.map  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"        $(COMPARISON_BUILD) --memorysummary dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -odist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
+	${MP_CC} $(MP_EXTRA_LD_PRE) --chip=$(MP_PROCESSOR_OPTION) -G -mdist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.map  -D__DEBUG=1 --debugger=realice  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"        $(COMPARISON_BUILD) --memorysummary dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -odist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
 	@${RM} dist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.hex 
 	
 else
 dist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk   
 	@${MKDIR} dist/${CND_CONF}/${IMAGE_TYPE} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) --chip=$(MP_PROCESSOR_OPTION) -G -mdist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.map  --double=24 --float=24 --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     $(COMPARISON_BUILD) --memorysummary dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -odist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
+	${MP_CC} $(MP_EXTRA_LD_PRE) --chip=$(MP_PROCESSOR_OPTION) -G -mdist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.map  --double=24 --float=24 --rom=default,-1FE0-1FFF --opt=+asm,-asmfile,+speed,-space,-debug,-local --addrqual=ignore --mode=pro -P -N100 -I"." -I"bsp" -I"demo_src" -I"usb" --warn=0 --asmlist -DXPRJ_LPCUSBDK_16F1459=$(CND_CONF)  --summary=default,-psect,-class,+mem,-hex,-file --output=default,-inhx032 --runtime=default,+clear,+init,-keep,-no_startup,+osccal,-resetbits,-download,-stackcall,+clib --output=-mcof,+elf:multilocs --stack=compiled:auto:auto "--errformat=%f:%l: error: (%n) %s" "--warnformat=%f:%l: warning: (%n) %s" "--msgformat=%f:%l: advisory: (%n) %s"     $(COMPARISON_BUILD) --memorysummary dist/${CND_CONF}/${IMAGE_TYPE}/memoryfile.xml -odist/${CND_CONF}/${IMAGE_TYPE}/tkk-pic16f1459.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}     
 	
 endif
 
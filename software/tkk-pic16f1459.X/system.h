@@ -24,6 +24,7 @@ please contact mla_licensing@microchip.com
 #include <stdbool.h>
 
 #include "buttons.h"
+#include "matrix.h"
 #include "io_mapping.h"
 #include "fixed_address_memory.h"
 #include "leds.h"
@@ -77,7 +77,7 @@ typedef struct __attribute__((packed))
 // *****************************************************************************
 // *****************************************************************************
 static uint8_t idle_rate;
-static uint8_t active_protocol;   // [0] Boot Protocol [1] Report Protocol
+static uint8_t active_protocol = RPT_PROTOCOL;   // [0] Boot Protocol [1] Report Protocol
 
 extern const struct{uint8_t report[HID_RPT01_SIZE];}hid_rpt01;
 
@@ -112,6 +112,15 @@ extern const struct{uint8_t report[HID_RPT01_SIZE];}hid_rpt01;
     extern void USB_DEVICE_HID_IDLE_RATE_CALLBACK(uint8_t reportId, uint8_t idleRate);
 #endif
 
+//An application that keeps an idle rate for each report ID can also
+//"#define USB_DEVICE_HID_GET_IDLE_RATE_CALLBACK(reportID)    USBHIDCBGetIdleRateHandler(reportID)"
+//and implement uint8_t USBHIDCBGetIdleRateHandler(reportID), which returns the
+//idle rate of the report the host asks for with GET_IDLE.  Otherwise GET_IDLE
+//returns the last idle rate set, whatever its report ID.
+#ifdef USB_DEVICE_HID_GET_IDLE_RATE_CALLBACK
+    extern uint8_t USB_DEVICE_HID_GET_IDLE_RATE_CALLBACK(uint8_t reportId);
+#endif
+
 /********************************************************************
 	Function:
 		void USBCheckHIDRequest(void)
@@ -216,6 +225,9 @@ void USBCheckHIDRequest(void)
             #endif       
             break;
         case GET_IDLE:
+            #if defined USB_DEVICE_HID_GET_IDLE_RATE_CALLBACK
+                idle_rate = USB_DEVICE_HID_GET_IDLE_RATE_CALLBACK(SetupPkt.W_Value.byte.LB);
+            #endif
             USBEP0SendRAMPtr(
                 (uint8_t*)&idle_rate,
                 1,
@@ -240,6 +252,65 @@ void USBCheckHIDRequest(void)
 
 }//end USBCheckHIDRequest
 
+/********************************************************************
+    Function:
+        uint8_t USBHIDGetProtocol(void)
+
+    Summary:
+        Returns the protocol selected by the host
+
+    Description:
+        Returns the protocol last selected by a SET_PROTOCOL request.
+        A boot interface must send boot reports while the host has
+        selected BOOT_PROTOCOL, whatever its report descriptor says.
+
+    PreCondition:
+        None
+
+    Parameters:
+        None
+
+    Return Values:
+        uint8_t - BOOT_PROTOCOL or RPT_PROTOCOL
+
+    Remarks:
+        None
+
+ *******************************************************************/
+uint8_t USBHIDGetProtocol(void)
+{
+    return active_protocol;
+}
+
+/********************************************************************
+    Function:
+        void USBHIDResetProtocol(void)
+
+    Summary:
+        Returns the interface to the report protocol
+
+    Description:
+        Selects RPT_PROTOCOL, the protocol an interface starts in after
+        the device is reset.  Call when the device is configured.
+
+    PreCondition:
+        None
+
+    Parameters:
+        None
+
+    Return Values:
+        None
+
+    Remarks:
+        None
+
+ *******************************************************************/
+void USBHIDResetProtocol(void)
+{
+    active_protocol = RPT_PROTOCOL;
+}
+
 /********************************************************************
     Function:
         USB_HANDLE HIDTxPacket(uint8_t ep, uint8_t* data, uint16_t len)
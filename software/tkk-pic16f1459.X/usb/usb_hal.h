@@ -29,7 +29,8 @@ please contact mla_licensing@microchip.com
 // *****************************************************************************
 #include <stdint.h>
 
-#if defined(__18CXX) || defined(__XC8)
+/* HOST_BUILD is the off-target build in host/, which plays a PIC16F1. */
+#if defined(__18CXX) || defined(__XC8) || defined(HOST_BUILD)
     #if defined(_PIC14E)
         #include "usb_hal_pic16f1.h"
     #else
@@ -96,7 +97,7 @@ please contact mla_licensing@microchip.com
 #define USBHAL_DMA_ERR2 0x00000400  // Error starting DMA transaction
 
 /* Flags for USBHALSetEpConfiguration */
-#if defined(__18CXX) || defined(__XC8)
+#if defined(__18CXX) || defined(__XC8) || defined(HOST_BUILD)
     #define USB_HAL_TRANSMIT    0x0400  // Enable EP for transmitting data
     #define USB_HAL_RECEIVE     0x0200  // Enable EP for receiving data
     #define USB_HAL_HANDSHAKE   0x1000  // Enable EP to give ACK/NACK (non isoch)
@@ -199,7 +200,7 @@ void USBHALSetBusAddress( uint8_t addr );
 /*
  This routine is implemented as a macro to a lower-level level routine.
  */
- #if defined(__18CXX) || defined(__XC8)
+ #if defined(__18CXX) || defined(__XC8) || defined(HOST_BUILD)
     void USBHALControlUsbResistors( uint8_t flags );
  #else
     #define USBHALControlUsbResistors OTGCORE_ControlUsbResistors